@@ -0,0 +1,194 @@
+#include <houseguest/atomic_bounded_value.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using in_flight = houseguest::atomic_bounded_value<int, 0, 8>;
+
+    using gauge = houseguest::atomic_clamped_value<int, -10, 10>;
+
+    using full_range = houseguest::atomic_bounded_value<
+        std::uint8_t, 0, 255>;
+
+    using checked_counter = houseguest::atomic_constrained_value<
+        int, houseguest::checked_validator<int, 0, 8>>;
+
+    using checked_full_range = houseguest::atomic_constrained_value<
+        std::uint8_t, houseguest::checked_validator<std::uint8_t, 0, 255>>;
+
+    template <typename FN>
+    void run_threads(unsigned count, FN fn)
+    {
+        std::vector<std::thread> threads;
+        for(auto i = 0U; i < count; ++i)
+        {
+            threads.emplace_back(fn);
+        }
+        for(auto & thread : threads)
+        {
+            thread.join();
+        }
+    }
+} // namespace
+
+TEST(AtomicBoundedValue, construct) // NOLINT
+{
+    in_flight const counter{0};
+    ASSERT_EQ(0, counter.load());
+    ASSERT_THROW(in_flight{9}, std::system_error); // NOLINT
+
+    gauge const clamped{100};
+    ASSERT_EQ(10, clamped.load());
+}
+
+TEST(AtomicBoundedValue, fetch_add) // NOLINT
+{
+    in_flight counter{0};
+    ASSERT_EQ(0, counter.fetch_add(5));
+    ASSERT_EQ(5, counter.fetch_sub(2));
+    ASSERT_EQ(3, counter.fetch_add(-3));
+    ASSERT_EQ(0, counter.load());
+}
+
+TEST(AtomicBoundedValue, out_of_range) // NOLINT
+{
+    in_flight counter{7};
+    try
+    {
+        counter.fetch_add(2);
+        FAIL() << "fetch_add should have thrown";
+    }
+    catch(std::system_error const & e)
+    {
+        ASSERT_EQ(houseguest::bounded_value_error::above_max, e.code());
+    }
+    ASSERT_EQ(7, counter.load());
+
+    try
+    {
+        counter.fetch_sub(8);
+        FAIL() << "fetch_sub should have thrown";
+    }
+    catch(std::system_error const & e)
+    {
+        ASSERT_EQ(houseguest::bounded_value_error::below_min, e.code());
+    }
+    ASSERT_EQ(7, counter.load());
+
+    ASSERT_THROW(counter.store(-1), std::system_error); // NOLINT
+    ASSERT_EQ(7, counter.load());
+}
+
+TEST(AtomicBoundedValue, no_overflow) // NOLINT
+{
+    full_range counter{250};
+    ASSERT_THROW(counter.fetch_add(10), std::system_error); // NOLINT
+    ASSERT_EQ(250, counter.load());
+    ASSERT_EQ(250, counter.fetch_add(5));
+    ASSERT_EQ(255, counter.load());
+}
+
+TEST(AtomicBoundedValueDeathTest, checked) // NOLINT
+{
+    checked_counter counter{7};
+    ASSERT_EQ(7, counter.fetch_add(1));
+    ASSERT_DEATH(counter.fetch_add(1), ""); // NOLINT
+    ASSERT_DEATH(counter.fetch_sub(9), ""); // NOLINT
+
+    checked_full_range full{255};
+    ASSERT_DEATH(full.fetch_add(1), ""); // NOLINT
+    ASSERT_EQ(255, full.load());
+}
+
+TEST(AtomicBoundedValue, saturate) // NOLINT
+{
+    gauge value{0};
+    ASSERT_EQ(0, value.fetch_add(25));
+    ASSERT_EQ(10, value.load());
+    ASSERT_EQ(10, value.fetch_sub(100));
+    ASSERT_EQ(-10, value.load());
+    value.store(50);
+    ASSERT_EQ(10, value.load());
+}
+
+TEST(AtomicBoundedValue, try_increment) // NOLINT
+{
+    in_flight counter{7};
+    ASSERT_TRUE(counter.try_increment());
+    ASSERT_FALSE(counter.try_increment());
+    ASSERT_EQ(8, counter.load());
+    ASSERT_FALSE(counter.try_add(1));
+    ASSERT_TRUE(counter.try_sub(8));
+    ASSERT_FALSE(counter.try_decrement());
+    ASSERT_EQ(0, counter.load());
+
+    // try_ never clamps
+    gauge value{9};
+    ASSERT_FALSE(value.try_add(2));
+    ASSERT_EQ(9, value.load());
+}
+
+TEST(AtomicBoundedValue, exchange) // NOLINT
+{
+    in_flight counter{3};
+    ASSERT_EQ(3, counter.exchange(in_flight::value_type{5}));
+
+    auto expected = in_flight::value_type{4};
+    ASSERT_FALSE(counter.compare_exchange_strong(
+        expected, in_flight::value_type{6}));
+    ASSERT_EQ(5, expected);
+    ASSERT_TRUE(counter.compare_exchange_strong(
+        expected, in_flight::value_type{6}));
+    ASSERT_EQ(6, counter.load());
+}
+
+TEST(AtomicBoundedValue, admission_control) // NOLINT
+{
+    constexpr auto thread_count = 8U;
+    constexpr auto attempts = 10000;
+
+    in_flight counter{0};
+    std::atomic<int> holders{0};
+    std::atomic<int> peak{0};
+    std::atomic<int> admitted{0};
+    run_threads(thread_count, [&] {
+        for(auto i = 0; i < attempts; ++i)
+        {
+            if(counter.try_increment(std::memory_order_acquire))
+            {
+                ++admitted;
+                // counted separately, so admitting too many shows up here
+                auto const current = ++holders;
+                auto previous = peak.load();
+                while((current > previous) &&
+                      !peak.compare_exchange_weak(previous, current))
+                {
+                }
+                --holders;
+                counter.fetch_sub(1, std::memory_order_release);
+            }
+        }
+    });
+    ASSERT_EQ(0, counter.load());
+    ASSERT_LE(peak.load(), 8);
+    ASSERT_GT(admitted.load(), 0);
+}
+
+TEST(AtomicBoundedValue, concurrent_saturation) // NOLINT
+{
+    gauge value{0};
+    run_threads(4, [&] {
+        for(auto i = 0; i < 1000; ++i)
+        {
+            value.fetch_add(1);
+        }
+    });
+    ASSERT_EQ(10, value.load());
+}
@@ -0,0 +1,8 @@
+#include <houseguest/bounded_value.hpp>
+
+int main()
+{
+    constexpr houseguest::bounded_value<int, 0, 100> too_big{101};
+
+    return too_big;
+}
@@ -0,0 +1,10 @@
+#include <houseguest/bounded_value.hpp>
+
+int main()
+{
+    houseguest::bounded_value<int, 0, 100> numerator{52};
+    houseguest::bounded_value<int, 0, 10> denominator{2};
+    auto const result = numerator / denominator;
+
+    return result;
+}
@@ -0,0 +1,9 @@
+#include <houseguest/bounded_value.hpp>
+
+int main()
+{
+    using percent = houseguest::bounded_value<int, 0, 100>;
+    constexpr auto too_big = houseguest::make_bounded<percent, 101>();
+
+    return too_big;
+}
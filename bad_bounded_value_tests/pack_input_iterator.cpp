@@ -0,0 +1,13 @@
+#include <houseguest/packed_bounded_array.hpp>
+
+#include <iterator>
+#include <sstream>
+
+int main()
+{
+    houseguest::packed_bounded_array<int, 0, 100> a(3);
+    std::istringstream in{"1 2 3"};
+    a.pack(std::istream_iterator<int>{in}, std::istream_iterator<int>{}, 0);
+
+    return a[0];
+}
@@ -0,0 +1,96 @@
+#include <houseguest/bounded_parse.hpp>
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+    using percent = houseguest::bounded_value<int, 0, 100>;
+
+    std::vector<std::string> const & make_fields()
+    {
+        static std::vector<std::string> const fields = [] {
+            std::mt19937 engine{42}; // NOLINT
+            std::uniform_int_distribution<int> distribution{0, 100};
+            std::vector<std::string> ret;
+            for(auto i = 0; i < 4096; ++i)
+            {
+                ret.push_back(std::to_string(distribution(engine)));
+            }
+            return ret;
+        }();
+        return fields;
+    }
+
+    std::string const & make_column()
+    {
+        static std::string const column = [] {
+            std::string ret;
+            for(auto const & field : make_fields())
+            {
+                ret += field;
+                ret += ',';
+            }
+            ret.pop_back();
+            return ret;
+        }();
+        return column;
+    }
+
+    void stoi_construct(benchmark::State & state)
+    {
+        auto const & fields = make_fields();
+        for(auto _ : state)
+        {
+            for(auto const & field : fields)
+            {
+                percent p{std::stoi(field)};
+                benchmark::DoNotOptimize(p);
+            }
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(
+            state.iterations() * fields.size()));
+    }
+
+    void fused_parse(benchmark::State & state)
+    {
+        auto const & fields = make_fields();
+        for(auto _ : state)
+        {
+            for(auto const & field : fields)
+            {
+                auto const result = houseguest::parse<percent>(field);
+                benchmark::DoNotOptimize(result);
+            }
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(
+            state.iterations() * fields.size()));
+    }
+
+    void fused_column(benchmark::State & state)
+    {
+        auto const & column = make_column();
+        std::vector<percent> values;
+        values.reserve(make_fields().size());
+        for(auto _ : state)
+        {
+            values.clear();
+            auto const result = houseguest::parse_column<percent>(
+                column.data(), column.data() + column.size(), ',',
+                std::back_inserter(values));
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(
+            state.iterations() * make_fields().size()));
+    }
+} // namespace
+
+BENCHMARK(stoi_construct); // NOLINT
+BENCHMARK(fused_parse);    // NOLINT
+BENCHMARK(fused_column);   // NOLINT
+
+BENCHMARK_MAIN(); // NOLINT
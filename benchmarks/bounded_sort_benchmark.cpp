@@ -0,0 +1,78 @@
+#include <houseguest/bounded_sort.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+    using small_int = houseguest::bounded_value<int, 0, 4095>;
+
+    using short_int = houseguest::bounded_value<int, 0, 65535>;
+
+    using wide_int = houseguest::bounded_value<int, 0, 1000000000>;
+
+    template <typename CONSTRAINED>
+    std::vector<CONSTRAINED> make_values(std::size_t count)
+    {
+        using validator = typename CONSTRAINED::validator;
+
+        std::mt19937 engine{42}; // NOLINT
+        std::uniform_int_distribution<int> distribution{validator::min,
+                                                        validator::max};
+        std::vector<CONSTRAINED> ret;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            ret.emplace_back(distribution(engine));
+        }
+        return ret;
+    }
+
+    template <typename CONSTRAINED>
+    void std_sort(benchmark::State & state)
+    {
+        auto const values =
+            make_values<CONSTRAINED>(static_cast<std::size_t>(state.range(0)));
+        for(auto _ : state)
+        {
+            state.PauseTiming();
+            auto copy = values;
+            state.ResumeTiming();
+            std::sort(std::begin(copy), std::end(copy));
+            benchmark::DoNotOptimize(copy.data());
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(
+            state.iterations() * values.size()));
+    }
+
+    template <typename CONSTRAINED>
+    void range_sort(benchmark::State & state)
+    {
+        auto const values =
+            make_values<CONSTRAINED>(static_cast<std::size_t>(state.range(0)));
+        for(auto _ : state)
+        {
+            state.PauseTiming();
+            auto copy = values;
+            state.ResumeTiming();
+            houseguest::bounded_sort(copy);
+            benchmark::DoNotOptimize(copy.data());
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(
+            state.iterations() * values.size()));
+    }
+} // namespace
+
+BENCHMARK_TEMPLATE(std_sort, small_int)->Range(1 << 10, 1 << 20);   // NOLINT
+BENCHMARK_TEMPLATE(range_sort, small_int)->Range(1 << 10, 1 << 20); // NOLINT
+// few values over a range that's wide for a counting sort
+BENCHMARK_TEMPLATE(std_sort, short_int)->Range(64, 1 << 16);   // NOLINT
+BENCHMARK_TEMPLATE(range_sort, short_int)->Range(64, 1 << 16); // NOLINT
+BENCHMARK_TEMPLATE(std_sort, wide_int)->Range(1 << 10, 1 << 20);    // NOLINT
+BENCHMARK_TEMPLATE(range_sort, wide_int)->Range(1 << 10, 1 << 20);  // NOLINT
+
+BENCHMARK_MAIN(); // NOLINT
@@ -0,0 +1,150 @@
+#include <houseguest/concurrent_cache.hpp>
+#include <houseguest/thread_safe_object.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+    constexpr std::size_t key_count = 1 << 16;
+    constexpr std::size_t cache_capacity = 1 << 12;
+    constexpr std::size_t lookups_per_thread = 1 << 16;
+
+    // stands in for an expensive computation, so misses cost something
+    std::uint64_t compute(std::uint64_t key)
+    {
+        auto ret = key;
+        for(int i = 0; i < 64; ++i)
+        {
+            ret = ret * 6364136223846793005ULL + 1442695040888963407ULL;
+        }
+        return ret;
+    }
+
+    /** \brief draw keys from a Zipfian distribution
+     *
+     * Key k (counting from 1) is chosen with probability proportional to
+     * 1 / k^skew, so a few keys are very popular and most are rare.
+     */
+    std::vector<std::uint64_t> make_keys(double skew, unsigned seed)
+    {
+        std::vector<double> cdf(key_count);
+        double total = 0;
+        for(std::size_t i = 0; i < key_count; ++i)
+        {
+            total += 1.0 / std::pow(static_cast<double>(i + 1), skew);
+            cdf[i] = total;
+        }
+
+        std::mt19937_64 engine{seed};
+        std::uniform_real_distribution<double> distribution{0, total};
+        std::vector<std::uint64_t> ret;
+        ret.reserve(lookups_per_thread);
+        for(std::size_t i = 0; i < lookups_per_thread; ++i)
+        {
+            auto const it = std::lower_bound(std::begin(cdf), std::end(cdf),
+                                             distribution(engine));
+            ret.push_back(static_cast<std::uint64_t>(it - std::begin(cdf)));
+        }
+        return ret;
+    }
+
+    double skew_for(benchmark::State const & state)
+    {
+        return static_cast<double>(state.range(0)) / 100.0;
+    }
+
+    // the pattern concurrent_cache replaces: a global lock around an
+    // unordered_map and a recency list
+    class lru_map
+    {
+    public:
+        template <typename FN>
+        std::uint64_t get_or_compute(std::uint64_t key, FN && fn)
+        {
+            auto const it = _index.find(key);
+            if(it != _index.end())
+            {
+                _order.splice(_order.begin(), _order, it->second);
+                return it->second->second;
+            }
+            if(_order.size() == cache_capacity)
+            {
+                _index.erase(_order.back().first);
+                _order.pop_back();
+            }
+            _order.emplace_front(key, fn(key));
+            _index.emplace(key, _order.begin());
+            return _order.front().second;
+        }
+
+    private:
+        using order_type = std::list<std::pair<std::uint64_t, std::uint64_t>>;
+
+        order_type _order;
+        std::unordered_map<std::uint64_t, order_type::iterator> _index;
+    };
+
+    void locked_lru(benchmark::State & state)
+    {
+        static houseguest::threadsafe_object<lru_map> cache;
+        auto const keys = make_keys(skew_for(state),
+                                    static_cast<unsigned>(state.thread_index()));
+        for(auto _ : state)
+        {
+            for(auto key : keys)
+            {
+                benchmark::DoNotOptimize(
+                    cache.write()->get_or_compute(key, compute));
+            }
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(
+            state.iterations() * keys.size()));
+    }
+
+    void sharded_clock(benchmark::State & state)
+    {
+        static houseguest::concurrent_cache<std::uint64_t, std::uint64_t>
+            cache{cache_capacity};
+        auto const keys = make_keys(skew_for(state),
+                                    static_cast<unsigned>(state.thread_index()));
+        for(auto _ : state)
+        {
+            for(auto key : keys)
+            {
+                benchmark::DoNotOptimize(cache.get_or_compute(key, compute));
+            }
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(
+            state.iterations() * keys.size()));
+        if(state.thread_index() == 0)
+        {
+            state.counters["hit_rate"] = cache.statistics().hit_rate();
+        }
+    }
+} // namespace
+
+// skew is given in hundredths (e.g., 99 is a Zipf exponent of 0.99)
+BENCHMARK(locked_lru) // NOLINT
+    ->Arg(80)
+    ->Arg(99)
+    ->Arg(120)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+BENCHMARK(sharded_clock) // NOLINT
+    ->Arg(80)
+    ->Arg(99)
+    ->Arg(120)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+BENCHMARK_MAIN(); // NOLINT
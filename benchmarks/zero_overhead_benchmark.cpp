@@ -0,0 +1,192 @@
+#include <houseguest/bounded_value.hpp>
+#include <houseguest/validation_result.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+    using percent = houseguest::bounded_value<int, 0, 100>;
+
+    using clamped_percent = houseguest::clamped_value<int, 0, 100>;
+
+    using checked_percent = houseguest::checked_value<int, 0, 100>;
+
+    constexpr auto min_size = 1 << 10;
+    constexpr auto max_size = 1 << 16;
+
+    // every input is in range, so bounded_value never throws
+    std::vector<int> make_inputs(std::size_t count)
+    {
+        std::mt19937 engine{42}; // NOLINT
+        std::uniform_int_distribution<int> distribution{0, 100};
+        std::vector<int> ret;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            ret.push_back(distribution(engine));
+        }
+        return ret;
+    }
+
+    template <typename VALUE>
+    std::vector<VALUE> make_values(std::size_t count)
+    {
+        std::vector<VALUE> ret;
+        for(auto input : make_inputs(count))
+        {
+            ret.emplace_back(std::move(input));
+        }
+        return ret;
+    }
+
+    template <typename VALUE>
+    void construct(benchmark::State & state)
+    {
+        auto const inputs =
+            make_inputs(static_cast<std::size_t>(state.range(0)));
+        for(auto _ : state)
+        {
+            for(auto input : inputs)
+            {
+                VALUE const value{std::move(input)};
+                benchmark::DoNotOptimize(value);
+            }
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(
+            state.iterations() * inputs.size()));
+    }
+
+    void raw_try_construct(benchmark::State & state)
+    {
+        auto const inputs =
+            make_inputs(static_cast<std::size_t>(state.range(0)));
+        for(auto _ : state)
+        {
+            for(auto input : inputs)
+            {
+                auto const value =
+                    ((input >= 0) && (input <= 100)) ? input : 0;
+                benchmark::DoNotOptimize(value);
+            }
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(
+            state.iterations() * inputs.size()));
+    }
+
+    void try_construct(benchmark::State & state)
+    {
+        auto const inputs =
+            make_inputs(static_cast<std::size_t>(state.range(0)));
+        auto const fallback = houseguest::make_bounded<checked_percent, 0>();
+        for(auto _ : state)
+        {
+            for(auto input : inputs)
+            {
+                auto const value =
+                    houseguest::try_make<checked_percent>(input).value_or(
+                        fallback);
+                benchmark::DoNotOptimize(value);
+            }
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(
+            state.iterations() * inputs.size()));
+    }
+
+    template <typename VALUE>
+    void sum(benchmark::State & state)
+    {
+        auto const values =
+            make_values<VALUE>(static_cast<std::size_t>(state.range(0)));
+        for(auto _ : state)
+        {
+            long total = 0;
+            for(auto const & value : values)
+            {
+                total += static_cast<int>(value);
+            }
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(
+            state.iterations() * values.size()));
+    }
+
+    template <typename VALUE>
+    void minimum(benchmark::State & state)
+    {
+        auto const values =
+            make_values<VALUE>(static_cast<std::size_t>(state.range(0)));
+        for(auto _ : state)
+        {
+            auto const it = std::min_element(values.begin(), values.end());
+            benchmark::DoNotOptimize(it);
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(
+            state.iterations() * values.size()));
+    }
+
+    void raw_saturating_add(benchmark::State & state)
+    {
+        auto const size = static_cast<std::size_t>(state.range(0));
+        auto const lhs = make_inputs(size);
+        auto const rhs = make_inputs(size);
+        std::vector<int> out(size);
+        for(auto _ : state)
+        {
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                out[i] = std::min(std::max(lhs[i] + rhs[i], 0), 100);
+            }
+            benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(
+            static_cast<std::int64_t>(state.iterations() * size));
+    }
+
+    void clamped_add(benchmark::State & state)
+    {
+        auto const size = static_cast<std::size_t>(state.range(0));
+        auto const lhs = make_values<clamped_percent>(size);
+        auto const rhs = make_values<clamped_percent>(size);
+        std::vector<clamped_percent> out(size, lhs.front());
+        for(auto _ : state)
+        {
+            for(std::size_t i = 0; i < size; ++i)
+            {
+                out[i] = lhs[i] + rhs[i];
+            }
+            benchmark::DoNotOptimize(out.data());
+        }
+        state.SetItemsProcessed(
+            static_cast<std::int64_t>(state.iterations() * size));
+    }
+} // namespace
+
+BENCHMARK_TEMPLATE(construct, int) // NOLINT
+    ->Range(min_size, max_size);
+BENCHMARK_TEMPLATE(construct, percent) // NOLINT
+    ->Range(min_size, max_size);
+BENCHMARK_TEMPLATE(construct, clamped_percent) // NOLINT
+    ->Range(min_size, max_size);
+BENCHMARK(raw_try_construct) // NOLINT
+    ->Range(min_size, max_size);
+BENCHMARK(try_construct) // NOLINT
+    ->Range(min_size, max_size);
+BENCHMARK_TEMPLATE(sum, int) // NOLINT
+    ->Range(min_size, max_size);
+BENCHMARK_TEMPLATE(sum, percent) // NOLINT
+    ->Range(min_size, max_size);
+BENCHMARK_TEMPLATE(minimum, int) // NOLINT
+    ->Range(min_size, max_size);
+BENCHMARK_TEMPLATE(minimum, percent) // NOLINT
+    ->Range(min_size, max_size);
+BENCHMARK(raw_saturating_add) // NOLINT
+    ->Range(min_size, max_size);
+BENCHMARK(clamped_add) // NOLINT
+    ->Range(min_size, max_size);
+
+BENCHMARK_MAIN(); // NOLINT
@@ -0,0 +1,236 @@
+#include <houseguest/bit_codec.hpp>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using offset_int = houseguest::bounded_value<int, 1000, 1100>;
+
+    using offset_clamped = houseguest::clamped_value<int, 1000, 1100>;
+
+    using offset_checked = houseguest::checked_value<int, 1000, 1100>;
+
+    using byte_int = houseguest::bounded_value<int, -128, 127>;
+
+    using wide_int =
+        houseguest::bounded_value<std::int64_t, -5,
+                                  std::numeric_limits<std::int64_t>::max()>;
+
+    using full_int =
+        houseguest::bounded_value<int, std::numeric_limits<int>::min(),
+                                  std::numeric_limits<int>::max()>;
+
+    using full_int64 =
+        houseguest::bounded_value<std::int64_t,
+                                  std::numeric_limits<std::int64_t>::min(),
+                                  std::numeric_limits<std::int64_t>::max()>;
+
+    static_assert(houseguest::bit_encoder<offset_int>::bits_per_value == 7,
+                  "[1000, 1100] should need 7 bits");
+    static_assert(houseguest::bit_encoder<offset_int>::bytes_required(8) ==
+                      7,
+                  "8 values of 7 bits should fit in 7 bytes");
+} // namespace
+
+TEST(BitCodec, round_trip) // NOLINT
+{
+    std::array<unsigned char, 16> buffer{};
+    houseguest::bit_encoder<offset_int> encoder{buffer.data(), buffer.size()};
+    for(auto i = 0; i < 10; ++i)
+    {
+        encoder.encode(offset_int{1000 + (i * 11)});
+    }
+    ASSERT_EQ(9, encoder.flush());
+
+    houseguest::bit_decoder<offset_int> decoder{buffer.data(), 9};
+    for(auto i = 0; i < 10; ++i)
+    {
+        ASSERT_EQ(1000 + (i * 11), decoder.decode());
+    }
+}
+
+TEST(BitCodec, bulk) // NOLINT
+{
+    std::vector<int> values;
+    for(auto i = 0; i < 200; ++i)
+    {
+        values.push_back(1000 + (i % 101));
+    }
+    std::vector<unsigned char> buffer(
+        houseguest::bit_encoder<offset_int>::bytes_required(values.size()));
+    houseguest::bit_encoder<offset_int> encoder{buffer.data(), buffer.size()};
+    encoder.encode(std::begin(values), std::end(values));
+    ASSERT_EQ(buffer.size(), encoder.flush());
+
+    std::vector<offset_int> decoded;
+    houseguest::bit_decoder<offset_int> decoder{buffer.data(), buffer.size()};
+    decoder.decode(values.size(), std::back_inserter(decoded));
+    ASSERT_EQ(values.size(), decoded.size());
+    for(auto i = 0u; i < values.size(); ++i)
+    {
+        ASSERT_EQ(values[i], decoded[i]);
+    }
+}
+
+TEST(BitCodec, bulk_bad_value) // NOLINT
+{
+    std::vector<int> const values{1000, 1050, 999};
+    std::array<unsigned char, 16> buffer{};
+    houseguest::bit_encoder<offset_int> encoder{buffer.data(), buffer.size()};
+    ASSERT_THROW(encoder.encode(std::begin(values), std::end(values)), // NOLINT
+                 std::system_error);
+}
+
+TEST(BitCodec, bulk_clamped) // NOLINT
+{
+    std::vector<int> const values{0, 1050, 5000};
+    std::array<unsigned char, 16> buffer{};
+    houseguest::bit_encoder<offset_clamped> encoder{buffer.data(),
+                                                    buffer.size()};
+    encoder.encode(std::begin(values), std::end(values));
+    encoder.flush();
+
+    houseguest::bit_decoder<offset_clamped> decoder{buffer.data(),
+                                                    buffer.size()};
+    ASSERT_EQ(1000, decoder.decode());
+    ASSERT_EQ(1050, decoder.decode());
+    ASSERT_EQ(1100, decoder.decode());
+}
+
+TEST(BitCodec, full_byte) // NOLINT
+{
+    std::array<unsigned char, 2> buffer{};
+    houseguest::bit_encoder<byte_int> encoder{buffer.data(), buffer.size()};
+    encoder.encode(-128);
+    encoder.encode(127);
+    ASSERT_EQ(0, encoder.remaining());
+    ASSERT_THROW(encoder.encode(0), std::length_error); // NOLINT
+    ASSERT_EQ(0x00, buffer[0]);
+    ASSERT_EQ(0xff, buffer[1]);
+}
+
+TEST(BitCodec, wide) // NOLINT
+{
+    std::array<std::int64_t, 3> const values{
+        {-5, 12345678901234LL, std::numeric_limits<std::int64_t>::max()}};
+    std::array<unsigned char, 32> buffer{};
+    houseguest::bit_encoder<wide_int> encoder{buffer.data(), buffer.size()};
+    encoder.encode(std::begin(values), std::end(values));
+    ASSERT_EQ(24, encoder.flush());
+
+    houseguest::bit_decoder<wide_int> decoder{buffer.data(), 24};
+    for(auto value : values)
+    {
+        ASSERT_EQ(value, decoder.decode());
+    }
+}
+
+TEST(BitCodec, full_range) // NOLINT
+{
+    std::array<int, 4> const values{{std::numeric_limits<int>::min(), -1, 0,
+                                     std::numeric_limits<int>::max()}};
+    std::array<unsigned char, 16> buffer{};
+    houseguest::bit_encoder<full_int> encoder{buffer.data(), buffer.size()};
+    encoder.encode(std::begin(values), std::end(values));
+    ASSERT_EQ(16, encoder.flush());
+
+    houseguest::bit_decoder<full_int> decoder{buffer.data(), buffer.size()};
+    for(auto value : values)
+    {
+        ASSERT_EQ(value, decoder.decode());
+    }
+}
+
+TEST(BitCodec, full_range_64) // NOLINT
+{
+    std::array<std::int64_t, 4> const values{
+        {std::numeric_limits<std::int64_t>::min(), -1, 12345678901234LL,
+         std::numeric_limits<std::int64_t>::max()}};
+    std::array<unsigned char, 32> buffer{};
+    houseguest::bit_encoder<full_int64> encoder{buffer.data(), buffer.size()};
+    encoder.encode(std::begin(values), std::end(values));
+    ASSERT_EQ(32, encoder.flush());
+
+    houseguest::bit_decoder<full_int64> decoder{buffer.data(), buffer.size()};
+    for(auto value : values)
+    {
+        ASSERT_EQ(value, decoder.decode());
+    }
+}
+
+TEST(BitCodec, corrupt) // NOLINT
+{
+    // 7 bits of 1s is an offset of 127, past the span of 100
+    std::array<unsigned char, 1> const buffer{{0x7f}};
+
+    houseguest::bit_decoder<offset_int> decoder{buffer.data(), buffer.size()};
+    try
+    {
+        decoder.decode();
+        FAIL();
+    }
+    catch(std::system_error const & se)
+    {
+        ASSERT_EQ(static_cast<int>(houseguest::bounded_value_error::above_max),
+                  se.code().value());
+    }
+
+    houseguest::bit_decoder<offset_clamped> clamped{buffer.data(),
+                                                    buffer.size()};
+    ASSERT_EQ(1100, clamped.decode());
+}
+
+TEST(BitCodec, try_decode) // NOLINT
+{
+    std::array<unsigned char, 2> buffer{};
+    houseguest::bit_encoder<offset_checked> encoder{buffer.data(),
+                                                    buffer.size()};
+    encoder.encode(offset_checked{1042});
+    ASSERT_EQ(1, encoder.flush());
+
+    houseguest::bit_decoder<offset_checked> decoder{buffer.data(), 1};
+    auto const good = decoder.try_decode();
+    ASSERT_TRUE(good);
+    ASSERT_EQ(1042, *good);
+    auto const exhausted = decoder.try_decode();
+    ASSERT_FALSE(exhausted);
+    ASSERT_EQ(std::make_error_code(std::errc::no_message_available),
+              exhausted.error());
+}
+
+TEST(BitCodec, try_decode_corrupt) // NOLINT
+{
+    // 7 bits of 1s is an offset of 127, past the span of 100
+    std::array<unsigned char, 1> const buffer{{0x7f}};
+
+    // a checked_value would terminate if decode were used
+    houseguest::bit_decoder<offset_checked> decoder{buffer.data(),
+                                                    buffer.size()};
+    auto const result = decoder.try_decode();
+    ASSERT_FALSE(result);
+    ASSERT_EQ(houseguest::make_error_code(
+                  houseguest::bounded_value_error::above_max),
+              result.error());
+    ASSERT_EQ(0, decoder.remaining());
+
+    // corruption is reported even for validators that would clamp it
+    houseguest::bit_decoder<offset_clamped> clamped{buffer.data(),
+                                                    buffer.size()};
+    ASSERT_FALSE(clamped.try_decode());
+}
+
+TEST(BitCodec, exhausted) // NOLINT
+{
+    std::array<unsigned char, 1> const buffer{{0x00}};
+    houseguest::bit_decoder<offset_int> decoder{buffer.data(), buffer.size()};
+    ASSERT_EQ(1, decoder.remaining());
+    decoder.decode();
+    ASSERT_THROW(decoder.decode(), std::length_error); // NOLINT
+}
@@ -0,0 +1,139 @@
+#include <houseguest/bounded_algorithm.hpp>
+
+#include <cstdint>
+#include <list>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using two_digit_int = houseguest::bounded_value<int, 10, 99>;
+
+    using clamped_two_digit_int = houseguest::clamped_value<int, 10, 99>;
+
+    std::vector<int> make_values(std::size_t count)
+    {
+        std::vector<int> values(count);
+        for(auto i = 0u; i < count; ++i)
+        {
+            values[i] = 10 + static_cast<int>(i % 90);
+        }
+        return values;
+    }
+} // namespace
+
+TEST(BoundedAlgorithm, validate_all_good) // NOLINT
+{
+    auto const values = make_values(1000);
+    auto const it = houseguest::validate_all<two_digit_int::validator>(
+        std::begin(values), std::end(values));
+    ASSERT_EQ(std::end(values), it);
+}
+
+TEST(BoundedAlgorithm, validate_all_empty) // NOLINT
+{
+    std::vector<int> values;
+    auto const it = houseguest::validate_all<two_digit_int::validator>(
+        std::begin(values), std::end(values));
+    ASSERT_EQ(std::end(values), it);
+}
+
+TEST(BoundedAlgorithm, validate_all_below_min) // NOLINT
+{
+    auto values = make_values(1000);
+    values[700] = 9;
+    values[900] = 5;
+    auto const it = houseguest::validate_all<two_digit_int::validator>(
+        std::begin(values), std::end(values));
+    ASSERT_EQ(700, std::distance(std::begin(values), it));
+}
+
+TEST(BoundedAlgorithm, validate_all_above_max) // NOLINT
+{
+    auto values = make_values(1000);
+    values[999] = 100;
+    auto const it = houseguest::validate_all<two_digit_int::validator>(
+        std::begin(values), std::end(values));
+    ASSERT_EQ(999, std::distance(std::begin(values), it));
+}
+
+TEST(BoundedAlgorithm, validate_all_forward_iterator) // NOLINT
+{
+    std::list<int> values{10, 50, 99, 100, 10};
+    auto const it = houseguest::validate_all<two_digit_int::validator>(
+        std::begin(values), std::end(values));
+    ASSERT_EQ(3, std::distance(std::begin(values), it));
+}
+
+TEST(BoundedAlgorithm, validate_all_unsigned) // NOLINT
+{
+    using validator = houseguest::bounded_validator<unsigned, 5, 10>;
+    std::vector<unsigned> values{5, 10, 7, 4};
+    auto const it = houseguest::validate_all<validator>(std::begin(values),
+                                                        std::end(values));
+    ASSERT_EQ(3, std::distance(std::begin(values), it));
+}
+
+TEST(BoundedAlgorithm, clamp_all) // NOLINT
+{
+    std::vector<int> values{-5, 9, 10, 50, 99, 100, 1000};
+    houseguest::clamp_all<clamped_two_digit_int::validator>(std::begin(values),
+                                                           std::end(values));
+    std::vector<int> const expected{10, 10, 10, 50, 99, 99, 99};
+    ASSERT_EQ(expected, values);
+}
+
+TEST(BoundedAlgorithm, make_bounded_array) // NOLINT
+{
+    auto const values = houseguest::make_bounded_array<two_digit_int>(
+        {10, 20, 30, 99});
+    ASSERT_EQ(4, values.size());
+    ASSERT_EQ(10, values[0]);
+    ASSERT_EQ(99, values[3]);
+}
+
+TEST(BoundedAlgorithm, make_bounded_array_bad) // NOLINT
+{
+    try
+    {
+        houseguest::make_bounded_array<two_digit_int>({10, 20, 300, 5});
+        FAIL();
+    }
+    catch(std::system_error const & se)
+    {
+        ASSERT_EQ(static_cast<int>(houseguest::bounded_value_error::above_max),
+                  se.code().value());
+    }
+}
+
+TEST(BoundedAlgorithm, make_bounded_array_clamped) // NOLINT
+{
+    auto const values = houseguest::make_bounded_array<clamped_two_digit_int>(
+        {5, 20, 300});
+    ASSERT_EQ(10, values[0]);
+    ASSERT_EQ(20, values[1]);
+    ASSERT_EQ(99, values[2]);
+}
+
+TEST(BoundedAlgorithm, saturating_all) // NOLINT
+{
+    using validator = houseguest::clamping_validator<std::int16_t, -100, 100>;
+
+    std::vector<std::int16_t> const lhs{-90, 0, 50, 90, 10};
+    std::vector<std::int16_t> const rhs{-20, 0, 40, 20, -30};
+    std::vector<std::int16_t> out(lhs.size());
+
+    houseguest::saturating_add_all<validator>(
+        std::begin(lhs), std::end(lhs), std::begin(rhs), std::begin(out));
+    ASSERT_EQ((std::vector<std::int16_t>{-100, 0, 90, 100, -20}), out);
+
+    houseguest::saturating_subtract_all<validator>(
+        std::begin(lhs), std::end(lhs), std::begin(rhs), std::begin(out));
+    ASSERT_EQ((std::vector<std::int16_t>{-70, 0, 10, 70, 40}), out);
+
+    auto const end = houseguest::saturating_multiply_all<validator>(
+        std::begin(lhs), std::end(lhs), std::begin(rhs), std::begin(out));
+    ASSERT_EQ(std::end(out), end);
+    ASSERT_EQ((std::vector<std::int16_t>{100, 0, 100, 100, -100}), out);
+}
@@ -0,0 +1,102 @@
+#include <houseguest/bounded_value.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using digit = houseguest::bounded_value<int, 0, 9>;
+
+    using small_positive = houseguest::bounded_value<int, 1, 5>;
+
+    using small_negative = houseguest::bounded_value<int, -5, -1>;
+
+    template <typename EXPECTED, typename ACTUAL>
+    void check_type(ACTUAL const & actual)
+    {
+        (void)actual;
+        static_assert(std::is_same<EXPECTED, ACTUAL>::value,
+                      "Unexpected result type");
+    }
+} // namespace
+
+TEST(BoundedArithmetic, add) // NOLINT
+{
+    auto const result = digit{7} + small_positive{5};
+    check_type<houseguest::bounded_value<int, 1, 14>>(result);
+    ASSERT_EQ(12, result);
+}
+
+TEST(BoundedArithmetic, subtract) // NOLINT
+{
+    auto const result = digit{2} - small_positive{5};
+    check_type<houseguest::bounded_value<int, -5, 8>>(result);
+    ASSERT_EQ(-3, result);
+}
+
+TEST(BoundedArithmetic, multiply) // NOLINT
+{
+    auto const result = digit{9} * small_negative{-5};
+    check_type<houseguest::bounded_value<int, -45, 0>>(result);
+    ASSERT_EQ(-45, result);
+}
+
+TEST(BoundedArithmetic, divide) // NOLINT
+{
+    auto const result = digit{9} / small_negative{-2};
+    check_type<houseguest::bounded_value<int, -9, 0>>(result);
+    ASSERT_EQ(-4, result);
+}
+
+TEST(BoundedArithmetic, modulus) // NOLINT
+{
+    auto const result = digit{9} % small_positive{4};
+    check_type<houseguest::bounded_value<int, 0, 4>>(result);
+    ASSERT_EQ(1, result);
+
+    auto const negative = small_negative{-5} % small_positive{3};
+    check_type<houseguest::bounded_value<int, -4, 0>>(negative);
+    ASSERT_EQ(-2, negative);
+}
+
+TEST(BoundedArithmetic, shift_left) // NOLINT
+{
+    auto const result = digit{3} << small_positive{4};
+    check_type<houseguest::bounded_value<int, 0, 288>>(result);
+    ASSERT_EQ(48, result);
+}
+
+TEST(BoundedArithmetic, shift_right) // NOLINT
+{
+    auto const result = houseguest::bounded_value<int, 16, 255>{200} >>
+                        small_positive{3};
+    check_type<houseguest::bounded_value<int, 0, 127>>(result);
+    ASSERT_EQ(25, result);
+}
+
+TEST(BoundedArithmetic, widen) // NOLINT
+{
+    using big = houseguest::bounded_value<int, 0,
+                                          std::numeric_limits<int>::max()>;
+    auto const result = big{std::numeric_limits<int>::max()} + digit{1};
+    check_type<houseguest::bounded_value<
+        std::intmax_t, 0,
+        static_cast<std::intmax_t>(std::numeric_limits<int>::max()) + 9>>(
+        result);
+    ASSERT_EQ(static_cast<std::intmax_t>(std::numeric_limits<int>::max()) + 1,
+              static_cast<std::intmax_t>(result));
+}
+
+TEST(BoundedArithmetic, unsigned_difference) // NOLINT
+{
+    using unsigned_digit = houseguest::bounded_value<unsigned, 0, 9>;
+    auto const result = unsigned_digit{1} - unsigned_digit{9};
+    check_type<houseguest::bounded_value<std::intmax_t, -9, 9>>(result);
+    ASSERT_EQ(-8, result);
+}
+
+TEST(BoundedArithmetic, chain) // NOLINT
+{
+    auto const result = (digit{9} + digit{9}) * digit{9};
+    check_type<houseguest::bounded_value<int, 0, 162>>(result);
+    ASSERT_EQ(162, result);
+}
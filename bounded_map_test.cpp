@@ -0,0 +1,111 @@
+#include <houseguest/bounded_map.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using port = houseguest::bounded_value<int, 1, 1024>;
+
+    using port_names = houseguest::bounded_map<port, std::string>;
+
+    using hour = houseguest::bounded_value<int, 0, 23>;
+
+    using hour_counts = houseguest::bounded_map<hour, int>;
+
+    constexpr hour_counts make_counts()
+    {
+        hour_counts ret{};
+        ret[hour{9}] = 3;
+        ret[hour{17}] += 2;
+        return ret;
+    }
+
+    static_assert(make_counts().size() == 2, "maps are constexpr");
+    static_assert(make_counts().at(hour{9}) == 3, "maps are constexpr");
+} // namespace
+
+TEST(BoundedMap, empty) // NOLINT
+{
+    port_names const names{};
+    ASSERT_TRUE(names.empty());
+    ASSERT_EQ(0U, names.size());
+    ASSERT_EQ(names.end(), names.begin());
+    ASSERT_THROW(names.at(port{80}), std::out_of_range); // NOLINT
+}
+
+TEST(BoundedMap, insert) // NOLINT
+{
+    port_names names{};
+    ASSERT_TRUE(names.insert(port{80}, "http"));
+    ASSERT_FALSE(names.insert(port{80}, "www"));
+    ASSERT_EQ("http", names.at(port{80}));
+    ASSERT_FALSE(names.insert_or_assign(port{80}, "www"));
+    ASSERT_EQ("www", names.at(port{80}));
+    ASSERT_TRUE(names.insert_or_assign(port{22}, "ssh"));
+    ASSERT_EQ(2U, names.size());
+    ASSERT_TRUE(names.contains(port{22}));
+    ASSERT_EQ(0U, names.count(port{23}));
+}
+
+TEST(BoundedMap, subscript) // NOLINT
+{
+    port_names names{};
+    ASSERT_TRUE(names[port{25}].empty());
+    ASSERT_TRUE(names.contains(port{25}));
+    names[port{25}] = "smtp";
+    ASSERT_EQ("smtp", names.at(port{25}));
+}
+
+TEST(BoundedMap, erase) // NOLINT
+{
+    port_names names{{port{22}, "ssh"}, {port{80}, "http"}};
+    ASSERT_EQ(1U, names.erase(port{22}));
+    ASSERT_EQ(0U, names.erase(port{22}));
+    ASSERT_EQ(1U, names.size());
+
+    // erased values are reset
+    ASSERT_TRUE(names[port{22}].empty());
+
+    names.clear();
+    ASSERT_TRUE(names.empty());
+    ASSERT_TRUE(names[port{80}].empty());
+}
+
+TEST(BoundedMap, iterate) // NOLINT
+{
+    port_names names{
+        {port{443}, "https"}, {port{22}, "ssh"}, {port{1024}, "last"}};
+    std::vector<std::pair<int, std::string>> entries;
+    for(auto const entry : names)
+    {
+        entries.emplace_back(entry.first, entry.second);
+    }
+    ASSERT_EQ((std::vector<std::pair<int, std::string>>{
+                  {22, "ssh"}, {443, "https"}, {1024, "last"}}),
+              entries);
+
+    for(auto entry : names)
+    {
+        entry.second += "!";
+    }
+    ASSERT_EQ("ssh!", names.at(port{22}));
+}
+
+TEST(BoundedMap, find) // NOLINT
+{
+    port_names names{{port{22}, "ssh"}, {port{80}, "http"}};
+    auto const it = names.find(port{80});
+    ASSERT_NE(names.end(), it);
+    ASSERT_EQ(80, (*it).first);
+    (*it).second = "www";
+    ASSERT_EQ("www", names.at(port{80}));
+    ASSERT_EQ(names.end(), names.find(port{81}));
+
+    port_names::const_iterator const cit = it;
+    ASSERT_EQ("www", (*cit).second);
+}
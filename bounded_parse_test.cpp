@@ -0,0 +1,168 @@
+#include <houseguest/bounded_parse.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using two_digit_int = houseguest::bounded_value<int, 10, 99>;
+
+    using negative_int = houseguest::bounded_value<int, -100, -10>;
+
+    using clamped_int = houseguest::clamped_value<int, -5, 5>;
+
+    using clamped_percent = houseguest::clamped_value<int, 0, 100>;
+
+    using full_int =
+        houseguest::bounded_value<std::int64_t,
+                                  std::numeric_limits<std::int64_t>::min(),
+                                  std::numeric_limits<std::int64_t>::max()>;
+
+    using full_unsigned =
+        houseguest::bounded_value<std::uint64_t, 0,
+                                  std::numeric_limits<std::uint64_t>::max()>;
+
+    template <typename CONSTRAINED>
+    houseguest::validation_result<CONSTRAINED> parse(char const * text)
+    {
+        return houseguest::parse<CONSTRAINED>(text, text + std::strlen(text));
+    }
+
+    template <typename CONSTRAINED>
+    void expect_error(std::error_code const & expected, char const * text)
+    {
+        auto const result = parse<CONSTRAINED>(text);
+        ASSERT_FALSE(result) << text;
+        ASSERT_EQ(expected, result.error()) << text;
+    }
+
+    std::error_code const invalid =
+        std::make_error_code(std::errc::invalid_argument);
+
+    std::error_code const below_min = houseguest::make_error_code(
+        houseguest::bounded_value_error::below_min);
+
+    std::error_code const above_max = houseguest::make_error_code(
+        houseguest::bounded_value_error::above_max);
+} // namespace
+
+TEST(BoundedParse, good) // NOLINT
+{
+    ASSERT_EQ(10, *parse<two_digit_int>("10"));
+    ASSERT_EQ(99, *parse<two_digit_int>("99"));
+    ASSERT_EQ(42, *parse<two_digit_int>("0042"));
+    ASSERT_EQ(-100, *parse<negative_int>("-100"));
+    ASSERT_EQ(-10, *parse<negative_int>("-10"));
+}
+
+TEST(BoundedParse, malformed) // NOLINT
+{
+    expect_error<two_digit_int>(invalid, "");
+    expect_error<two_digit_int>(invalid, "-");
+    expect_error<two_digit_int>(invalid, "+50");
+    expect_error<two_digit_int>(invalid, " 50");
+    expect_error<two_digit_int>(invalid, "50 ");
+    expect_error<two_digit_int>(invalid, "5x");
+}
+
+TEST(BoundedParse, out_of_range) // NOLINT
+{
+    expect_error<two_digit_int>(below_min, "9");
+    expect_error<two_digit_int>(below_min, "-50");
+    expect_error<two_digit_int>(above_max, "100");
+    expect_error<two_digit_int>(above_max, "99999999999999999999999999");
+    expect_error<negative_int>(below_min, "-101");
+    expect_error<negative_int>(above_max, "-9");
+    expect_error<negative_int>(above_max, "0");
+    expect_error<negative_int>(above_max, "50");
+}
+
+TEST(BoundedParse, malformed_out_of_range) // NOLINT
+{
+    // the bound is exceeded before the bad character is reached, but the
+    // text is still malformed
+    for(auto const * text : {"100x", "999x", "-5x", "-50x",
+                             "12345678901234567890zz", "-99999999999999999x"})
+    {
+        expect_error<two_digit_int>(invalid, text);
+        expect_error<clamped_percent>(invalid, text);
+        expect_error<clamped_int>(invalid, text);
+    }
+    expect_error<negative_int>(invalid, "5x");
+    expect_error<negative_int>(invalid, "-1000x");
+}
+
+TEST(BoundedParse, clamped) // NOLINT
+{
+    ASSERT_EQ(-5, *parse<clamped_int>("-1000"));
+    ASSERT_EQ(5, *parse<clamped_int>("1000000000000000000000000"));
+    ASSERT_EQ(3, *parse<clamped_int>("3"));
+    ASSERT_EQ(0, *parse<clamped_percent>("-5"));
+    expect_error<clamped_int>(invalid, "three");
+}
+
+TEST(BoundedParse, full_range) // NOLINT
+{
+    ASSERT_EQ(std::numeric_limits<std::int64_t>::min(),
+              *parse<full_int>("-9223372036854775808"));
+    ASSERT_EQ(std::numeric_limits<std::int64_t>::max(),
+              *parse<full_int>("9223372036854775807"));
+    expect_error<full_int>(below_min, "-9223372036854775809");
+    expect_error<full_int>(above_max, "9223372036854775808");
+
+    ASSERT_EQ(std::numeric_limits<std::uint64_t>::max(),
+              *parse<full_unsigned>("18446744073709551615"));
+    expect_error<full_unsigned>(above_max, "18446744073709551616");
+    ASSERT_EQ(0, *parse<full_unsigned>("-0"));
+    expect_error<full_unsigned>(below_min, "-1");
+}
+
+#if __cplusplus >= 201703L
+TEST(BoundedParse, string_view) // NOLINT
+{
+    using namespace std::literals;
+    ASSERT_EQ(55, *houseguest::parse<two_digit_int>("55"sv));
+}
+#endif
+
+TEST(BoundedParse, column) // NOLINT
+{
+    char const text[] = "10,20,99";
+    std::vector<two_digit_int> values;
+    auto const result = houseguest::parse_column<two_digit_int>(
+        std::begin(text), std::end(text) - 1, ',',
+        std::back_inserter(values));
+    ASSERT_FALSE(result.error);
+    ASSERT_EQ(std::end(text) - 1, result.position);
+    ASSERT_EQ(3, values.size());
+    ASSERT_EQ(99, values[2]);
+}
+
+TEST(BoundedParse, bad_column) // NOLINT
+{
+    char const text[] = "10\n200\n30";
+    std::vector<two_digit_int> values;
+    auto const result = houseguest::parse_column<two_digit_int>(
+        std::begin(text), std::end(text) - 1, '\n',
+        std::back_inserter(values));
+    ASSERT_EQ(above_max, result.error);
+    ASSERT_EQ(text + 3, result.position);
+    ASSERT_EQ(1, values.size());
+}
+
+TEST(BoundedParse, malformed_column) // NOLINT
+{
+    char const text[] = "10,999x,30";
+    std::vector<clamped_percent> values;
+    auto const result = houseguest::parse_column<clamped_percent>(
+        std::begin(text), std::end(text) - 1, ',',
+        std::back_inserter(values));
+    ASSERT_EQ(invalid, result.error);
+    ASSERT_EQ(text + 3, result.position);
+    ASSERT_EQ(1, values.size());
+}
@@ -0,0 +1,116 @@
+#include <houseguest/bounded_set.hpp>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using small_int = houseguest::bounded_value<int, -10, 300>;
+
+    using small_set = houseguest::bounded_set<small_int>;
+
+    static_assert(small_set::capacity == 311, "one bit per key");
+
+    constexpr small_set make_primes()
+    {
+        small_set ret{};
+        ret.insert(small_int{2});
+        ret.insert(small_int{3});
+        ret.insert(small_int{5});
+        ret.insert(small_int{7});
+        return ret;
+    }
+
+    static_assert(make_primes().size() == 4, "sets are constexpr");
+    static_assert(make_primes().contains(small_int{5}), "sets are constexpr");
+    static_assert(*make_primes().begin() == 2, "sets are constexpr");
+
+    std::vector<int> to_vector(small_set const & set)
+    {
+        std::vector<int> ret;
+        for(auto const key : set)
+        {
+            ret.push_back(key);
+        }
+        return ret;
+    }
+} // namespace
+
+TEST(BoundedSet, empty) // NOLINT
+{
+    small_set const set{};
+    ASSERT_TRUE(set.empty());
+    ASSERT_EQ(0U, set.size());
+    ASSERT_EQ(set.end(), set.begin());
+    ASSERT_FALSE(set.contains(small_int{-10}));
+}
+
+TEST(BoundedSet, insert_erase) // NOLINT
+{
+    small_set set{};
+    ASSERT_TRUE(set.insert(small_int{-10}));
+    ASSERT_TRUE(set.insert(small_int{300}));
+    ASSERT_FALSE(set.insert(small_int{300}));
+    ASSERT_EQ(2U, set.size());
+    ASSERT_TRUE(set.contains(small_int{-10}));
+    ASSERT_EQ(1U, set.count(small_int{300}));
+    ASSERT_FALSE(set.contains(small_int{0}));
+
+    ASSERT_EQ(1U, set.erase(small_int{-10}));
+    ASSERT_EQ(0U, set.erase(small_int{-10}));
+    ASSERT_EQ(1U, set.size());
+
+    set.clear();
+    ASSERT_TRUE(set.empty());
+}
+
+TEST(BoundedSet, iterate) // NOLINT
+{
+    small_set const set{small_int{300}, small_int{-10}, small_int{53},
+                        small_int{54},  small_int{117}, small_int{118}};
+    ASSERT_EQ((std::vector<int>{-10, 53, 54, 117, 118, 300}),
+              to_vector(set));
+}
+
+TEST(BoundedSet, find) // NOLINT
+{
+    small_set const set{small_int{1}, small_int{100}, small_int{200}};
+    auto it = set.find(small_int{100});
+    ASSERT_EQ(100, *it);
+    ++it;
+    ASSERT_EQ(200, *it);
+    ++it;
+    ASSERT_EQ(set.end(), it);
+    ASSERT_EQ(set.end(), set.find(small_int{2}));
+}
+
+TEST(BoundedSet, set_operations) // NOLINT
+{
+    small_set const lhs{small_int{1}, small_int{2}, small_int{250}};
+    small_set const rhs{small_int{2}, small_int{3}, small_int{250}};
+
+    ASSERT_EQ((std::vector<int>{1, 2, 3, 250}), to_vector(lhs | rhs));
+    ASSERT_EQ((std::vector<int>{2, 250}), to_vector(lhs & rhs));
+    ASSERT_EQ((std::vector<int>{1}), to_vector(lhs - rhs));
+    ASSERT_EQ((std::vector<int>{1, 3}), to_vector(lhs ^ rhs));
+    ASSERT_EQ(lhs, lhs | (lhs & rhs));
+    ASSERT_NE(lhs, rhs);
+}
+
+TEST(BoundedSet, every_key) // NOLINT
+{
+    small_set set{};
+    for(auto i = -10; i <= 300; ++i)
+    {
+        set.insert(small_int{int{i}});
+    }
+    ASSERT_EQ(small_set::capacity, set.size());
+    auto expected = -10;
+    for(auto const key : set)
+    {
+        ASSERT_EQ(expected, key);
+        ++expected;
+    }
+    ASSERT_EQ(301, expected);
+}
@@ -0,0 +1,156 @@
+#include <houseguest/bounded_sort.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#include <houseguest/constrained_vector.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    // counting sort
+    using small_int = houseguest::bounded_value<int, 0, 4095>;
+
+    // counting sort over negative values
+    using signed_int = houseguest::clamped_value<int, -100, 100>;
+
+    // counting sort, unless there are fewer values than keys
+    using short_int = houseguest::bounded_value<int, 0, 65535>;
+
+    // radix sort
+    using wide_int =
+        houseguest::bounded_value<std::int64_t, -1000000000, 1000000000>;
+
+    // radix sort over a compact storage policy
+    using compact_wide_int =
+        houseguest::compact_bounded_value<std::uint32_t, 70000, 300000>;
+
+    static_assert(houseguest::internal::range_sort_traits<
+                      small_int::validator>::counting,
+                  "12-bit ranges should use a counting sort");
+    static_assert(!houseguest::internal::range_sort_traits<
+                      wide_int::validator>::counting,
+                  "31-bit ranges should use a radix sort");
+
+    template <typename CONSTRAINED>
+    std::vector<CONSTRAINED> make_values(std::size_t count)
+    {
+        using validator = typename CONSTRAINED::validator;
+        using value_type = typename CONSTRAINED::underlying_type;
+
+        std::mt19937_64 engine{42}; // NOLINT
+        std::uniform_int_distribution<value_type> distribution{
+            validator::min, validator::max};
+        std::vector<CONSTRAINED> values;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            values.emplace_back(distribution(engine));
+        }
+        return values;
+    }
+
+    template <typename CONSTRAINED>
+    void check_sort(std::size_t count)
+    {
+        auto values = make_values<CONSTRAINED>(count);
+        auto expected = values;
+        std::sort(std::begin(expected), std::end(expected));
+        houseguest::bounded_sort(values);
+        ASSERT_EQ(expected, values);
+    }
+} // namespace
+
+TEST(BoundedSort, counting_sort) // NOLINT
+{
+    check_sort<small_int>(10000);
+    check_sort<signed_int>(1000);
+}
+
+TEST(BoundedSort, radix_sort) // NOLINT
+{
+    check_sort<wide_int>(10000);
+    check_sort<compact_wide_int>(10000);
+}
+
+TEST(BoundedSort, sparse_input) // NOLINT
+{
+    check_sort<short_int>(100);
+    check_sort<short_int>(1000);
+    check_sort<short_int>(100000);
+}
+
+TEST(BoundedSort, short_input) // NOLINT
+{
+    check_sort<small_int>(10);
+    check_sort<wide_int>(10);
+}
+
+TEST(BoundedSort, empty) // NOLINT
+{
+    std::vector<small_int> values;
+    houseguest::bounded_sort(values);
+    ASSERT_TRUE(values.empty());
+}
+
+TEST(BoundedSort, iterators) // NOLINT
+{
+    auto values = make_values<small_int>(1000);
+    houseguest::bounded_sort(std::begin(values) + 100, std::end(values));
+    ASSERT_TRUE(std::is_sorted(std::begin(values) + 100, std::end(values)));
+}
+
+TEST(BoundedSort, unqualified_std_sort) // NOLINT
+{
+    // ADL must not make this ambiguous
+    auto values = make_values<small_int>(1000);
+    using std::sort;
+    sort(std::begin(values), std::end(values));
+    ASSERT_TRUE(std::is_sorted(std::begin(values), std::end(values)));
+}
+
+TEST(BoundedSort, constrained_vector) // NOLINT
+{
+    using vector_type = houseguest::constrained_vector<
+        std::int64_t, wide_int::validator>;
+
+    auto const values = make_values<wide_int>(1000);
+    vector_type v{std::begin(values), std::end(values)};
+    v.sort();
+    ASSERT_TRUE(std::is_sorted(std::begin(v), std::end(v)));
+}
+
+TEST(BoundedSort, perfect_hash) // NOLINT
+{
+    using hash = houseguest::perfect_hash<signed_int>;
+    static_assert(hash::size == 201, "one index per value");
+
+    std::array<int, hash::size> counts{};
+    for(auto i = -100; i <= 100; ++i)
+    {
+        ++counts[hash{}(signed_int{int{i}})];
+    }
+    ASSERT_EQ(0U, hash{}(signed_int{-100}));
+    ASSERT_EQ(200U, hash{}(signed_int{100}));
+    ASSERT_TRUE(std::all_of(std::begin(counts), std::end(counts),
+                            [](int count) { return count == 1; }));
+}
+
+TEST(BoundedSort, std_hash) // NOLINT
+{
+    std::hash<signed_int> const hash{};
+    ASSERT_EQ(0U, hash(signed_int{-100}));
+    ASSERT_EQ(150U, hash(signed_int{50}));
+
+    std::unordered_set<small_int> values;
+    values.insert(small_int{7});
+    values.insert(small_int{7});
+    values.insert(small_int{4095});
+    ASSERT_EQ(2U, values.size());
+    ASSERT_EQ(1U, values.count(small_int{4095}));
+}
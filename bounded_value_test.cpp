@@ -1,5 +1,7 @@
 #include <houseguest/bounded_value.hpp>
 
+#include <algorithm>
+
 #include <gtest/gtest.h>
 
 namespace
@@ -144,3 +146,151 @@ TEST(BoundedValue, upper_boundary_convert) // NOLINT
     teens voting_age{18};
     tens driving_age{voting_age};
 }
+
+TEST(BoundedValue, subset_convert) // NOLINT
+{
+    teens voting_age{18};
+    static_assert(noexcept(two_digit_int{voting_age}),
+                  "Subset conversions shouldn't validate");
+    two_digit_int tdi{voting_age};
+    ASSERT_EQ(18, tdi);
+}
+
+TEST(BoundedValue, superset_convert) // NOLINT
+{
+    static_assert(!noexcept(teens{std::declval<two_digit_int>()}),
+                  "Narrowing conversions must validate");
+    try
+    {
+        two_digit_int tdi{12};
+        teens t{tdi};
+        FAIL();
+    }
+    catch(std::system_error const & se)
+    {
+        ASSERT_EQ(static_cast<int>(houseguest::bounded_value_error::below_min),
+                  se.code().value());
+    }
+}
+
+TEST(BoundedValue, convert_from_clamped) // NOLINT
+{
+    houseguest::clamped_value<int, 20, 30> clamped{100};
+    two_digit_int tdi{clamped};
+    ASSERT_EQ(30, tdi);
+}
+
+TEST(BoundedValue, convert_to_clamped) // NOLINT
+{
+    two_digit_int tdi{75};
+    houseguest::clamped_value<int, 20, 30> clamped{tdi};
+    ASSERT_EQ(30, clamped);
+}
+
+TEST(BoundedValue, convert_type) // NOLINT
+{
+    houseguest::bounded_value<unsigned char, 10, 200> small{150};
+    static_assert(noexcept(houseguest::bounded_value<long, 0, 1000>{small}),
+                  "Subset conversions shouldn't validate");
+    houseguest::bounded_value<long, 0, 1000> big{small};
+    ASSERT_EQ(150, big);
+
+    houseguest::bounded_value<int, -5, 100> wide{-5};
+    try
+    {
+        houseguest::bounded_value<signed char, 0, 100> narrow{wide};
+        FAIL();
+    }
+    catch(std::system_error const & se)
+    {
+        ASSERT_EQ(static_cast<int>(houseguest::bounded_value_error::below_min),
+                  se.code().value());
+    }
+}
+
+TEST(BoundedValue, convert_unrepresentable) // NOLINT
+{
+    houseguest::bounded_value<int, 0, 1000> wide{52};
+    houseguest::bounded_value<unsigned char, 0, 100> narrow{wide};
+    ASSERT_EQ(52, narrow);
+
+    // 300 would wrap to 44 if it were narrowed before validation
+    houseguest::bounded_value<int, 0, 1000> too_big{300};
+    try
+    {
+        houseguest::bounded_value<unsigned char, 0, 255> full{too_big};
+        FAIL();
+    }
+    catch(std::system_error const & se)
+    {
+        ASSERT_EQ(static_cast<int>(houseguest::bounded_value_error::above_max),
+                  se.code().value());
+    }
+
+    houseguest::bounded_value<long, -1000, 1000> low{-5};
+    houseguest::clamped_value<unsigned char, 0, 255> clamped_low{low};
+    ASSERT_EQ(0, clamped_low);
+    houseguest::bounded_value<long, -1000, 1000> high{700};
+    houseguest::clamped_value<unsigned char, 0, 255> clamped_high{high};
+    ASSERT_EQ(255, clamped_high);
+
+    using compact = houseguest::compact_bounded_value<unsigned char, 0, 255>;
+    ASSERT_EQ(52, compact{wide});
+    ASSERT_THROW(compact{too_big}, std::system_error); // NOLINT
+}
+
+TEST(BoundedValue, validator_traits) // NOLINT
+{
+    using tens_validator = tens::validator;
+    using teens_validator = teens::validator;
+    static_assert(
+        houseguest::is_validator_subset<teens_validator, tens_validator>::value,
+        "teens should fit in tens");
+    static_assert(
+        !houseguest::is_validator_subset<tens_validator, teens_validator>::value,
+        "tens shouldn't fit in teens");
+    static_assert(houseguest::is_validator_convertible_v<tens_validator,
+                                                         teens_validator>,
+                  "overlapping validators should be convertible");
+    static_assert(
+        !houseguest::is_validator_convertible_v<
+            tens_validator, houseguest::exception_validator<unsigned, 20, 30>>,
+        "disjoint validators shouldn't be convertible");
+}
+
+TEST(BoundedValue, unchecked) // NOLINT
+{
+    constexpr two_digit_int constant{houseguest::unchecked, 42};
+    static_assert(static_cast<int>(constant) == 42,
+                  "Unchecked construction should be constexpr");
+
+    auto const narrowed = std::min(std::max(7, 10), 99);
+    two_digit_int const tdi{houseguest::unchecked, narrowed};
+    ASSERT_EQ(10, tdi);
+}
+
+#ifndef NDEBUG
+TEST(BoundedValueDeathTest, unchecked_invalid) // NOLINT
+{
+    ASSERT_DEATH(two_digit_int(houseguest::unchecked, 100), ""); // NOLINT
+}
+#endif
+
+TEST(BoundedValue, constexpr_construct) // NOLINT
+{
+    constexpr two_digit_int validated{42};
+    static_assert(static_cast<int>(validated) == 42,
+                  "Validating construction should be constexpr");
+
+    constexpr houseguest::clamped_value<int, 10, 99> clamped{150};
+    static_assert(static_cast<int>(clamped) == 99,
+                  "Clamping should be constexpr");
+
+    constexpr two_digit_int table[] = {
+        houseguest::make_bounded<two_digit_int, 10>(),
+        houseguest::make_bounded<two_digit_int, 55>(),
+        houseguest::make_bounded<two_digit_int, 99>()};
+    static_assert(static_cast<int>(table[1]) == 55,
+                  "make_bounded should be constexpr");
+    ASSERT_EQ(99, table[2]);
+}
@@ -1,10 +1,32 @@
 #include <houseguest/bounded_value.hpp>
 
+#include <cstdint>
+#include <limits>
+
 #include <gtest/gtest.h>
 
 namespace
 {
     using two_digit_int = houseguest::clamped_value<int, 10, 99>;
+
+    // computed exactly in int
+    using sample = houseguest::clamped_value<std::int16_t, -32768, 32767>;
+
+    // computed with overflow detection
+    using big_int = houseguest::clamped_value<std::int64_t, -1000,
+                                              std::numeric_limits<
+                                                  std::int64_t>::max()>;
+
+    using big_unsigned = houseguest::clamped_value<std::uint64_t, 10,
+                                                   std::numeric_limits<
+                                                       std::uint64_t>::max()>;
+
+    static_assert(houseguest::internal::saturating_add<int, 10, 99>(50, 60) ==
+                      99,
+                  "saturating arithmetic is constexpr");
+    static_assert(houseguest::internal::saturating_multiply<
+                      std::int64_t, -1000, 1000>(INT64_MAX, -2) == -1000,
+                  "saturating arithmetic is constexpr");
 } // namespace
 
 TEST(ClampedValue, below_min) // NOLINT
@@ -27,3 +49,46 @@ TEST(ClampedValue, in_range) // NOLINT
 
     ASSERT_EQ(27, tdi);
 }
+
+TEST(ClampedValue, saturating_add) // NOLINT
+{
+    ASSERT_EQ(50, two_digit_int{20} + two_digit_int{30});
+    ASSERT_EQ(99, two_digit_int{50} + two_digit_int{60});
+    ASSERT_EQ(32767, sample{30000} + sample{30000});
+    ASSERT_EQ(-32768, sample{-30000} + sample{-30000});
+    ASSERT_EQ(std::numeric_limits<std::int64_t>::max(),
+              big_int{std::numeric_limits<std::int64_t>::max()} +
+                  big_int{1});
+    ASSERT_EQ(-1000, big_int{-600} + big_int{-600});
+    ASSERT_EQ(std::numeric_limits<std::uint64_t>::max(),
+              big_unsigned{std::numeric_limits<std::uint64_t>::max()} +
+                  big_unsigned{10});
+}
+
+TEST(ClampedValue, saturating_subtract) // NOLINT
+{
+    ASSERT_EQ(40, two_digit_int{60} - two_digit_int{20});
+    ASSERT_EQ(10, two_digit_int{20} - two_digit_int{60});
+    ASSERT_EQ(-32768, sample{-30000} - sample{30000});
+    ASSERT_EQ(32767, sample{30000} - sample{-30000});
+    ASSERT_EQ(std::numeric_limits<std::int64_t>::max(),
+              big_int{std::numeric_limits<std::int64_t>::max()} -
+                  big_int{-1});
+    ASSERT_EQ(10, big_unsigned{10} - big_unsigned{20});
+}
+
+TEST(ClampedValue, saturating_multiply) // NOLINT
+{
+    ASSERT_EQ(-30000, sample{-300} * sample{100});
+    ASSERT_EQ(99, two_digit_int{10} * two_digit_int{10});
+    ASSERT_EQ(32767, sample{-300} * sample{-300});
+    ASSERT_EQ(-32768, sample{-300} * sample{300});
+    ASSERT_EQ(std::numeric_limits<std::int64_t>::max(),
+              big_int{std::numeric_limits<std::int64_t>::max() / 2} *
+                  big_int{3});
+    ASSERT_EQ(-1000, big_int{std::numeric_limits<std::int64_t>::max()} *
+                         big_int{-1});
+    ASSERT_EQ(std::numeric_limits<std::uint64_t>::max(),
+              big_unsigned{std::uint64_t{1} << 40} *
+                  big_unsigned{std::uint64_t{1} << 40});
+}
@@ -0,0 +1,89 @@
+# Compile SOURCE to assembly and compare the size of its functions.
+#
+# Expected variables:
+#   COMPILER    the C++ compiler (GCC or Clang)
+#   STANDARD    the C++ standard to compile with (e.g., 14)
+#   INCLUDE_DIR houseguest's include directory
+#   SOURCE      the source file to check
+#   OUTPUT      where to write the generated assembly
+#
+# SOURCE lists its checks in comments of the form
+#
+#     // codegen: FUNCTION BASELINE INSTRUCTIONS BRANCHES
+#
+# and each check fails if FUNCTION has more than INSTRUCTIONS instructions or
+# BRANCHES branches beyond those in BASELINE.
+
+execute_process(
+    COMMAND "${COMPILER}" -std=c++${STANDARD} -O2 -DNDEBUG -S
+            -I "${INCLUDE_DIR}" -o "${OUTPUT}" "${SOURCE}"
+    RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Failed to compile ${SOURCE}")
+endif()
+
+# Brackets and semicolons have special meaning in CMake lists, and aren't
+# needed to recognize instructions.
+file(READ "${OUTPUT}" assembly)
+string(REGEX REPLACE "[][;]" "" assembly "${assembly}")
+string(REPLACE "\n" ";" lines "${assembly}")
+
+set(function "")
+foreach(line IN LISTS lines)
+    if(line MATCHES "^_?([A-Za-z_][A-Za-z0-9_]*):")
+        # Mach-O prefixes symbols with an underscore
+        set(function "${CMAKE_MATCH_1}")
+        set(instructions_${function} 0)
+        set(branches_${function} 0)
+    elseif(line MATCHES "^[ \t]*\\.(size|cfi_endproc)")
+        set(function "")
+    elseif(function AND line MATCHES "^[ \t]+([a-z][a-z0-9.]*)")
+        set(mnemonic "${CMAKE_MATCH_1}")
+        math(EXPR instructions_${function} "${instructions_${function}} + 1")
+        # x86 jumps, and AArch64 branches and compare-and-branches
+        if(mnemonic MATCHES "^(j[a-z]+|b|b\\.[a-z]+|cbn?z|tbn?z)$")
+            math(EXPR branches_${function} "${branches_${function}} + 1")
+        endif()
+    endif()
+endforeach()
+
+file(STRINGS "${SOURCE}" checks
+    REGEX "^[ \t]*// codegen: [a-z_]+ [a-z_]+ [0-9]+ [0-9]+$"
+)
+if(NOT checks)
+    message(FATAL_ERROR "No checks found in ${SOURCE}")
+endif()
+
+set(failed FALSE)
+foreach(check IN LISTS checks)
+    string(REGEX MATCH "codegen: ([a-z_]+) ([a-z_]+) ([0-9]+) ([0-9]+)" _
+        "${check}")
+    set(checked "${CMAKE_MATCH_1}")
+    set(baseline "${CMAKE_MATCH_2}")
+    set(extra_instructions "${CMAKE_MATCH_3}")
+    set(extra_branches "${CMAKE_MATCH_4}")
+    foreach(name IN ITEMS ${checked} ${baseline})
+        if(NOT DEFINED instructions_${name})
+            message(FATAL_ERROR "Couldn't find ${name} in ${OUTPUT}")
+        endif()
+    endforeach()
+
+    math(EXPR max_instructions
+        "${instructions_${baseline}} + ${extra_instructions}")
+    math(EXPR max_branches "${branches_${baseline}} + ${extra_branches}")
+    set(summary "${checked}: ${instructions_${checked}} instructions")
+    string(APPEND summary " (max ${max_instructions}), ")
+    string(APPEND summary "${branches_${checked}} branches (max ${max_branches})")
+    if((instructions_${checked} GREATER max_instructions) OR
+       (branches_${checked} GREATER max_branches))
+        message(SEND_ERROR "${summary}")
+        set(failed TRUE)
+    else()
+        message(STATUS "${summary}")
+    endif()
+endforeach()
+
+if(failed)
+    message(FATAL_ERROR "Generated code for ${SOURCE} has regressed")
+endif()
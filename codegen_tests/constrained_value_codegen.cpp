@@ -0,0 +1,125 @@
+#include <houseguest/bounded_value.hpp>
+#include <houseguest/validation_result.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+// Each constrained function is compared against a hand-written function on
+// raw values that does the same work.  A line of the form
+//
+//     codegen: FUNCTION BASELINE INSTRUCTIONS BRANCHES
+//
+// fails the test if FUNCTION has more than INSTRUCTIONS instructions or
+// BRANCHES branches beyond those in BASELINE.  Functions have C linkage so
+// their names can be found in the generated assembly.
+
+namespace
+{
+    using percent = houseguest::bounded_value<int, 0, 100>;
+
+    using wide_percent = houseguest::bounded_value<long, 0, 1000>;
+
+    using clamped_percent = houseguest::clamped_value<int, 0, 100>;
+
+    using checked_percent = houseguest::checked_value<int, 0, 100>;
+
+    // otherwise, constrained_values are passed in memory instead of
+    // registers
+    static_assert(std::is_trivially_copyable<percent>::value,
+                  "constrained_value should be trivially copyable");
+} // namespace
+
+extern "C"
+{
+    // codegen: clamp_constrained clamp_raw 0 0
+    int clamp_raw(int value)
+    {
+        return std::min(std::max(value, 0), 100);
+    }
+
+    int clamp_constrained(int value)
+    {
+        return clamped_percent{std::move(value)};
+    }
+
+    // codegen: add_constrained add_raw 0 0
+    int add_raw(int lhs, int rhs)
+    {
+        auto const sum = static_cast<long long>(lhs) + rhs;
+        return static_cast<int>(std::min(std::max(sum, 0LL), 100LL));
+    }
+
+    int add_constrained(clamped_percent lhs, clamped_percent rhs)
+    {
+        return lhs + rhs;
+    }
+
+    // the constrained version builds an std::error_code on failure, which
+    // initializes the error category on first use
+    // codegen: try_constrained try_raw 24 4
+    int try_raw(int value)
+    {
+        return ((value >= 0) && (value <= 100)) ? value : 0;
+    }
+
+    int try_constrained(int value)
+    {
+        return houseguest::try_make<checked_percent>(value).value_or(
+            houseguest::make_bounded<checked_percent, 0>());
+    }
+
+    // codegen: unchecked_constrained unchecked_raw 0 0
+    int unchecked_raw(int value)
+    {
+        return value;
+    }
+
+    int unchecked_constrained(int value)
+    {
+        return percent{houseguest::unchecked, value};
+    }
+
+    // codegen: less_constrained less_raw 0 0
+    bool less_raw(int lhs, int rhs)
+    {
+        return lhs < rhs;
+    }
+
+    bool less_constrained(percent lhs, percent rhs)
+    {
+        return lhs < rhs;
+    }
+
+    // codegen: widen_constrained widen_raw 0 0
+    long widen_raw(int value)
+    {
+        return value;
+    }
+
+    long widen_constrained(percent value)
+    {
+        return wide_percent{value};
+    }
+
+    // codegen: sum_constrained sum_raw 0 0
+    long sum_raw(int const * values, std::size_t count)
+    {
+        long ret = 0;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            ret += values[i];
+        }
+        return ret;
+    }
+
+    long sum_constrained(percent const * values, std::size_t count)
+    {
+        long ret = 0;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            ret += values[i];
+        }
+        return ret;
+    }
+}
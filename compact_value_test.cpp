@@ -0,0 +1,79 @@
+#include <houseguest/bounded_value.hpp>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using percent = houseguest::compact_bounded_value<int, 0, 100>;
+
+    using offset_percent = houseguest::compact_bounded_value<int, 1000, 1200>;
+
+    using wide = houseguest::compact_bounded_value<long, -40000, 40000>;
+
+    using clamped_offset = houseguest::compact_clamped_value<int, -200, -100>;
+
+    static_assert(sizeof(percent) == 1, "percent should fit in a byte");
+    static_assert(sizeof(offset_percent) == 1,
+                  "offset_percent should fit in a byte");
+    static_assert(sizeof(wide) == 4, "wide should need four bytes");
+    static_assert(sizeof(clamped_offset) == 1,
+                  "clamped_offset should fit in a byte");
+} // namespace
+
+TEST(CompactValue, values) // NOLINT
+{
+    percent p{100};
+    ASSERT_EQ(100, p);
+
+    offset_percent op{1200};
+    ASSERT_EQ(1200, op);
+    op = offset_percent{1000};
+    ASSERT_EQ(1000, op);
+
+    wide w{-40000};
+    ASSERT_EQ(-40000, w);
+}
+
+TEST(CompactValue, bad_value) // NOLINT
+{
+    try
+    {
+        offset_percent op{999};
+        FAIL();
+    }
+    catch(std::system_error const & se)
+    {
+        ASSERT_EQ(static_cast<int>(houseguest::bounded_value_error::below_min),
+                  se.code().value());
+    }
+}
+
+TEST(CompactValue, clamped) // NOLINT
+{
+    clamped_offset low{-1000};
+    ASSERT_EQ(-200, low);
+
+    clamped_offset high{0};
+    ASSERT_EQ(-100, high);
+}
+
+TEST(CompactValue, compare) // NOLINT
+{
+    offset_percent const small{1001};
+    offset_percent const big{1100};
+    ASSERT_LT(small, big);
+    ASSERT_NE(small, big);
+    ASSERT_EQ(small, offset_percent{1001});
+}
+
+TEST(CompactValue, convert) // NOLINT
+{
+    offset_percent const op{1050};
+    houseguest::bounded_value<int, 0, 2000> bv{op};
+    ASSERT_EQ(1050, bv);
+
+    percent const p{houseguest::bounded_value<int, 10, 20>{15}};
+    ASSERT_EQ(15, p);
+}
@@ -0,0 +1,162 @@
+#include <houseguest/composite_validator.hpp>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <houseguest/bounded_algorithm.hpp>
+#include <houseguest/bounded_parse.hpp>
+#include <houseguest/oddeven_value.hpp>
+#include <houseguest/validation_result.hpp>
+
+namespace
+{
+    using even = houseguest::oddeven_validator<int, true>;
+
+    using odd = houseguest::oddeven_validator<int, false>;
+
+    using multiple_of_8 = houseguest::multiple_of_validator<int, 8>;
+
+    using multiple_of_3 = houseguest::multiple_of_validator<int, 3>;
+
+    using power_of_two = houseguest::power_of_two_validator<int>;
+
+    using kilo = houseguest::exception_validator<int, 0, 1024>;
+
+    using even_kilo = houseguest::all_of<even, kilo>;
+
+    using aligned_kilo = houseguest::all_of<multiple_of_8, even, kilo>;
+
+    using small_or_huge =
+        houseguest::any_of<houseguest::exception_validator<int, 0, 9>,
+                           houseguest::exception_validator<int, 1000, 1009>>;
+
+    static_assert(even::test(4) && !even::test(-3), "even");
+    static_assert(odd::test(-3) && !odd::test(4), "odd");
+    static_assert(multiple_of_8::test(-16) && !multiple_of_8::test(12),
+                  "multiple of 8");
+    static_assert(multiple_of_3::test(-9) && !multiple_of_3::test(10),
+                  "multiple of 3");
+    static_assert(power_of_two::test(1) && power_of_two::test(64) &&
+                      !power_of_two::test(0) && !power_of_two::test(-4) &&
+                      !power_of_two::test(12),
+                  "power of two");
+    static_assert(even_kilo::test(1024) && !even_kilo::test(1026) &&
+                      !even_kilo::test(-2) && !even_kilo::test(7),
+                  "even and in [0, 1024]");
+    static_assert(small_or_huge::test(5) && small_or_huge::test(1005) &&
+                      !small_or_huge::test(500),
+                  "any_of");
+
+    // masks and ranges are merged into a single mask and range
+    static_assert(houseguest::internal::all_of_traits<multiple_of_8, even,
+                                                      kilo>::mask == 7,
+                  "masks should be merged");
+    static_assert((aligned_kilo::min == 0) && (aligned_kilo::max == 1024),
+                  "ranges should be merged");
+    static_assert((small_or_huge::min == 0) && (small_or_huge::max == 1009),
+                  "any_of should cover every range");
+    static_assert(!houseguest::is_range_validator<even_kilo>::value,
+                  "all_of has constraints beyond its range");
+
+    // empty validators stay empty
+    static_assert(sizeof(houseguest::constrained_value<int, aligned_kilo>) ==
+                      sizeof(int),
+                  "composite validators shouldn't add storage");
+} // namespace
+
+TEST(OddEvenValue, good) // NOLINT
+{
+    houseguest::oddeven_value<int, true> e{42};
+    ASSERT_EQ(42, e);
+    houseguest::oddeven_value<int, false> o{-7};
+    ASSERT_EQ(-7, o);
+}
+
+TEST(OddEvenValue, bad) // NOLINT
+{
+    try
+    {
+        houseguest::oddeven_value<int, true> e{41};
+        FAIL();
+    }
+    catch(std::system_error const & se)
+    {
+        ASSERT_EQ(houseguest::constraint_error::wrong_parity, se.code());
+    }
+}
+
+TEST(CompositeValidator, all_of) // NOLINT
+{
+    houseguest::constrained_value<int, aligned_kilo> value{512};
+    ASSERT_EQ(512, value);
+
+    using aligned_kilo_value =
+        houseguest::constrained_value<int, aligned_kilo>;
+    ASSERT_THROW(aligned_kilo_value{1032}, std::system_error); // NOLINT
+    ASSERT_THROW(aligned_kilo_value{12}, std::system_error);   // NOLINT
+}
+
+TEST(CompositeValidator, all_of_check) // NOLINT
+{
+    aligned_kilo const validator{};
+    ASSERT_FALSE(validator.check(16));
+    ASSERT_EQ(houseguest::constraint_error::not_multiple, validator.check(4));
+    ASSERT_EQ(houseguest::constraint_error::wrong_parity,
+              even_kilo{}.check(3));
+    ASSERT_EQ(houseguest::bounded_value_error::above_max,
+              validator.check(2048));
+
+    using composite = houseguest::all_of<power_of_two, multiple_of_3>;
+    ASSERT_EQ(houseguest::constraint_error::not_power_of_two,
+              composite{}.check(6));
+}
+
+TEST(CompositeValidator, any_of) // NOLINT
+{
+    using value_type = houseguest::constrained_value<int, small_or_huge>;
+    value_type value{1001};
+    ASSERT_EQ(1001, value);
+    try
+    {
+        value_type bad{10};
+        FAIL();
+    }
+    catch(std::system_error const & se)
+    {
+        ASSERT_EQ(houseguest::constraint_error::no_match, se.code());
+    }
+}
+
+TEST(CompositeValidator, try_make) // NOLINT
+{
+    using value_type = houseguest::constrained_value<int, even_kilo>;
+    ASSERT_TRUE(houseguest::try_make<value_type>(10));
+    ASSERT_EQ(houseguest::constraint_error::wrong_parity,
+              houseguest::try_make<value_type>(11).error());
+}
+
+TEST(CompositeValidator, parse) // NOLINT
+{
+    using value_type = houseguest::constrained_value<int, even_kilo>;
+    char const text[] = "11";
+    auto const result =
+        houseguest::parse<value_type>(std::begin(text), std::end(text) - 1);
+    ASSERT_EQ(houseguest::constraint_error::wrong_parity, result.error());
+}
+
+TEST(CompositeValidator, validate_all) // NOLINT
+{
+    std::vector<int> values;
+    for(auto i = 0; i < 200; ++i)
+    {
+        values.push_back(i * 2);
+    }
+    ASSERT_EQ(std::end(values),
+              houseguest::validate_all<even_kilo>(std::begin(values),
+                                                  std::end(values)));
+    values[150] = 7;
+    ASSERT_EQ(std::begin(values) + 150,
+              houseguest::validate_all<even_kilo>(std::begin(values),
+                                                  std::end(values)));
+}
@@ -0,0 +1,284 @@
+#include <houseguest/concurrent_cache.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using int_cache = houseguest::concurrent_cache<int, int>;
+
+    // returns its key doubled and counts how often it's called
+    struct doubler
+    {
+        int operator()(int key) const
+        {
+            ++*calls;
+            return key * 2;
+        }
+
+        std::atomic<int> * calls;
+    };
+
+    // throws from its copy constructor once copies_left reaches zero
+    struct fragile
+    {
+        explicit fragile(int v)
+          : value{v}
+        {
+        }
+
+        fragile(fragile const & other)
+          : value{other.value}
+        {
+            if(copies_left >= 0 && copies_left-- == 0)
+            {
+                throw std::runtime_error{"copy"};
+            }
+        }
+
+        fragile & operator=(fragile const &) = default;
+
+        static int copies_left;
+
+        int value;
+    };
+
+    int fragile::copies_left = -1;
+
+    // forces most keys into the same probe sequence
+    struct colliding_hash
+    {
+        std::size_t operator()(int key) const noexcept
+        {
+            return static_cast<std::size_t>(key % 3);
+        }
+    };
+} // namespace
+
+TEST(ConcurrentCache, bad_construction) // NOLINT
+{
+    ASSERT_THROW(int_cache(0), std::invalid_argument);     // NOLINT
+    ASSERT_THROW(int_cache(10, 0), std::invalid_argument); // NOLINT
+}
+
+TEST(ConcurrentCache, capacity) // NOLINT
+{
+    int_cache const cache{10, 4};
+    ASSERT_EQ(4, cache.shard_count());
+    ASSERT_EQ(12, cache.capacity());
+    ASSERT_EQ(0, cache.size());
+}
+
+TEST(ConcurrentCache, hit_and_miss) // NOLINT
+{
+    std::atomic<int> calls{0};
+    int_cache cache{16};
+    ASSERT_EQ(10, cache.get_or_compute(5, doubler{&calls}));
+    ASSERT_EQ(10, cache.get_or_compute(5, doubler{&calls}));
+    ASSERT_EQ(14, cache.get_or_compute(7, doubler{&calls}));
+    ASSERT_EQ(2, calls.load());
+    ASSERT_EQ(2, cache.size());
+
+    auto const stats = cache.statistics();
+    ASSERT_EQ(1, stats.hits);
+    ASSERT_EQ(2, stats.misses);
+    ASSERT_EQ(0, stats.coalesced);
+    ASSERT_EQ(0, stats.evictions);
+    ASSERT_EQ(3, stats.lookups());
+    ASSERT_DOUBLE_EQ(1.0 / 3.0, stats.hit_rate());
+}
+
+TEST(ConcurrentCache, non_trivial_values) // NOLINT
+{
+    houseguest::concurrent_cache<std::string, std::string> cache{4, 1};
+    for(int i = 0; i < 20; ++i)
+    {
+        auto const key = std::to_string(i);
+        auto const value = cache.get_or_compute(
+            key, [](std::string const & k) { return k + k; });
+        ASSERT_EQ(key + key, value);
+    }
+    ASSERT_EQ(4, cache.size());
+    ASSERT_EQ(16, cache.statistics().evictions);
+}
+
+TEST(ConcurrentCache, eviction) // NOLINT
+{
+    std::atomic<int> calls{0};
+    int_cache cache{4, 1};
+    for(int i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(i * 2, cache.get_or_compute(i, doubler{&calls}));
+    }
+    ASSERT_EQ(4, cache.size());
+    ASSERT_EQ(96, cache.statistics().evictions);
+
+    // the most recent values are still cached
+    calls = 0;
+    for(int i = 96; i < 100; ++i)
+    {
+        ASSERT_EQ(i * 2, cache.get_or_compute(i, doubler{&calls}));
+    }
+    ASSERT_EQ(0, calls.load());
+}
+
+TEST(ConcurrentCache, collisions) // NOLINT
+{
+    std::atomic<int> calls{0};
+    houseguest::concurrent_cache<int, int, colliding_hash> cache{8, 1};
+    std::mt19937 engine{7}; // NOLINT
+    std::uniform_int_distribution<int> keys{0, 40};
+    for(int i = 0; i < 5000; ++i)
+    {
+        auto const key = keys(engine);
+        ASSERT_EQ(key * 2, cache.get_or_compute(key, doubler{&calls}));
+    }
+    ASSERT_EQ(8, cache.size());
+    auto const stats = cache.statistics();
+    ASSERT_EQ(stats.misses, calls.load());
+    ASSERT_EQ(stats.misses - 8, stats.evictions);
+}
+
+TEST(ConcurrentCache, second_chance) // NOLINT
+{
+    std::atomic<int> calls{0};
+    int_cache cache{2, 1};
+    cache.get_or_compute(1, doubler{&calls});
+    cache.get_or_compute(2, doubler{&calls});
+
+    // referencing 1 should make 2 the victim
+    cache.get_or_compute(1, doubler{&calls});
+    cache.get_or_compute(3, doubler{&calls});
+    ASSERT_EQ(3, calls.load());
+
+    cache.get_or_compute(1, doubler{&calls});
+    ASSERT_EQ(3, calls.load());
+    cache.get_or_compute(2, doubler{&calls});
+    ASSERT_EQ(4, calls.load());
+}
+
+TEST(ConcurrentCache, compute_throws) // NOLINT
+{
+    int_cache cache{4};
+    ASSERT_THROW(cache.get_or_compute( // NOLINT
+                     1, [](int) -> int { throw std::runtime_error{"no"}; }),
+                 std::runtime_error);
+    ASSERT_EQ(0, cache.size());
+    ASSERT_EQ(3, cache.get_or_compute(1, [](int) { return 3; }));
+}
+
+TEST(ConcurrentCache, copy_throws) // NOLINT
+{
+    houseguest::concurrent_cache<int, fragile> cache{2, 1};
+    auto const make = [](int key) { return fragile{key}; };
+    cache.get_or_compute(1, make);
+    cache.get_or_compute(2, make);
+
+    // the copy into the cache throws while it's full
+    fragile::copies_left = 0;
+    ASSERT_THROW(cache.get_or_compute(3, make), // NOLINT
+                 std::runtime_error);
+    fragile::copies_left = -1;
+    ASSERT_EQ(2, cache.size());
+    ASSERT_EQ(0, cache.statistics().evictions);
+
+    auto const missing = [](int) -> fragile {
+        throw std::logic_error{"should be cached"};
+    };
+    ASSERT_EQ(1, cache.get_or_compute(1, missing).value);
+    ASSERT_EQ(2, cache.get_or_compute(2, missing).value);
+
+    // eviction still works afterwards
+    for(int i = 3; i < 10; ++i)
+    {
+        ASSERT_EQ(i, cache.get_or_compute(i, make).value);
+    }
+    ASSERT_EQ(2, cache.size());
+    ASSERT_EQ(7, cache.statistics().evictions);
+}
+
+TEST(ConcurrentCache, single_flight) // NOLINT
+{
+    int_cache cache{4};
+    std::atomic<int> calls{0};
+    std::promise<void> started;
+    std::promise<void> release;
+    auto const released = release.get_future().share();
+
+    auto computer = std::async(std::launch::async, [&]() {
+        return cache.get_or_compute(1, [&](int key) {
+            ++calls;
+            started.set_value();
+            released.wait();
+            return key + 100;
+        });
+    });
+    started.get_future().wait();
+
+    std::vector<std::future<int>> waiters;
+    for(int i = 0; i < 4; ++i)
+    {
+        waiters.push_back(std::async(std::launch::async, [&]() {
+            return cache.get_or_compute(1, [&](int key) {
+                ++calls;
+                return key;
+            });
+        }));
+    }
+
+    // give the waiters time to find the computation in flight
+    while(cache.statistics().coalesced < waiters.size())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    release.set_value();
+
+    ASSERT_EQ(101, computer.get());
+    for(auto & waiter : waiters)
+    {
+        ASSERT_EQ(101, waiter.get());
+    }
+    ASSERT_EQ(1, calls.load());
+    ASSERT_EQ(1, cache.statistics().misses);
+}
+
+TEST(ConcurrentCache, multi_thread) // NOLINT
+{
+    int_cache cache{64, 8};
+    std::atomic<int> calls{0};
+    std::vector<std::thread> threads;
+    std::atomic<bool> failed{false};
+    for(unsigned t = 0; t < 8; ++t)
+    {
+        threads.emplace_back([&cache, &calls, &failed, t]() {
+            std::mt19937 engine{t};
+            std::uniform_int_distribution<int> keys{0, 255};
+            for(int i = 0; i < 10000; ++i)
+            {
+                auto const key = keys(engine);
+                if(cache.get_or_compute(key, doubler{&calls}) != key * 2)
+                {
+                    failed = true;
+                }
+            }
+        });
+    }
+    for(auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_FALSE(failed.load());
+    auto const stats = cache.statistics();
+    ASSERT_EQ(80000, stats.lookups());
+    ASSERT_EQ(stats.misses, calls.load());
+    ASSERT_LE(cache.size(), cache.capacity());
+}
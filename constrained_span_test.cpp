@@ -0,0 +1,155 @@
+#include <houseguest/constrained_span.hpp>
+
+#include <numeric>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <houseguest/bounded_value.hpp>
+#include <houseguest/composite_validator.hpp>
+#include <houseguest/oddeven_value.hpp>
+
+namespace
+{
+    using percent_validator = houseguest::exception_validator<int, 0, 100>;
+
+    using percent_span = houseguest::constrained_span<int, percent_validator>;
+
+    using percent_reader =
+        houseguest::constrained_span_reader<int, percent_validator>;
+
+    std::vector<int> make_values(std::size_t count)
+    {
+        std::vector<int> ret(count);
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            ret[i] = static_cast<int>(i % 101);
+        }
+        return ret;
+    }
+} // namespace
+
+TEST(ConstrainedSpan, default_ctor) // NOLINT
+{
+    percent_span const span;
+    ASSERT_TRUE(span.empty());
+    ASSERT_EQ(0, span.size());
+    ASSERT_EQ(span.begin(), span.end());
+}
+
+TEST(ConstrainedSpan, view) // NOLINT
+{
+    auto const values = make_values(1000);
+    percent_span const span{values.data(), values.size()};
+
+    ASSERT_EQ(values.size(), span.size());
+    ASSERT_EQ(values.data(), span.data());
+    ASSERT_EQ(0, span.front());
+    ASSERT_EQ(90, span.back());
+    ASSERT_EQ(100, span[100]);
+    ASSERT_EQ(5, span.at(106));
+    ASSERT_THROW(span.at(1000), std::out_of_range); // NOLINT
+
+    auto const total = std::accumulate(
+        span.begin(), span.end(), 0L,
+        [](long sum, percent_span::value_type value) {
+            return sum + static_cast<int>(value);
+        });
+    ASSERT_EQ(std::accumulate(values.begin(), values.end(), 0L), total);
+}
+
+TEST(ConstrainedSpan, array) // NOLINT
+{
+    static int const values[] = {1, 2, 3};
+    percent_span const span{values};
+    ASSERT_EQ(3, span.size());
+    ASSERT_EQ(3, span.back());
+}
+
+TEST(ConstrainedSpan, invalid) // NOLINT
+{
+    auto values = make_values(1000);
+    values[777] = 101;
+    try
+    {
+        percent_span const span{values.data(), values.data() + values.size()};
+        FAIL() << "Construction should have thrown";
+    }
+    catch(std::system_error const & e)
+    {
+        ASSERT_EQ(houseguest::bounded_value_error::above_max, e.code());
+    }
+
+    values[777] = -1;
+    ASSERT_THROW(percent_span(values.data(), values.size()), // NOLINT
+                 std::system_error);
+}
+
+TEST(ConstrainedSpan, subspan) // NOLINT
+{
+    auto const values = make_values(10);
+    percent_span const span{values.data(), values.size()};
+
+    auto const middle = span.subspan(2, 3);
+    ASSERT_EQ(3, middle.size());
+    ASSERT_EQ(2, middle.front());
+    ASSERT_EQ(4, middle.back());
+
+    ASSERT_EQ(7, span.subspan(3).size());
+    ASSERT_EQ(0, span.subspan(10).size());
+    ASSERT_EQ(2, span.first(2).size());
+    ASSERT_EQ(8, span.last(2).front());
+}
+
+TEST(ConstrainedSpan, test_validator) // NOLINT
+{
+    using even_percent =
+        houseguest::all_of<houseguest::oddeven_validator<int, true>,
+                           percent_validator>;
+    using even_span = houseguest::constrained_span<int, even_percent>;
+
+    static int const good[] = {0, 2, 100};
+    ASSERT_EQ(3, even_span{good}.size());
+
+    static int const bad[] = {0, 3, 100};
+    ASSERT_THROW(even_span{bad}, std::system_error); // NOLINT
+}
+
+TEST(ConstrainedSpanReader, chunks) // NOLINT
+{
+    auto const values = make_values(1000);
+    percent_reader reader{values.data(), values.size(), 300};
+
+    std::vector<std::size_t> sizes;
+    long total = 0;
+    while(!reader.done())
+    {
+        auto const chunk = reader.next();
+        sizes.push_back(chunk.size());
+        for(auto const value : chunk)
+        {
+            total += static_cast<int>(value);
+        }
+    }
+    ASSERT_EQ((std::vector<std::size_t>{300, 300, 300, 100}), sizes);
+    ASSERT_EQ(std::accumulate(values.begin(), values.end(), 0L), total);
+    ASSERT_TRUE(reader.next().empty());
+}
+
+TEST(ConstrainedSpanReader, invalid_chunk) // NOLINT
+{
+    auto values = make_values(1000);
+    values[450] = 1000;
+    percent_reader reader{values.data(), values.size(), 300};
+
+    ASSERT_EQ(300, reader.next().size());
+    ASSERT_THROW(reader.next(), std::system_error); // NOLINT
+    ASSERT_EQ(300, reader.position());
+    ASSERT_EQ(700, reader.remaining());
+
+    // nothing past the first chunk was validated, so it can be fixed
+    values[450] = 0;
+    ASSERT_EQ(300, reader.next().size());
+}
@@ -0,0 +1,166 @@
+#include <houseguest/constrained_vector.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <houseguest/bounded_value.hpp>
+
+namespace
+{
+    using two_digit_vector =
+        houseguest::constrained_vector<int,
+                                       houseguest::exception_validator<int, 10,
+                                                                       99>>;
+
+    using clamped_vector =
+        houseguest::constrained_vector<int,
+                                       houseguest::clamping_validator<int, 10,
+                                                                      99>>;
+} // namespace
+
+TEST(ConstrainedVector, default_ctor) // NOLINT
+{
+    two_digit_vector v;
+    ASSERT_TRUE(v.empty());
+    ASSERT_EQ(0, v.size());
+}
+
+TEST(ConstrainedVector, initializer_list) // NOLINT
+{
+    two_digit_vector v{10, 20, 99};
+    ASSERT_EQ(3, v.size());
+    ASSERT_EQ(10, v[0]);
+    ASSERT_EQ(99, v.at(2));
+}
+
+TEST(ConstrainedVector, bad_initializer_list) // NOLINT
+{
+    try
+    {
+        two_digit_vector v{10, 20, 100};
+        FAIL();
+    }
+    catch(std::system_error const & se)
+    {
+        ASSERT_EQ(static_cast<int>(houseguest::bounded_value_error::above_max),
+                  se.code().value());
+    }
+}
+
+TEST(ConstrainedVector, append) // NOLINT
+{
+    std::vector<int> const values{11, 12, 13};
+    two_digit_vector v{10};
+    v.append(std::begin(values), std::end(values));
+    ASSERT_EQ(4, v.size());
+    ASSERT_EQ(13, v[3]);
+}
+
+TEST(ConstrainedVector, bad_append_unchanged) // NOLINT
+{
+    std::vector<int> const values{11, 9, 13};
+    two_digit_vector v{10, 20};
+    ASSERT_THROW(v.append(std::begin(values), std::end(values)), // NOLINT
+                 std::system_error);
+    ASSERT_EQ(2, v.size());
+    ASSERT_EQ(20, v[1]);
+}
+
+TEST(ConstrainedVector, assign) // NOLINT
+{
+    std::vector<int> const values{50, 60};
+    two_digit_vector v{10, 20, 30};
+    v.assign(std::begin(values), std::end(values));
+    ASSERT_EQ(2, v.size());
+    ASSERT_EQ(50, v[0]);
+}
+
+TEST(ConstrainedVector, clamped_append) // NOLINT
+{
+    std::vector<int> const values{0, 50, 1000};
+    clamped_vector v;
+    v.append(std::begin(values), std::end(values));
+    ASSERT_EQ(10, v[0]);
+    ASSERT_EQ(50, v[1]);
+    ASSERT_EQ(99, v[2]);
+}
+
+TEST(ConstrainedVector, push_back) // NOLINT
+{
+    two_digit_vector v;
+    v.push_back(42);
+    v.push_back(two_digit_vector::value_type{43});
+    ASSERT_EQ(2, v.size());
+    ASSERT_THROW(v.push_back(100), std::system_error); // NOLINT
+    ASSERT_EQ(2, v.size());
+}
+
+TEST(ConstrainedVector, set) // NOLINT
+{
+    two_digit_vector v{10, 20};
+    v.set(1, 30);
+    ASSERT_EQ(30, v[1]);
+    ASSERT_THROW(v.set(0, 5), std::system_error); // NOLINT
+    ASSERT_EQ(10, v[0]);
+}
+
+TEST(ConstrainedVector, transform) // NOLINT
+{
+    two_digit_vector v{10, 20, 30};
+    v.transform([](int value) { return value * 2; });
+    ASSERT_EQ(60, v[2]);
+}
+
+TEST(ConstrainedVector, bad_transform) // NOLINT
+{
+    two_digit_vector v{10, 20, 50};
+    ASSERT_THROW(v.transform([](int value) { return value * 2; }), // NOLINT
+                 std::system_error);
+    ASSERT_EQ((two_digit_vector{10, 20, 50}), v);
+}
+
+TEST(ConstrainedVector, throwing_transform) // NOLINT
+{
+    two_digit_vector v{10, 20, 50};
+    ASSERT_THROW(v.transform([](int value) { // NOLINT
+        if(value == 50)
+        {
+            throw std::runtime_error{"transform"};
+        }
+        return value + 1;
+    }),
+                 std::runtime_error);
+    ASSERT_EQ((two_digit_vector{10, 20, 50}), v);
+}
+
+TEST(ConstrainedVector, sort) // NOLINT
+{
+    two_digit_vector v{30, 10, 20};
+    v.sort();
+    ASSERT_EQ((two_digit_vector{10, 20, 30}), v);
+    v.sort([](int lhs, int rhs) { return lhs > rhs; });
+    ASSERT_EQ((two_digit_vector{30, 20, 10}), v);
+}
+
+TEST(ConstrainedVector, iterate) // NOLINT
+{
+    two_digit_vector v{10, 20, 30};
+    auto sum = 0;
+    for(auto value : v)
+    {
+        static_assert(std::is_same<decltype(value),
+                                   two_digit_vector::value_type>::value,
+                      "iterators should produce constrained values");
+        sum += value;
+    }
+    ASSERT_EQ(60, sum);
+    ASSERT_EQ(3, std::end(v) - std::begin(v));
+}
+
+TEST(ConstrainedVector, data) // NOLINT
+{
+    two_digit_vector v{10, 20, 30};
+    ASSERT_EQ(20, v.data()[1]);
+}
@@ -0,0 +1,134 @@
+#include <houseguest/double_buffered_object.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    // every element matches the first, unless a reader sees a partial write
+    struct frame
+    {
+        std::vector<std::size_t> values = std::vector<std::size_t>(256);
+
+        bool consistent() const
+        {
+            for(auto value : values)
+            {
+                if(value != values.front())
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+} // namespace
+
+TEST(DoubleBufferedObject, default_ctor) // NOLINT
+{
+    houseguest::double_buffered_object<std::vector<int>> dbv;
+    auto handle = dbv.read();
+    ASSERT_TRUE(handle->empty());
+    ASSERT_EQ(0, handle.version());
+    ASSERT_EQ(0, dbv.version());
+}
+
+TEST(DoubleBufferedObject, args_ctor) // NOLINT
+{
+    houseguest::double_buffered_object<std::vector<int>> dbv{10};
+    ASSERT_EQ(1, dbv.read()->size());
+}
+
+TEST(DoubleBufferedObject, publish) // NOLINT
+{
+    houseguest::double_buffered_object<int> dbi{1};
+    {
+        auto handle = dbi.write();
+        *handle = 2;
+        // nothing is visible until the handle is destroyed
+        ASSERT_EQ(1, *dbi.read());
+    }
+    ASSERT_EQ(2, *dbi.read());
+    ASSERT_EQ(1, dbi.read().version());
+}
+
+TEST(DoubleBufferedObject, reader_keeps_buffer) // NOLINT
+{
+    houseguest::double_buffered_object<int> dbi{0};
+    auto old = dbi.read();
+    for(int i = 1; i <= 10; ++i)
+    {
+        auto handle = dbi.write();
+        *handle = i;
+    }
+    ASSERT_EQ(0, *old);
+    ASSERT_EQ(0, old.version());
+    ASSERT_EQ(10, *dbi.read());
+    ASSERT_EQ(10, dbi.version());
+}
+
+TEST(DoubleBufferedObject, try_write) // NOLINT
+{
+    houseguest::double_buffered_object<int, 2> dbi{0};
+    {
+        auto old = dbi.read();
+        auto handle = dbi.write();
+        *handle = 1;
+    }
+
+    // the only back buffer is held by a reader
+    auto old = dbi.read();
+    {
+        auto handle = dbi.write();
+        *handle = 2;
+    }
+    auto const held = dbi.read();
+    ASSERT_FALSE(dbi.try_write());
+    ASSERT_EQ(1, *old);
+    ASSERT_EQ(2, *held);
+}
+
+TEST(DoubleBufferedObject, multi_thread) // NOLINT
+{
+    houseguest::double_buffered_object<frame> dbf;
+    std::atomic<bool> done{false};
+    std::atomic<bool> failed{false};
+
+    std::vector<std::thread> readers;
+    for(int i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&dbf, &done, &failed]() {
+            std::size_t last = 0;
+            while(!done)
+            {
+                auto handle = dbf.read();
+                if(!handle->consistent() || handle->values.front() < last)
+                {
+                    failed = true;
+                }
+                last = handle->values.front();
+            }
+        });
+    }
+
+    for(std::size_t version = 1; version <= 10000; ++version)
+    {
+        auto handle = dbf.write();
+        for(auto & value : handle->values)
+        {
+            value = version;
+        }
+    }
+    done = true;
+    for(auto & reader : readers)
+    {
+        reader.join();
+    }
+
+    ASSERT_FALSE(failed.load());
+    ASSERT_EQ(10000, dbf.read()->values.front());
+}
@@ -0,0 +1,120 @@
+#include <houseguest/enumerated_value.hpp>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <houseguest/bounded_algorithm.hpp>
+#include <houseguest/validation_result.hpp>
+
+namespace
+{
+    // fits in a 64-bit mask
+    using opcode = houseguest::enumerated_value<int, 0x10, 0x12, 0x20, 0x4f>;
+
+    // needs a perfect hash
+    using port = houseguest::enumerated_value<unsigned short, 22, 80, 443,
+                                              8080, 8443, 5432, 6379>;
+
+    // spread out, but still hashed
+    using wide_set =
+        houseguest::one_of_validator<long, -1000000, 7, 12, 9999, 31337,
+                                     123456789, 2000000000>;
+
+    using opcode_validator = opcode::validator;
+    using port_validator = port::validator;
+
+    static_assert(opcode_validator::test(0x12) && !opcode_validator::test(0x11),
+                  "bitmask membership");
+    static_assert(port_validator::test(443) && !port_validator::test(444),
+                  "hashed membership");
+    static_assert(wide_set::test(31337) && wide_set::test(-1000000) &&
+                      !wide_set::test(8) && !wide_set::test(2000000001),
+                  "membership");
+
+    // the fallback for sets without a perfect hash
+    using sorted = houseguest::internal::sorted_set<int, 50, -3, 1000, 7>;
+    static_assert(sorted::test(-3) && sorted::test(50) && sorted::test(1000) &&
+                      !sorted::test(8) && !sorted::test(-1000) &&
+                      !sorted::test(1001),
+                  "sorted membership");
+
+    static_assert((opcode_validator::min == 0x10) &&
+                      (opcode_validator::max == 0x4f),
+                  "the range should cover the set");
+    static_assert(!houseguest::is_range_validator<opcode_validator>::value,
+                  "sets aren't ranges");
+    static_assert(
+        houseguest::is_validator_subset<
+            port_validator,
+            houseguest::exception_validator<unsigned short, 0, 9000>>::value,
+        "every port fits in [0, 9000]");
+    static_assert(sizeof(port) == sizeof(unsigned short),
+                  "one_of_validator shouldn't add storage");
+} // namespace
+
+TEST(EnumeratedValue, good) // NOLINT
+{
+    opcode o{0x20};
+    ASSERT_EQ(0x20, o);
+    port p{6379};
+    ASSERT_EQ(6379, p);
+}
+
+TEST(EnumeratedValue, bad) // NOLINT
+{
+    try
+    {
+        port p{6380};
+        FAIL();
+    }
+    catch(std::system_error const & se)
+    {
+        ASSERT_EQ(houseguest::constraint_error::not_member, se.code());
+    }
+    ASSERT_THROW(opcode{0x11}, std::system_error); // NOLINT
+    ASSERT_THROW(opcode{0}, std::system_error);    // NOLINT
+    ASSERT_THROW(opcode{0x1000}, std::system_error); // NOLINT
+}
+
+TEST(EnumeratedValue, every_value) // NOLINT
+{
+    std::vector<long> const members{-1000000, 7,         12,        9999,
+                                    31337,    123456789, 2000000000};
+    for(auto value = -100L; value < 10000; ++value)
+    {
+        auto const expected =
+            std::find(std::begin(members), std::end(members), value) !=
+            std::end(members);
+        ASSERT_EQ(expected, wide_set::test(value)) << value;
+    }
+    for(auto value : members)
+    {
+        ASSERT_TRUE(wide_set::test(value));
+    }
+}
+
+TEST(EnumeratedValue, try_make) // NOLINT
+{
+    ASSERT_TRUE(houseguest::try_make<port>(22));
+    ASSERT_EQ(houseguest::constraint_error::not_member,
+              houseguest::try_make<port>(23).error());
+}
+
+TEST(EnumeratedValue, convert) // NOLINT
+{
+    port const p{8080};
+    houseguest::bounded_value<unsigned short, 0, 9000> const bounded{p};
+    ASSERT_EQ(8080, bounded);
+}
+
+TEST(EnumeratedValue, validate_all) // NOLINT
+{
+    std::vector<unsigned short> values(100, 443);
+    ASSERT_EQ(std::end(values), houseguest::validate_all<port_validator>(
+                                    std::begin(values), std::end(values)));
+    values[70] = 444;
+    ASSERT_EQ(std::begin(values) + 70,
+              houseguest::validate_all<port_validator>(std::begin(values),
+                                                       std::end(values)));
+}
@@ -0,0 +1,447 @@
+#ifndef HOUSEGUEST_ATOMIC_BOUNDED_VALUE_HPP
+#define HOUSEGUEST_ATOMIC_BOUNDED_VALUE_HPP 1
+
+#include <atomic>
+#include <exception>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <houseguest/bounded_value.hpp>
+#include <houseguest/constrained_value.hpp>
+#include <houseguest/validation_result.hpp>
+
+/** \file
+ *
+ * \brief Lock-free bounded counters
+ *
+ * Enforcing a range on a shared counter doesn't need a mutex: each update
+ * computes the new value from the current one, checks it against the range,
+ * and publishes it with a compare-and-swap, retrying if another thread got
+ * there first.
+ */
+
+namespace houseguest
+{
+    namespace internal
+    {
+        /// \brief the result of moving a value within a range
+        template <typename T>
+        struct range_step
+        {
+            T value;
+            bounded_value_error error;
+        };
+
+        /** \brief move \a value up or down by \a distance, staying within a
+         *         validator's range
+         *
+         * \tparam VALIDATOR a type derived from bounded_validator
+         *
+         * \param value    the starting value, which must be in range
+         * \param distance how far to move
+         * \param up       true to move toward max, false to move toward min
+         *
+         * \return The new value, or the bound that was crossed and an error
+         *         if the new value would be out of range.  Overflow of
+         *         VALIDATOR::type is impossible.
+         */
+        template <typename VALIDATOR>
+        constexpr range_step<typename VALIDATOR::type>
+        step_within(typename VALIDATOR::type value,
+                    std::make_unsigned_t<typename VALIDATOR::type> distance,
+                    bool up) noexcept
+        {
+            using value_type = typename VALIDATOR::type;
+            using unsigned_type = std::make_unsigned_t<value_type>;
+
+            auto const offset = range_offset<VALIDATOR>(value);
+            return up ? ((distance > range_span<VALIDATOR>() - offset)
+                             ? range_step<value_type>{
+                                   VALIDATOR::max,
+                                   bounded_value_error::above_max}
+                             : range_step<value_type>{
+                                   static_cast<value_type>(
+                                       static_cast<unsigned_type>(
+                                           static_cast<unsigned_type>(value) +
+                                           distance)),
+                                   bounded_value_error::success})
+                      : ((distance > offset)
+                             ? range_step<value_type>{
+                                   VALIDATOR::min,
+                                   bounded_value_error::below_min}
+                             : range_step<value_type>{
+                                   static_cast<value_type>(
+                                       static_cast<unsigned_type>(
+                                           static_cast<unsigned_type>(value) -
+                                           distance)),
+                                   bounded_value_error::success});
+        }
+
+        // validators that can't throw have nowhere to report the error...
+        template <typename VALIDATOR, typename T>
+        T reject_step(range_step<T> const & step, std::true_type) noexcept
+        {
+            std::terminate();
+            return step.value;
+        }
+
+        // ...and the rest throw, like exception_validator
+        template <typename VALIDATOR, typename T>
+        T reject_step(range_step<T> const & step, std::false_type)
+        {
+            throw std::system_error{make_bounded_value_error_code(step.error)};
+        }
+
+        /** \brief report a step that left a validator's range the way the
+         *         validator reports out-of-range values
+         *
+         * The validator is passed a value just past the bound that was
+         * crossed.  If that bound is also a limit of VALIDATOR::type, there's
+         * no such value, so validators that can't throw (e.g.,
+         * checked_validator) terminate and the rest throw std::system_error.
+         *
+         * \tparam VALIDATOR a validator that rejects out-of-range values
+         */
+        template <typename VALIDATOR, typename T>
+        T reject_step(range_step<T> const & step)
+        {
+            using unsigned_type = std::make_unsigned_t<T>;
+            using limits = std::numeric_limits<T>;
+
+            if((step.error == bounded_value_error::below_min) &&
+               (VALIDATOR::min != limits::min()))
+            {
+                return VALIDATOR{}(static_cast<T>(static_cast<unsigned_type>(
+                    static_cast<unsigned_type>(VALIDATOR::min) - 1U)));
+            }
+            if((step.error == bounded_value_error::above_max) &&
+               (VALIDATOR::max != limits::max()))
+            {
+                return VALIDATOR{}(static_cast<T>(static_cast<unsigned_type>(
+                    static_cast<unsigned_type>(VALIDATOR::max) + 1U)));
+            }
+            return reject_step<VALIDATOR>(
+                step, std::integral_constant<bool, noexcept(VALIDATOR{}(
+                                                       std::declval<T>()))>{});
+        }
+    } // namespace internal
+
+    /** \brief a constrained_value that can be updated from multiple threads
+     *         without locking
+     *
+     * Every update is validated against the range before it's published, so
+     * other threads never observe an out-of-range value.  What happens when
+     * an update would leave the range depends on the validator:
+     * - validators with a check function reject the update, reporting it
+     *   the way the validator reports out-of-range values, and leave the
+     *   value unchanged.  With exception_validator, fetch_add, fetch_sub,
+     *   and store throw std::system_error with a bounded_value_error;
+     *   checked_validator terminates.
+     * - clamping_validator saturates at the bound that was crossed.
+     *
+     * try_add, try_increment, and friends never clamp or throw: they either
+     * apply the entire update or report that it would leave the range, which
+     * makes them suitable for admission control (e.g., limiting in-flight
+     * requests).
+     *
+     * Memory ordering arguments have the same meaning as for std::atomic.
+     *
+     * \tparam T         the integral type to operate on
+     * \tparam VALIDATOR exception_validator, checked_validator, or
+     *                   clamping_validator
+     */
+    template <typename T, typename VALIDATOR>
+    class atomic_constrained_value
+    {
+        static_assert(is_range_validator<VALIDATOR>::value,
+                      "Atomic updates require a range validator");
+        static_assert(internal::has_check<VALIDATOR, T>::value ||
+                          internal::clamps<VALIDATOR>::value,
+                      "The validator must either reject or clamp values");
+
+    public:
+        /// \brief the constrained_value type being managed
+        using value_type = constrained_value<T, VALIDATOR>;
+
+        /// \brief the integral type being managed
+        using underlying_type = T;
+
+        /// \brief the validator type
+        using validator = VALIDATOR;
+
+        /** \brief construct an atomic_constrained_value
+         *
+         * \param value the initial value
+         */
+        explicit constexpr atomic_constrained_value(value_type value) noexcept
+          : _value{static_cast<T>(value)}
+        {
+        }
+
+        /** \brief construct an atomic_constrained_value from a raw value
+         *
+         * \param value the initial value.  \a value will be passed through
+         *              VALIDATOR prior to being stored.
+         */
+        explicit atomic_constrained_value(T value)
+          : _value{VALIDATOR{}(std::move(value))}
+        {
+        }
+
+        /// \cond false
+        atomic_constrained_value(atomic_constrained_value const &) = delete;
+        atomic_constrained_value &
+        operator=(atomic_constrained_value const &) = delete;
+        /// \endcond
+
+        /// \brief determine if updates are lock-free on this platform
+        bool is_lock_free() const noexcept
+        {
+            return _value.is_lock_free();
+        }
+
+        /// \brief get the current value
+        value_type load(std::memory_order order =
+                            std::memory_order_seq_cst) const noexcept
+        {
+            return value_type{internal::prevalidated, _value.load(order)};
+        }
+
+        /// \brief get the current value
+        operator value_type() const noexcept
+        {
+            return load();
+        }
+
+        /// \brief replace the current value
+        void store(value_type value, std::memory_order order =
+                                         std::memory_order_seq_cst) noexcept
+        {
+            _value.store(static_cast<T>(value), order);
+        }
+
+        /** \brief replace the current value with a raw value
+         *
+         * \param value the new value.  \a value will be passed through
+         *              VALIDATOR prior to being stored.
+         * \param order the memory ordering for the store
+         */
+        void store(T value,
+                   std::memory_order order = std::memory_order_seq_cst)
+        {
+            _value.store(VALIDATOR{}(std::move(value)), order);
+        }
+
+        /// \brief replace the current value, returning the previous one
+        value_type exchange(value_type value,
+                            std::memory_order order =
+                                std::memory_order_seq_cst) noexcept
+        {
+            return value_type{internal::prevalidated,
+                              _value.exchange(static_cast<T>(value), order)};
+        }
+
+        /** \brief replace the current value if it equals \a expected
+         *
+         * \param expected the value to compare against.  If the current
+         *                 value is different, it's stored here.
+         * \param desired  the value to store
+         * \param order    the memory ordering for the exchange
+         *
+         * \retval true  the value was replaced
+         * \retval false the current value didn't equal \a expected
+         */
+        bool compare_exchange_strong(value_type & expected, value_type desired,
+                                     std::memory_order order =
+                                         std::memory_order_seq_cst) noexcept
+        {
+            auto current = static_cast<T>(expected);
+            auto const exchanged = _value.compare_exchange_strong(
+                current, static_cast<T>(desired), order);
+            expected = value_type{internal::prevalidated, current};
+            return exchanged;
+        }
+
+        /** \brief add to the current value
+         *
+         * \param delta the amount to add (which may be negative)
+         * \param order the memory ordering for the update
+         *
+         * \return The previous value
+         *
+         * \throw std::system_error if the result would be out of range and
+         *                          the validator throws for out-of-range
+         *                          values.  The value is unchanged.
+         */
+        value_type fetch_add(T delta, std::memory_order order =
+                                          std::memory_order_seq_cst)
+        {
+            return update(distance_of(delta), !internal::cmp_less(delta, 0),
+                          order);
+        }
+
+        /** \brief subtract from the current value
+         *
+         * \param delta the amount to subtract (which may be negative)
+         * \param order the memory ordering for the update
+         *
+         * \return The previous value
+         *
+         * \throw std::system_error if the result would be out of range and
+         *                          the validator throws for out-of-range
+         *                          values.  The value is unchanged.
+         */
+        value_type fetch_sub(T delta, std::memory_order order =
+                                          std::memory_order_seq_cst)
+        {
+            return update(distance_of(delta), internal::cmp_less(delta, 0),
+                          order);
+        }
+
+        /** \brief add to the current value only if the result is in range
+         *
+         * This never clamps or throws, regardless of the validator.
+         *
+         * \param delta the amount to add (which may be negative)
+         * \param order the memory ordering for a successful update
+         *
+         * \retval true  \a delta was added
+         * \retval false the result would have been out of range, so the value
+         *               is unchanged
+         */
+        bool try_add(T delta, std::memory_order order =
+                                 std::memory_order_seq_cst) noexcept
+        {
+            return try_update(distance_of(delta),
+                              !internal::cmp_less(delta, 0), order);
+        }
+
+        /** \brief subtract from the current value only if the result is in
+         *         range
+         *
+         * \see try_add
+         */
+        bool try_sub(T delta, std::memory_order order =
+                                 std::memory_order_seq_cst) noexcept
+        {
+            return try_update(distance_of(delta), internal::cmp_less(delta, 0),
+                              order);
+        }
+
+        /** \brief add one to the current value if it's less-than max
+         *
+         * \retval true  the value was incremented (e.g., a slot was acquired)
+         * \retval false the value was already at max
+         */
+        bool try_increment(
+            std::memory_order order = std::memory_order_seq_cst) noexcept
+        {
+            return try_update(1, true, order);
+        }
+
+        /** \brief subtract one from the current value if it's greater-than
+         *         min
+         *
+         * \retval true  the value was decremented
+         * \retval false the value was already at min
+         */
+        bool try_decrement(
+            std::memory_order order = std::memory_order_seq_cst) noexcept
+        {
+            return try_update(1, false, order);
+        }
+
+    private:
+        using distance_type = std::make_unsigned_t<T>;
+
+        static constexpr distance_type distance_of(T delta) noexcept
+        {
+            return internal::cmp_less(delta, 0)
+                       ? static_cast<distance_type>(
+                             distance_type{0} -
+                             static_cast<distance_type>(delta))
+                       : static_cast<distance_type>(delta);
+        }
+
+        // validators that reject values report a failed step...
+        static T resolve(internal::range_step<T> const & step, std::true_type)
+        {
+            if(step.error != bounded_value_error::success)
+            {
+                return internal::reject_step<VALIDATOR>(step);
+            }
+            return step.value;
+        }
+
+        // ...and clamping validators keep the bound that was crossed
+        static T resolve(internal::range_step<T> const & step,
+                         std::false_type) noexcept
+        {
+            return step.value;
+        }
+
+        value_type update(distance_type distance, bool up,
+                          std::memory_order order)
+        {
+            auto current = _value.load(std::memory_order_relaxed);
+            T next;
+            do
+            {
+                next = resolve(
+                    internal::step_within<VALIDATOR>(current, distance, up),
+                    internal::has_check<VALIDATOR, T>{});
+            } while(!_value.compare_exchange_weak(current, next, order,
+                                                  std::memory_order_relaxed));
+            return value_type{internal::prevalidated, current};
+        }
+
+        bool try_update(distance_type distance, bool up,
+                        std::memory_order order) noexcept
+        {
+            auto current = _value.load(std::memory_order_relaxed);
+            internal::range_step<T> step{};
+            do
+            {
+                step = internal::step_within<VALIDATOR>(current, distance, up);
+                if(step.error != bounded_value_error::success)
+                {
+                    return false;
+                }
+            } while(!_value.compare_exchange_weak(current, step.value, order,
+                                                  std::memory_order_relaxed));
+            return true;
+        }
+
+        std::atomic<T> _value;
+    };
+
+    /** \brief a bounded_value that can be updated from multiple threads
+     *         without locking
+     *
+     * Updates that would leave the range throw and leave the value unchanged.
+     *
+     * \tparam T   the integral type to operate on
+     * \tparam MIN the minimum legal value
+     * \tparam MAX the maximum legal value
+     */
+    template <typename T, T MIN, T MAX>
+    using atomic_bounded_value =
+        atomic_constrained_value<T, exception_validator<T, MIN, MAX>>;
+
+    /** \brief a clamped_value that can be updated from multiple threads
+     *         without locking
+     *
+     * Updates that would leave the range saturate at MIN or MAX.
+     *
+     * \tparam T   the integral type to operate on
+     * \tparam MIN the minimum legal value
+     * \tparam MAX the maximum legal value
+     */
+    template <typename T, T MIN, T MAX>
+    using atomic_clamped_value =
+        atomic_constrained_value<T, clamping_validator<T, MIN, MAX>>;
+} // namespace houseguest
+
+#endif
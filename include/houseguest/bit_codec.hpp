@@ -0,0 +1,490 @@
+#ifndef HOUSEGUEST_BIT_CODEC_HPP
+#define HOUSEGUEST_BIT_CODEC_HPP 1
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <houseguest/bounded_algorithm.hpp>
+#include <houseguest/bounded_value.hpp>
+#include <houseguest/validation_result.hpp>
+
+/** \file
+ *
+ * \brief Bit-packed serialization of bounded values
+ *
+ * A value with a known range only needs enough bits to represent its distance
+ * from the minimum, so a bounded_value<int, 1000, 1100> can be written in 7
+ * bits instead of 32.  bit_encoder and bit_decoder stream values in this form
+ * to and from caller-provided byte buffers.  Values are written least
+ * significant bit first, and bytes are filled from their low bit up, so the
+ * format doesn't depend on the host's endianness.
+ *
+ * The stream doesn't record how many values it holds; callers are expected to
+ * track that themselves.
+ */
+
+namespace houseguest
+{
+    namespace internal
+    {
+        /// \brief the type used to accumulate bits
+        using bit_word = std::uint64_t;
+
+        /// \brief the number of bits in a bit_word
+        constexpr unsigned bit_word_bits =
+            std::numeric_limits<bit_word>::digits;
+
+        /// \brief get a mask with the lowest \a bits bits set
+        constexpr bit_word low_bits_mask(unsigned bits) noexcept
+        {
+            return (bits >= bit_word_bits) ? ~bit_word{0}
+                                           : ((bit_word{1} << bits) - 1);
+        }
+
+        /// \brief shift \a word right, allowing shifts of the full width
+        constexpr bit_word shift_down(bit_word word, unsigned bits) noexcept
+        {
+            return (bits >= bit_word_bits) ? 0 : (word >> bits);
+        }
+
+        /** \brief shared details of bit_encoder and bit_decoder
+         *
+         * \tparam CONSTRAINED a constrained_value whose validator has a range
+         */
+        template <typename CONSTRAINED>
+        struct bit_codec_traits
+        {
+            using validator = typename CONSTRAINED::validator;
+            using underlying_type = typename CONSTRAINED::underlying_type;
+            using offset_type = std::make_unsigned_t<underlying_type>;
+
+            static_assert(has_range<validator>::value,
+                          "Bit encoding requires a validator with a range");
+
+            static constexpr unsigned bits_per_value =
+                bits_required(range_span<validator>());
+
+            static constexpr bit_word value_mask =
+                low_bits_mask(bits_per_value);
+
+            // If the range fills every bit pattern, no decoded value can be
+            // out of range.
+            static constexpr bool exact =
+                (value_mask == range_span<validator>());
+
+            // A value just outside the range, used to let the validator
+            // decide how to handle corrupt input.  It's computed in the
+            // offset domain so full-range types (where it's never used)
+            // don't overflow.
+            static constexpr underlying_type overflow_value =
+                static_cast<underlying_type>(
+                    (validator::max <
+                     std::numeric_limits<underlying_type>::max())
+                        ? static_cast<offset_type>(
+                              static_cast<offset_type>(validator::max) + 1U)
+                        : static_cast<offset_type>(
+                              static_cast<offset_type>(validator::min) - 1U));
+        };
+    } // namespace internal
+
+    /** \brief write bounded values to a byte buffer using as few bits as
+     *         possible
+     *
+     * Each value is written as its distance from the validator's minimum
+     * using exactly bits_per_value bits.  Values may straddle byte
+     * boundaries; flush must be called after the last value to write any
+     * partially-filled byte.
+     *
+     * \tparam CONSTRAINED the constrained_value type being written (e.g.,
+     *                     bounded_value or clamped_value).  The validator must
+     *                     be derived from bounded_validator and default
+     *                     constructible.
+     */
+    template <typename CONSTRAINED>
+    class bit_encoder
+    {
+        using traits = internal::bit_codec_traits<CONSTRAINED>;
+        using validator_type = typename traits::validator;
+
+    public:
+        /// \brief the constrained_value type being written
+        using value_type = CONSTRAINED;
+
+        /// \brief the integral type being written
+        using underlying_type = typename traits::underlying_type;
+
+        /// \brief the type used for sizes
+        using size_type = std::size_t;
+
+        /// \brief the number of bits written for each value
+        static constexpr unsigned bits_per_value = traits::bits_per_value;
+
+        /// \brief get the number of bytes needed to write \a count values
+        static constexpr size_type bytes_required(size_type count) noexcept
+        {
+            return ((count * bits_per_value) + 7) / 8;
+        }
+
+        /** \brief construct a bit_encoder
+         *
+         * \param buffer where to write values
+         * \param size   the number of bytes available in \a buffer
+         */
+        bit_encoder(unsigned char * buffer, size_type size) noexcept
+          : _buffer{buffer}
+          , _size{size}
+        {
+        }
+
+        /** \brief write a value
+         *
+         * \throw std::length_error if there isn't room for another value
+         */
+        void encode(value_type const & value)
+        {
+            reserve(1);
+            put(static_cast<underlying_type>(value));
+        }
+
+        /** \brief write a raw value
+         *
+         * \param value the value to write.  \a value will be passed through
+         *              the validator prior to being written.
+         *
+         * \throw std::length_error if there isn't room for another value
+         */
+        void encode(underlying_type value)
+        {
+            reserve(1);
+            validator_type validator{};
+            put(validator(std::move(value)));
+        }
+
+        /** \brief write a range of raw values
+         *
+         * Values are validated in fixed-size blocks using the same bulk
+         * operations as bounded_algorithm.hpp, then written.  If a value is
+         * rejected, the exception is thrown after every block before it has
+         * been written.
+         *
+         * \param first the beginning of the values to write
+         * \param last  the end of the values to write
+         *
+         * \throw std::length_error if a block doesn't fit in the buffer.
+         *                          Nothing from that block will be written.
+         */
+        template <typename ITERATOR>
+        void encode(ITERATOR first, ITERATOR last)
+        {
+            std::array<underlying_type, internal::bulk_block_size> block;
+            validator_type validator{};
+            while(first != last)
+            {
+                size_type count = 0;
+                for(; (first != last) && (count < block.size());
+                    ++first, ++count)
+                {
+                    block[count] = *first;
+                }
+                auto const block_end =
+                    std::begin(block) + static_cast<std::ptrdiff_t>(count);
+                internal::bulk_apply(validator, std::begin(block), block_end);
+                reserve(count);
+                for(auto it = std::begin(block); it != block_end; ++it)
+                {
+                    put(*it);
+                }
+            }
+        }
+
+        /** \brief write any partially-filled byte
+         *
+         * Unused bits in the final byte are set to zero.  Values written
+         * after a flush start at the next byte.
+         *
+         * \return The total number of bytes written to the buffer
+         */
+        size_type flush() noexcept
+        {
+            if(_pending != 0)
+            {
+                _buffer[_written++] = static_cast<unsigned char>(_accumulator);
+                _accumulator = 0;
+                _pending = 0;
+            }
+            return _written;
+        }
+
+        /// \brief get the number of values that can still be written
+        size_type remaining() const noexcept
+        {
+            return (bits_per_value == 0)
+                       ? std::numeric_limits<size_type>::max()
+                       : (((_size - _written) * 8) - _pending) /
+                             bits_per_value;
+        }
+
+    private:
+        void reserve(size_type count) const
+        {
+            if(remaining() < count)
+            {
+                throw std::length_error{"bit_encoder buffer"};
+            }
+        }
+
+        void put(underlying_type value) noexcept
+        {
+            using internal::bit_word_bits;
+
+            auto const offset = static_cast<internal::bit_word>(
+                internal::range_offset<validator_type>(value));
+            _accumulator |= offset << _pending;
+            // bits that didn't fit in the accumulator (the two-step shift is
+            // well-defined when nothing is pending)
+            auto carry = (offset >> 1) >> (bit_word_bits - 1 - _pending);
+            auto bits = _pending + bits_per_value;
+            while(bits >= 8)
+            {
+                _buffer[_written++] = static_cast<unsigned char>(_accumulator);
+                _accumulator =
+                    (_accumulator >> 8) | (carry << (bit_word_bits - 8));
+                carry >>= 8;
+                bits -= 8;
+            }
+            _pending = bits;
+        }
+
+        unsigned char * _buffer;
+        size_type _size;
+        size_type _written = 0;
+        internal::bit_word _accumulator = 0;
+        unsigned _pending = 0;
+    };
+
+    /** \brief read bounded values written by bit_encoder
+     *
+     * Decoded values are produced directly as CONSTRAINED without running the
+     * validator.  The only values that can be out of range are bit patterns
+     * past the validator's span (which can only appear in corrupt input);
+     * those are detected with a single compare and passed to the validator as
+     * a value just outside its range, so a bounded_value throws and a
+     * clamped_value clamps.  A checked_value has nowhere to report the
+     * problem, so decode terminates the program; use try_decode to read
+     * untrusted input instead.  When the span fills every bit pattern (e.g.,
+     * a range of [0, 255]), the check is omitted entirely.  Validators that
+     * aren't range validators (see is_range_validator) are still run on every
+     * decoded value.
+     *
+     * \tparam CONSTRAINED the constrained_value type being read.  This must
+     *                     have the same range as the type that was written.
+     */
+    template <typename CONSTRAINED>
+    class bit_decoder
+    {
+        using traits = internal::bit_codec_traits<CONSTRAINED>;
+        using validator_type = typename traits::validator;
+
+    public:
+        /// \brief the constrained_value type being read
+        using value_type = CONSTRAINED;
+
+        /// \brief the integral type being read
+        using underlying_type = typename traits::underlying_type;
+
+        /// \brief the type used for sizes
+        using size_type = std::size_t;
+
+        /// \brief the number of bits read for each value
+        static constexpr unsigned bits_per_value = traits::bits_per_value;
+
+        /** \brief construct a bit_decoder
+         *
+         * \param buffer the encoded values
+         * \param size   the number of bytes in \a buffer
+         */
+        bit_decoder(unsigned char const * buffer, size_type size) noexcept
+          : _buffer{buffer}
+          , _size{size}
+        {
+        }
+
+        /** \brief read a value
+         *
+         * \throw std::length_error if the buffer has been exhausted
+         */
+        value_type decode()
+        {
+            reserve(1);
+            return make_value(get());
+        }
+
+        /** \brief read a value without throwing
+         *
+         * \return The value read, or an error explaining why it couldn't be
+         *         read:
+         *         - std::errc::no_message_available if the buffer has been
+         *           exhausted.  Nothing is read.
+         *         - bounded_value_error::below_min or
+         *           bounded_value_error::above_max if the input is corrupt.
+         *           The corrupt value is skipped, whatever the validator.
+         *         - any error reported by the validator's check function, for
+         *           validators that aren't range validators
+         */
+        validation_result<value_type> try_decode()
+        {
+            if(remaining() < 1)
+            {
+                return validation_result<value_type>{
+                    std::make_error_code(std::errc::no_message_available)};
+            }
+            return try_make_value(get());
+        }
+
+        /** \brief read several values
+         *
+         * \param count the number of values to read
+         * \param out   where to write the values
+         *
+         * \return \a out advanced past the last value written
+         *
+         * \throw std::length_error if the buffer doesn't contain \a count
+         *                          values.  Nothing will be read.
+         */
+        template <typename OUTPUT>
+        OUTPUT decode(size_type count, OUTPUT out)
+        {
+            reserve(count);
+            for(size_type i = 0; i < count; ++i)
+            {
+                *out = make_value(get());
+                ++out;
+            }
+            return out;
+        }
+
+        /** \brief get the number of values that can still be read
+         *
+         * \note Since the final byte may be padded, this can include up to
+         *       seven bits that were never written.
+         */
+        size_type remaining() const noexcept
+        {
+            return (bits_per_value == 0)
+                       ? std::numeric_limits<size_type>::max()
+                       : (((_size - _read) * 8) + _available) /
+                             bits_per_value;
+        }
+
+    private:
+        void reserve(size_type count) const
+        {
+            if(remaining() < count)
+            {
+                throw std::length_error{"bit_decoder buffer"};
+            }
+        }
+
+        internal::bit_word get() noexcept
+        {
+            using internal::bit_word;
+            using internal::bit_word_bits;
+
+            while((_available < bits_per_value) &&
+                  (_available <= bit_word_bits - 8))
+            {
+                _accumulator |= bit_word{_buffer[_read++]} << _available;
+                _available += 8;
+            }
+            if(_available >= bits_per_value)
+            {
+                auto const offset = _accumulator & traits::value_mask;
+                _accumulator =
+                    internal::shift_down(_accumulator, bits_per_value);
+                _available -= bits_per_value;
+                return offset;
+            }
+
+            // Only values wider than 56 bits get here; the last few bits are
+            // in the next byte.
+            auto const next = bit_word{_buffer[_read++]};
+            auto const used = bits_per_value - _available;
+            auto const offset =
+                (_accumulator | (next << _available)) & traits::value_mask;
+            _accumulator = next >> used;
+            _available = 8 - used;
+            return offset;
+        }
+
+        value_type make_value(internal::bit_word offset) const
+        {
+            if(!traits::exact && (offset > range_span()))
+            {
+                validator_type validator{};
+                return value_type{internal::prevalidated,
+                                  validator(traits::overflow_value)};
+            }
+            auto const value = internal::from_range_offset<validator_type>(
+                static_cast<typename traits::offset_type>(offset));
+            if(!is_range_validator<validator_type>::value)
+            {
+                // the range doesn't capture every constraint (e.g., all_of)
+                validator_type validator{};
+                return value_type{internal::prevalidated, validator(value)};
+            }
+            return value_type{internal::prevalidated, value};
+        }
+
+        validation_result<value_type>
+        try_make_value(internal::bit_word offset) const
+        {
+            if(!traits::exact && (offset > range_span()))
+            {
+                return validation_result<value_type>{
+                    internal::make_bounded_value_error_code(
+                        internal::cmp_less(validator_type::max,
+                                           traits::overflow_value)
+                            ? bounded_value_error::above_max
+                            : bounded_value_error::below_min)};
+            }
+            auto const value = internal::from_range_offset<validator_type>(
+                static_cast<typename traits::offset_type>(offset));
+            if(!is_range_validator<validator_type>::value)
+            {
+                return internal::try_make<value_type>(
+                    value,
+                    internal::has_check<validator_type, underlying_type>{});
+            }
+            return value_type{internal::prevalidated, value};
+        }
+
+        static constexpr internal::bit_word range_span() noexcept
+        {
+            return internal::range_span<validator_type>();
+        }
+
+        unsigned char const * _buffer;
+        size_type _size;
+        size_type _read = 0;
+        internal::bit_word _accumulator = 0;
+        unsigned _available = 0;
+    };
+
+#if __cplusplus < 201703L
+    /// \cond false
+    template <typename CONSTRAINED>
+    constexpr unsigned bit_encoder<CONSTRAINED>::bits_per_value;
+
+    template <typename CONSTRAINED>
+    constexpr unsigned bit_decoder<CONSTRAINED>::bits_per_value;
+    /// \endcond
+#endif
+} // namespace houseguest
+
+#endif
@@ -0,0 +1,350 @@
+#ifndef HOUSEGUEST_BOUNDED_ALGORITHM_HPP
+#define HOUSEGUEST_BOUNDED_ALGORITHM_HPP 1
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include <houseguest/bounded_value.hpp>
+
+/** \file
+ *
+ * \brief Bulk operations over ranges of values destined for bounded types
+ *
+ * Validating values one at a time through a constrained_value's constructor
+ * puts a potential throw between every element, which keeps compilers from
+ * vectorizing the loop.  The functions here check or clamp entire ranges using
+ * branch-free comparisons instead, so the hot loops reduce to min/max and
+ * compare instructions on any target the compiler is allowed to vectorize for.
+ */
+
+namespace houseguest
+{
+    namespace internal
+    {
+        /// \brief the number of values checked between early-exit tests
+        constexpr std::size_t bulk_block_size = 64;
+
+        /** \brief determine if \a value falls outside a validator's range
+         *
+         * \tparam VALIDATOR a type derived from bounded_validator
+         *
+         * \param value the value to test
+         *
+         * \retval true  \a value is less-than min or greater-than max
+         * \retval false \a value is between min and max
+         */
+        template <typename VALIDATOR>
+        constexpr bool out_of_range(typename VALIDATOR::type value) noexcept
+        {
+            // A single unsigned compare covers both bounds, since anything
+            // below min wraps around to a huge value.
+            return range_offset<VALIDATOR>(value) > range_span<VALIDATOR>();
+        }
+
+        /** \brief clamp \a value to a validator's range without branching
+         *
+         * \tparam VALIDATOR a type derived from bounded_validator
+         *
+         * \param value the value to clamp
+         */
+        template <typename VALIDATOR>
+        constexpr typename VALIDATOR::type
+        clamp_to_range(typename VALIDATOR::type value) noexcept
+        {
+            auto const lower =
+                (value < VALIDATOR::min) ? VALIDATOR::min : value;
+            return (lower > VALIDATOR::max) ? VALIDATOR::max : lower;
+        }
+
+        template <typename VALIDATOR>
+        constexpr bool rejects(typename VALIDATOR::type value,
+                               std::true_type) noexcept
+        {
+            return !VALIDATOR::test(value);
+        }
+
+        template <typename VALIDATOR>
+        constexpr bool rejects(typename VALIDATOR::type value,
+                               std::false_type) noexcept
+        {
+            return out_of_range<VALIDATOR>(value);
+        }
+
+        /** \brief determine if a validator would reject \a value
+         *
+         * Validators with a test function (see composite_validator.hpp) use
+         * it; otherwise, only the validator's range is considered.
+         *
+         * \tparam VALIDATOR a validator with a test function or a range
+         */
+        template <typename VALIDATOR>
+        constexpr bool rejects(typename VALIDATOR::type value) noexcept
+        {
+            return rejects<VALIDATOR>(value, has_test<VALIDATOR>{});
+        }
+
+        template <typename VALIDATOR, typename ITERATOR>
+        ITERATOR find_out_of_range(ITERATOR first, ITERATOR last,
+                                   std::input_iterator_tag)
+        {
+            return std::find_if(first, last, [](auto value) {
+                return rejects<VALIDATOR>(value);
+            });
+        }
+
+        template <typename VALIDATOR, typename ITERATOR>
+        ITERATOR find_out_of_range(ITERATOR first, ITERATOR last,
+                                   std::random_access_iterator_tag)
+        {
+            // Scan fixed-size blocks with no early exit so the inner loop
+            // vectorizes, then locate the exact position inside the first
+            // block that failed (if any).
+            constexpr auto block =
+                static_cast<typename std::iterator_traits<
+                    ITERATOR>::difference_type>(bulk_block_size);
+            while((last - first) >= block)
+            {
+                unsigned failed = 0;
+                for(auto i = decltype(block){0}; i < block; ++i)
+                {
+                    failed |= static_cast<unsigned>(
+                        rejects<VALIDATOR>(first[i]));
+                }
+                if(failed != 0)
+                {
+                    break;
+                }
+                first += block;
+            }
+            return find_out_of_range<VALIDATOR>(first, last,
+                                                std::input_iterator_tag{});
+        }
+
+        template <typename VALIDATOR, typename ITERATOR>
+        void bulk_apply(VALIDATOR & validator, ITERATOR first, ITERATOR last,
+                        std::true_type)
+        {
+            // test can't modify values, so only a rejected value needs to
+            // go through the validator (to throw)
+            auto const it = find_out_of_range<VALIDATOR>(
+                first, last,
+                typename std::iterator_traits<ITERATOR>::iterator_category{});
+            if(it != last)
+            {
+                validator(*it);
+            }
+        }
+
+        template <typename VALIDATOR, typename ITERATOR>
+        void bulk_apply(VALIDATOR & validator, ITERATOR first, ITERATOR last,
+                        std::false_type)
+        {
+            for(; first != last; ++first)
+            {
+                *first = validator(*first);
+            }
+        }
+
+        /** \brief pass every value in a range through \a validator
+         *
+         * This is the generic version.  Validators with a test function are
+         * checked in a single pass; anything else is called on each element
+         * and the result is stored.
+         */
+        template <typename VALIDATOR, typename ITERATOR>
+        void bulk_apply(VALIDATOR & validator, ITERATOR first, ITERATOR last)
+        {
+            bulk_apply(validator, first, last, has_test<VALIDATOR>{});
+        }
+
+        /** \brief check a range against an exception_validator
+         *
+         * The entire range is checked at once; if anything is out of range,
+         * the offending value is passed through \a validator so the same
+         * exception is thrown as if it had been validated on its own.
+         */
+        template <typename T, T MIN, T MAX, typename ITERATOR>
+        void bulk_apply(exception_validator<T, MIN, MAX> & validator,
+                        ITERATOR first, ITERATOR last)
+        {
+            using validator_type = exception_validator<T, MIN, MAX>;
+            auto const it = find_out_of_range<validator_type>(
+                first, last,
+                typename std::iterator_traits<ITERATOR>::iterator_category{});
+            if(it != last)
+            {
+                validator(*it);
+            }
+        }
+
+        /// \brief clamp a range using a clamping_validator
+        template <typename T, T MIN, T MAX, typename ITERATOR>
+        void bulk_apply(clamping_validator<T, MIN, MAX> & validator,
+                        ITERATOR first, ITERATOR last)
+        {
+            using validator_type = clamping_validator<T, MIN, MAX>;
+            (void)validator;
+            for(; first != last; ++first)
+            {
+                *first = clamp_to_range<validator_type>(*first);
+            }
+        }
+
+        template <typename CONSTRAINED, typename T, std::size_t N,
+                  std::size_t... Is>
+        constexpr std::array<CONSTRAINED, N>
+        make_prevalidated_array(std::array<T, N> const & values,
+                                std::index_sequence<Is...>)
+        {
+            return {{CONSTRAINED{prevalidated, values[Is]}...}};
+        }
+    } // namespace internal
+
+    /** \brief find the first value outside a validator's range
+     *
+     * \tparam VALIDATOR a type derived from bounded_validator (e.g.,
+     *                   exception_validator or clamping_validator).  Only the
+     *                   range is used; \a VALIDATOR is never invoked.
+     *                   Validators with a test function (see
+     *                   composite_validator.hpp) use that instead of a
+     *                   range.
+     * \tparam ITERATOR  an iterator over VALIDATOR::type values
+     *
+     * \param first the start of the range to check
+     * \param last  the end of the range to check
+     *
+     * \return An iterator to the first value less-than VALIDATOR::min or
+     *         greater-than VALIDATOR::max (or rejected by test), or \a last
+     *         if every value is in range.
+     */
+    template <typename VALIDATOR, typename ITERATOR>
+    ITERATOR validate_all(ITERATOR first, ITERATOR last)
+    {
+        return internal::find_out_of_range<VALIDATOR>(
+            first, last,
+            typename std::iterator_traits<ITERATOR>::iterator_category{});
+    }
+
+    /** \brief clamp every value in a range to a validator's range
+     *
+     * \tparam VALIDATOR a type derived from bounded_validator.  Only the range
+     *                   is used; \a VALIDATOR is never invoked.
+     * \tparam ITERATOR  a mutable iterator over VALIDATOR::type values
+     *
+     * \param first the start of the range to clamp
+     * \param last  the end of the range to clamp
+     */
+    template <typename VALIDATOR, typename ITERATOR>
+    void clamp_all(ITERATOR first, ITERATOR last)
+    {
+        for(; first != last; ++first)
+        {
+            *first = internal::clamp_to_range<VALIDATOR>(*first);
+        }
+    }
+
+    /** \brief add two ranges of values element by element, saturating at a
+     *         validator's range
+     *
+     * Each exact sum is clamped to [VALIDATOR::min, VALIDATOR::max], exactly
+     * like adding two clamped_values.  The loop has no branches, so when the
+     * range matches a narrow type's limits (e.g., int16_t's full range), the
+     * compiler can use saturating vector instructions.
+     *
+     * \tparam VALIDATOR a type derived from bounded_validator.  Only the range
+     *                   is used.
+     *
+     * \param first1 the beginning of the left-hand values
+     * \param last1  the end of the left-hand values
+     * \param first2 the beginning of the right-hand values
+     * \param out    where to write the results (which may be \a first1 or
+     *               \a first2)
+     *
+     * \return \a out advanced past the last result
+     */
+    template <typename VALIDATOR, typename INPUT1, typename INPUT2,
+              typename OUTPUT>
+    OUTPUT saturating_add_all(INPUT1 first1, INPUT1 last1, INPUT2 first2,
+                              OUTPUT out)
+    {
+        using value_type = typename VALIDATOR::type;
+        for(; first1 != last1; ++first1, ++first2, ++out)
+        {
+            *out = internal::saturating_add<value_type, VALIDATOR::min,
+                                            VALIDATOR::max>(*first1, *first2);
+        }
+        return out;
+    }
+
+    /** \brief subtract two ranges of values element by element, saturating
+     *         at a validator's range
+     *
+     * See saturating_add_all for details.
+     */
+    template <typename VALIDATOR, typename INPUT1, typename INPUT2,
+              typename OUTPUT>
+    OUTPUT saturating_subtract_all(INPUT1 first1, INPUT1 last1, INPUT2 first2,
+                                   OUTPUT out)
+    {
+        using value_type = typename VALIDATOR::type;
+        for(; first1 != last1; ++first1, ++first2, ++out)
+        {
+            *out = internal::saturating_subtract<
+                value_type, VALIDATOR::min, VALIDATOR::max>(*first1, *first2);
+        }
+        return out;
+    }
+
+    /** \brief multiply two ranges of values element by element, saturating
+     *         at a validator's range
+     *
+     * See saturating_add_all for details.
+     */
+    template <typename VALIDATOR, typename INPUT1, typename INPUT2,
+              typename OUTPUT>
+    OUTPUT saturating_multiply_all(INPUT1 first1, INPUT1 last1, INPUT2 first2,
+                                   OUTPUT out)
+    {
+        using value_type = typename VALIDATOR::type;
+        for(; first1 != last1; ++first1, ++first2, ++out)
+        {
+            *out = internal::saturating_multiply<
+                value_type, VALIDATOR::min, VALIDATOR::max>(*first1, *first2);
+        }
+        return out;
+    }
+
+    /** \brief build an array of constrained_values with a single validation
+     *         pass
+     *
+     * \tparam CONSTRAINED the constrained_value type to create
+     * \tparam N           the number of values
+     *
+     * \param values the raw values.  These are validated together according
+     *               to CONSTRAINED's validator (e.g., a bounded_value throws
+     *               for the first value out of range, a clamped_value clamps
+     *               everything) before any constrained_values are created.
+     *
+     * \return An array containing a CONSTRAINED for each value
+     */
+    template <typename CONSTRAINED, std::size_t N>
+    std::array<CONSTRAINED, N> make_bounded_array(
+        typename CONSTRAINED::underlying_type const (&values)[N])
+    {
+        using value_type = typename CONSTRAINED::underlying_type;
+
+        std::array<value_type, N> temp;
+        std::copy(std::begin(values), std::end(values), std::begin(temp));
+
+        typename CONSTRAINED::validator validator{};
+        internal::bulk_apply(validator, std::begin(temp), std::end(temp));
+        return internal::make_prevalidated_array<CONSTRAINED>(
+            temp, std::make_index_sequence<N>{});
+    }
+} // namespace houseguest
+
+#endif
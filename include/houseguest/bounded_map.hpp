@@ -0,0 +1,340 @@
+#ifndef HOUSEGUEST_BOUNDED_MAP_HPP
+#define HOUSEGUEST_BOUNDED_MAP_HPP 1
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <houseguest/bounded_set.hpp>
+#include <houseguest/constrained_value.hpp>
+
+/** \file
+ *
+ * \brief A map keyed by constrained_values stored as a flat array
+ */
+
+namespace houseguest
+{
+    /** \brief a map from constrained_values to values, stored as a flat
+     *         array indexed by key
+     *
+     * Every key a KEY can hold has a fixed slot, found by its distance from
+     * the validator's minimum, and a bounded_set records which slots are
+     * occupied.  Lookups are a single index with no hashing, probing, or
+     * allocation, and iteration visits keys in ascending order.  The storage
+     * is sized at compile time (one VALUE per possible key), so bounded_map
+     * is only appropriate for small ranges.
+     *
+     * Every slot holds a VALUE whether it's occupied or not, so VALUE must be
+     * default constructible.  Erased values are reset to VALUE{}.  If VALUE
+     * is a literal type, bounded_maps can be built at compile time.
+     *
+     * \tparam KEY   a constrained_value whose validator has a range (e.g.,
+     *               bounded_value)
+     * \tparam VALUE the type of mapped values
+     */
+    template <typename KEY, typename VALUE>
+    class bounded_map
+    {
+        using range = internal::key_range<KEY>;
+        using set_type = bounded_set<KEY>;
+
+        static_assert(std::is_default_constructible<VALUE>::value,
+                      "VALUE must be default constructible");
+
+    public:
+        /// \brief the type of keys
+        using key_type = KEY;
+
+        /// \brief the type of mapped values
+        using mapped_type = VALUE;
+
+        /// \brief the type used for sizes
+        using size_type = std::size_t;
+
+        /** \brief an iterator over the entries in the map, in ascending key
+         *         order
+         *
+         * Dereferencing produces an std::pair of the key and a reference to
+         * the mapped value.
+         *
+         * \tparam MAPPED VALUE or VALUE const
+         */
+        template <typename MAPPED>
+        class basic_iterator
+        {
+        public:
+            /// \cond false
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::pair<KEY, MAPPED &>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = value_type;
+
+            constexpr basic_iterator() noexcept = default;
+
+            // iterators convert to const_iterators
+            template <typename OTHER,
+                      typename = std::enable_if_t<
+                          std::is_same<OTHER const, MAPPED>::value &&
+                          !std::is_same<OTHER, MAPPED>::value>>
+            constexpr basic_iterator(
+                basic_iterator<OTHER> const & other) noexcept
+              : _position{other._position}
+              , _values{other._values}
+            {
+            }
+
+            constexpr value_type operator*() const noexcept
+            {
+                return value_type{*_position, _values[_position.index()]};
+            }
+
+            constexpr basic_iterator & operator++() noexcept
+            {
+                ++_position;
+                return *this;
+            }
+
+            constexpr basic_iterator operator++(int) noexcept
+            {
+                auto ret = *this;
+                ++_position;
+                return ret;
+            }
+
+            friend constexpr bool
+            operator==(basic_iterator const & lhs,
+                       basic_iterator const & rhs) noexcept
+            {
+                return lhs._position == rhs._position;
+            }
+
+            friend constexpr bool
+            operator!=(basic_iterator const & lhs,
+                       basic_iterator const & rhs) noexcept
+            {
+                return lhs._position != rhs._position;
+            }
+            /// \endcond
+
+        private:
+            friend class bounded_map;
+
+            template <typename>
+            friend class basic_iterator;
+
+            constexpr basic_iterator(
+                typename set_type::const_iterator position,
+                MAPPED * values) noexcept
+              : _position{position}
+              , _values{values}
+            {
+            }
+
+            typename set_type::const_iterator _position;
+            MAPPED * _values = nullptr;
+        };
+
+        /// \brief an iterator that allows modifying mapped values
+        using iterator = basic_iterator<VALUE>;
+
+        /// \brief an iterator that doesn't allow modifying mapped values
+        using const_iterator = basic_iterator<VALUE const>;
+
+        /// \brief the number of keys a bounded_map can hold
+        static constexpr size_type capacity = range::size;
+
+        /// \brief construct an empty bounded_map
+        constexpr bounded_map() = default;
+
+        /// \brief construct a bounded_map containing \a entries
+        constexpr bounded_map(
+            std::initializer_list<std::pair<KEY, VALUE>> entries)
+        {
+            for(auto const & entry : entries)
+            {
+                insert_or_assign(entry.first, entry.second);
+            }
+        }
+
+        /** \brief add an entry if \a key isn't already in the map
+         *
+         * \retval true  the entry was added
+         * \retval false \a key was already in the map, which is unchanged
+         */
+        template <typename ARG>
+        constexpr bool insert(KEY const & key, ARG && value)
+        {
+            auto const inserted = _occupied.insert(key);
+            if(inserted)
+            {
+                _values[range::index_of(key)] = std::forward<ARG>(value);
+            }
+            return inserted;
+        }
+
+        /** \brief add an entry or replace the existing value for \a key
+         *
+         * \retval true  the entry was added
+         * \retval false the existing value was replaced
+         */
+        template <typename ARG>
+        constexpr bool insert_or_assign(KEY const & key, ARG && value)
+        {
+            _values[range::index_of(key)] = std::forward<ARG>(value);
+            return _occupied.insert(key);
+        }
+
+        /** \brief remove an entry
+         *
+         * \return The number of entries removed (0 or 1)
+         */
+        constexpr size_type erase(KEY const & key)
+        {
+            auto const erased = _occupied.erase(key);
+            if(erased != 0)
+            {
+                _values[range::index_of(key)] = VALUE{};
+            }
+            return erased;
+        }
+
+        /** \brief access the value for \a key, adding a default-constructed
+         *         one if \a key isn't in the map
+         */
+        constexpr VALUE & operator[](KEY const & key) noexcept
+        {
+            _occupied.insert(key);
+            return _values[range::index_of(key)];
+        }
+
+        /** \brief access the value for \a key
+         *
+         * \throw std::out_of_range if \a key isn't in the map
+         */
+        constexpr VALUE & at(KEY const & key)
+        {
+            check(key);
+            return _values[range::index_of(key)];
+        }
+
+        /** \brief access the value for \a key
+         *
+         * \throw std::out_of_range if \a key isn't in the map
+         */
+        constexpr VALUE const & at(KEY const & key) const
+        {
+            check(key);
+            return _values[range::index_of(key)];
+        }
+
+        /// \brief determine if \a key is in the map
+        constexpr bool contains(KEY const & key) const noexcept
+        {
+            return _occupied.contains(key);
+        }
+
+        /// \brief get the number of entries for \a key (0 or 1)
+        constexpr size_type count(KEY const & key) const noexcept
+        {
+            return _occupied.count(key);
+        }
+
+        /** \brief find an entry
+         *
+         * \return An iterator to \a key's entry, or end() if \a key isn't in
+         *         the map
+         */
+        constexpr iterator find(KEY const & key) noexcept
+        {
+            return iterator{_occupied.find(key), _values};
+        }
+
+        /** \brief find an entry
+         *
+         * \return An iterator to \a key's entry, or end() if \a key isn't in
+         *         the map
+         */
+        constexpr const_iterator find(KEY const & key) const noexcept
+        {
+            return const_iterator{_occupied.find(key), _values};
+        }
+
+        /// \brief get the keys in the map
+        constexpr set_type const & keys() const noexcept
+        {
+            return _occupied;
+        }
+
+        /// \brief get the number of entries
+        constexpr size_type size() const noexcept
+        {
+            return _occupied.size();
+        }
+
+        /// \brief determine if the map is empty
+        constexpr bool empty() const noexcept
+        {
+            return _occupied.empty();
+        }
+
+        /// \brief remove every entry
+        constexpr void clear()
+        {
+            for(auto const key : _occupied)
+            {
+                _values[range::index_of(key)] = VALUE{};
+            }
+            _occupied.clear();
+        }
+
+        /// \brief get an iterator to the entry with the smallest key
+        constexpr iterator begin() noexcept
+        {
+            return iterator{_occupied.begin(), _values};
+        }
+
+        /// \brief get an iterator to the entry with the smallest key
+        constexpr const_iterator begin() const noexcept
+        {
+            return const_iterator{_occupied.begin(), _values};
+        }
+
+        /// \brief get an iterator past the entry with the largest key
+        constexpr iterator end() noexcept
+        {
+            return iterator{_occupied.end(), _values};
+        }
+
+        /// \brief get an iterator past the entry with the largest key
+        constexpr const_iterator end() const noexcept
+        {
+            return const_iterator{_occupied.end(), _values};
+        }
+
+    private:
+        constexpr void check(KEY const & key) const
+        {
+            if(!_occupied.contains(key))
+            {
+                throw std::out_of_range{"bounded_map key"};
+            }
+        }
+
+        set_type _occupied;
+        VALUE _values[range::size] = {};
+    };
+
+#if __cplusplus < 201703L
+    /// \cond false
+    template <typename KEY, typename VALUE>
+    constexpr std::size_t bounded_map<KEY, VALUE>::capacity;
+    /// \endcond
+#endif
+} // namespace houseguest
+
+#endif
@@ -0,0 +1,409 @@
+#ifndef HOUSEGUEST_BOUNDED_PARSE_HPP
+#define HOUSEGUEST_BOUNDED_PARSE_HPP 1
+
+#include <cstdint>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+#include <houseguest/bounded_value.hpp>
+#include <houseguest/constrained_value.hpp>
+#include <houseguest/validation_result.hpp>
+
+/** \file
+ *
+ * \brief Parse text directly into constrained_values
+ *
+ * Parsing an integer and then constructing a bounded_value checks the value
+ * twice and reports failures with exceptions.  The functions here fold the
+ * range check into digit parsing: as each digit is accumulated, the result is
+ * compared against a bound computed at compile time, and parsing stops as soon
+ * as the value can't possibly be in range.  Failures are reported through
+ * validation_result instead of exceptions.
+ *
+ * The accepted syntax matches std::from_chars for base 10: an optional '-'
+ * followed by one or more digits, with no whitespace, '+', or trailing
+ * characters.
+ */
+
+namespace houseguest
+{
+    namespace internal
+    {
+        /// \brief the possible outcomes of parse_range
+        enum class parse_status
+        {
+            success,
+            below_min,
+            above_max,
+            invalid
+        };
+
+        constexpr bool is_digit(char c) noexcept
+        {
+            return (c >= '0') && (c <= '9');
+        }
+
+        /// \brief get the absolute value of \a value as an std::uintmax_t
+        template <typename T>
+        constexpr std::uintmax_t magnitude_of(T value) noexcept
+        {
+            return cmp_less(value, 0)
+                       ? (std::uintmax_t{0} -
+                          static_cast<std::uintmax_t>(value))
+                       : static_cast<std::uintmax_t>(value);
+        }
+
+        /** \brief the magnitudes a validator accepts for each sign
+         *
+         * \tparam VALIDATOR a type derived from bounded_validator
+         */
+        template <typename VALIDATOR>
+        struct parse_limits
+        {
+            static constexpr auto min = VALIDATOR::min;
+            static constexpr auto max = VALIDATOR::max;
+
+            // non-negative values
+            static constexpr bool positive_allowed = !cmp_less(max, 0);
+            static constexpr std::uintmax_t positive_max =
+                positive_allowed ? magnitude_of(max) : 0;
+            static constexpr std::uintmax_t positive_min =
+                cmp_less(0, min) ? magnitude_of(min) : 0;
+
+            // non-positive values
+            static constexpr bool negative_allowed = !cmp_less(0, min);
+            static constexpr std::uintmax_t negative_max =
+                negative_allowed ? magnitude_of(min) : 0;
+            static constexpr std::uintmax_t negative_min =
+                cmp_less(max, 0) ? magnitude_of(max) : 0;
+        };
+
+        /** \brief make sure the rest of the text is digits
+         *
+         * \return \a status if every character in [\a first, \a last) is a
+         *         digit; otherwise, parse_status::invalid
+         */
+        inline parse_status finish_digits(char const * first,
+                                          char const * last,
+                                          parse_status status) noexcept
+        {
+            for(; first != last; ++first)
+            {
+                if(!is_digit(*first))
+                {
+                    return parse_status::invalid;
+                }
+            }
+            return status;
+        }
+
+        /** \brief accumulate digits until they run out or exceed a limit
+         *
+         * Once LIMIT is exceeded, the remaining text is still checked, so
+         * malformed text is reported as invalid rather than out of range.
+         *
+         * \tparam LIMIT the largest magnitude that's acceptable
+         *
+         * \param first     the first digit.  \a first must be less-than \a last
+         *                  and point to a digit.
+         * \param last      the end of the text
+         * \param magnitude where to store the parsed magnitude
+         * \param exceeded  the status to return if LIMIT is exceeded
+         */
+        template <std::uintmax_t LIMIT>
+        parse_status parse_magnitude(char const * first, char const * last,
+                                     std::uintmax_t & magnitude,
+                                     parse_status exceeded) noexcept
+        {
+            constexpr auto limit_tens = LIMIT / 10;
+            constexpr auto limit_ones = LIMIT % 10;
+
+            std::uintmax_t result = 0;
+            for(; first != last; ++first)
+            {
+                if(!is_digit(*first))
+                {
+                    return parse_status::invalid;
+                }
+                auto const digit = static_cast<std::uintmax_t>(*first - '0');
+                if((result > limit_tens) ||
+                   ((result == limit_tens) && (digit > limit_ones)))
+                {
+                    // no number of additional digits can bring this back in
+                    // range
+                    return finish_digits(first, last, exceeded);
+                }
+                result = (result * 10) + digit;
+            }
+            magnitude = result;
+            return parse_status::success;
+        }
+
+        /** \brief parse text and check it against a validator's range
+         *
+         * \tparam VALIDATOR a type derived from bounded_validator
+         *
+         * \param first the beginning of the text
+         * \param last  the end of the text
+         * \param value where to store the parsed value.  This is only
+         *              modified if parse_status::success is returned.
+         */
+        template <typename VALIDATOR>
+        parse_status parse_range(char const * first, char const * last,
+                                 typename VALIDATOR::type & value) noexcept
+        {
+            using limits = parse_limits<VALIDATOR>;
+            using value_type = typename VALIDATOR::type;
+
+            bool const negative = (first != last) && (*first == '-');
+            if(negative)
+            {
+                ++first;
+            }
+            if((first == last) || !is_digit(*first))
+            {
+                return parse_status::invalid;
+            }
+
+            std::uintmax_t magnitude = 0;
+            if(negative)
+            {
+                auto const status = limits::negative_allowed
+                                        ? parse_magnitude<limits::negative_max>(
+                                              first, last, magnitude,
+                                              parse_status::below_min)
+                                        : finish_digits(
+                                              first, last,
+                                              parse_status::below_min);
+                if(status != parse_status::success)
+                {
+                    return status;
+                }
+                if(magnitude < limits::negative_min)
+                {
+                    return parse_status::above_max;
+                }
+                value = static_cast<value_type>(std::uintmax_t{0} - magnitude);
+            }
+            else
+            {
+                auto const status = limits::positive_allowed
+                                        ? parse_magnitude<limits::positive_max>(
+                                              first, last, magnitude,
+                                              parse_status::above_max)
+                                        : finish_digits(
+                                              first, last,
+                                              parse_status::above_max);
+                if(status != parse_status::success)
+                {
+                    return status;
+                }
+                if(magnitude < limits::positive_min)
+                {
+                    return parse_status::below_min;
+                }
+                value = static_cast<value_type>(magnitude);
+            }
+            return parse_status::success;
+        }
+
+        /** \brief told about numbers that parse accepts or rejects without
+         *         passing them to VALIDATOR
+         *
+         * This does nothing; instrumented validators specialize it so parsed
+         * numbers are counted too.
+         */
+        template <typename VALIDATOR>
+        struct parse_observer
+        {
+            static void observe(parse_status)
+            {
+            }
+        };
+
+        template <typename CONSTRAINED>
+        validation_result<CONSTRAINED>
+        make_parsed(typename CONSTRAINED::underlying_type value,
+                    std::true_type)
+        {
+            // the range check during parsing was the entire validation
+            parse_observer<typename CONSTRAINED::validator>::observe(
+                parse_status::success);
+            return CONSTRAINED{prevalidated, value};
+        }
+
+        template <typename CONSTRAINED>
+        validation_result<CONSTRAINED>
+        make_parsed(typename CONSTRAINED::underlying_type value,
+                    std::false_type)
+        {
+            using validator_type = typename CONSTRAINED::validator;
+            return try_make<CONSTRAINED>(
+                value,
+                has_check<validator_type,
+                          typename CONSTRAINED::underlying_type>{});
+        }
+
+        template <typename CONSTRAINED>
+        validation_result<CONSTRAINED>
+        make_out_of_range(parse_status status, std::true_type)
+        {
+            parse_observer<typename CONSTRAINED::validator>::observe(status);
+            return validation_result<CONSTRAINED>{
+                make_bounded_value_error_code(
+                    (status == parse_status::below_min)
+                        ? bounded_value_error::below_min
+                        : bounded_value_error::above_max)};
+        }
+
+        template <typename CONSTRAINED>
+        validation_result<CONSTRAINED>
+        make_out_of_range(parse_status status, std::false_type)
+        {
+            // Validators that can't reject values (e.g.,
+            // clamping_validator) are given the value closest to the parsed
+            // text that T can represent.
+            using validator_type = typename CONSTRAINED::validator;
+            using value_type = typename CONSTRAINED::underlying_type;
+            using limits = std::numeric_limits<value_type>;
+
+            constexpr auto min = validator_type::min;
+            constexpr auto max = validator_type::max;
+            return CONSTRAINED{
+                (status == parse_status::below_min)
+                    ? ((min > limits::min()) ? static_cast<value_type>(min - 1)
+                                             : min)
+                    : ((max < limits::max()) ? static_cast<value_type>(max + 1)
+                                             : max)};
+        }
+    } // namespace internal
+
+    /** \brief parse text into a constrained_value
+     *
+     * Digits are checked against the validator's range as they're parsed, so
+     * out-of-range numbers stop accumulating after at most one digit more
+     * than the bound requires.  The rest of the text is still checked, so
+     * malformed text is always reported as invalid.
+     *
+     * \tparam CONSTRAINED the constrained_value to create.  The validator
+     *                     must be derived from bounded_validator and default
+     *                     constructible.
+     *
+     * \param first the beginning of the text
+     * \param last  the end of the text.  Every character in
+     *              [\a first, \a last) must be part of the number.
+     *
+     * \return The parsed value, or an error explaining why parsing failed:
+     *         - std::errc::invalid_argument if the text isn't a number
+     *         - bounded_value_error::below_min or
+     *           bounded_value_error::above_max if the number is out of range.
+     *           Validators without a check function (e.g.,
+     *           clamping_validator) don't report these; the number is
+     *           clamped instead.
+     *         - any error reported by the validator's check function
+     */
+    template <typename CONSTRAINED>
+    validation_result<CONSTRAINED> parse(char const * first, char const * last)
+    {
+        using validator_type = typename CONSTRAINED::validator;
+        using value_type = typename CONSTRAINED::underlying_type;
+        static_assert(internal::has_range<validator_type>::value,
+                      "Parsing requires a validator with a range");
+
+        value_type value{};
+        auto const status =
+            internal::parse_range<validator_type>(first, last, value);
+        switch(status)
+        {
+        case internal::parse_status::success:
+            return internal::make_parsed<CONSTRAINED>(
+                value, is_range_validator<validator_type>{});
+
+        case internal::parse_status::invalid:
+            return validation_result<CONSTRAINED>{
+                std::make_error_code(std::errc::invalid_argument)};
+
+        default:
+            return internal::make_out_of_range<CONSTRAINED>(
+                status, internal::has_check<validator_type, value_type>{});
+        }
+    }
+
+#if __cplusplus >= 201703L
+    /** \brief parse text into a constrained_value
+     *
+     * \tparam CONSTRAINED the constrained_value to create
+     *
+     * \param text the text to parse.  The entire view must be a number.
+     */
+    template <typename CONSTRAINED>
+    validation_result<CONSTRAINED> parse(std::string_view text)
+    {
+        return parse<CONSTRAINED>(text.data(), text.data() + text.size());
+    }
+#endif
+
+    /** \brief the result of parse_column
+     *
+     * \tparam OUTPUT the output iterator type
+     */
+    template <typename OUTPUT>
+    struct column_parse_result
+    {
+        /// \brief the start of the first field that couldn't be parsed, or
+        ///        the end of the text if every field was parsed
+        char const * position;
+
+        /// \brief the output iterator, advanced past every parsed value
+        OUTPUT out;
+
+        /// \brief the reason parsing stopped, or an empty error on success
+        std::error_code error;
+    };
+
+    /** \brief parse delimited fields into constrained_values
+     *
+     * Each field is parsed using parse and written to \a out.  Parsing stops
+     * at the first field that fails.
+     *
+     * \tparam CONSTRAINED the constrained_value to create
+     *
+     * \param first     the beginning of the text
+     * \param last      the end of the text
+     * \param delimiter the character separating fields (e.g., ',' or '\\n')
+     * \param out       where to write parsed values
+     *
+     * \return Where parsing stopped and why
+     */
+    template <typename CONSTRAINED, typename OUTPUT>
+    column_parse_result<OUTPUT> parse_column(char const * first,
+                                             char const * last,
+                                             char delimiter, OUTPUT out)
+    {
+        while(first != last)
+        {
+            auto field_end = first;
+            while((field_end != last) && (*field_end != delimiter))
+            {
+                ++field_end;
+            }
+            auto const result = parse<CONSTRAINED>(first, field_end);
+            if(!result)
+            {
+                return {first, out, result.error()};
+            }
+            *out = result.value();
+            ++out;
+            first = (field_end == last) ? last : field_end + 1;
+        }
+        return {last, out, std::error_code{}};
+    }
+} // namespace houseguest
+
+#endif
@@ -0,0 +1,451 @@
+#ifndef HOUSEGUEST_BOUNDED_SET_HPP
+#define HOUSEGUEST_BOUNDED_SET_HPP 1
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+#include <houseguest/bounded_value.hpp>
+#include <houseguest/constrained_value.hpp>
+
+/** \file
+ *
+ * \brief A set of constrained_values stored as a fixed-size bitset
+ */
+
+namespace houseguest
+{
+    namespace internal
+    {
+        /// \brief the type bounded_set stores bits in
+        using set_word = std::uint64_t;
+
+        /// \brief the number of bits in a set_word
+        constexpr std::size_t set_word_bits =
+            std::numeric_limits<set_word>::digits;
+
+        /// \brief count the bits set in \a word
+        constexpr unsigned popcount(set_word word) noexcept
+        {
+            // compilers recognize this and emit a popcount instruction when
+            // the target has one
+            word = word - ((word >> 1) & 0x5555555555555555ULL);
+            word = (word & 0x3333333333333333ULL) +
+                   ((word >> 2) & 0x3333333333333333ULL);
+            word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+            return static_cast<unsigned>((word * 0x0101010101010101ULL) >>
+                                         56);
+        }
+
+        /// \brief get the index of the lowest bit set in \a word (which
+        ///        must not be zero)
+        constexpr unsigned lowest_set_bit(set_word word) noexcept
+        {
+            // isolate the lowest bit, then look up its position with a de
+            // Bruijn sequence
+            constexpr unsigned char positions[64] = {
+                0,  1,  48, 2,  57, 49, 28, 3,  61, 58, 50, 42, 38, 29, 17, 4,
+                62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12, 5,
+                63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+                46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9,  13, 8,  7,  6};
+            return positions[((word & (0 - word)) * 0x03F79D71B4CB0A89ULL) >>
+                             58];
+        }
+
+        /** \brief the number of keys a constrained_value type can hold
+         *
+         * \tparam KEY a constrained_value whose validator has a range
+         */
+        template <typename KEY>
+        struct key_range
+        {
+            using validator = typename KEY::validator;
+            using underlying_type = typename KEY::underlying_type;
+
+            static_assert(has_range<validator>::value,
+                          "Keys require a validator with a range");
+            static_assert(range_span<validator>() <
+                              std::numeric_limits<std::size_t>::max(),
+                          "The key range is too large");
+
+            /// \brief the number of distinct keys
+            static constexpr std::size_t size =
+                static_cast<std::size_t>(range_span<validator>()) + 1;
+
+            /// \brief get the index of \a key
+            static constexpr std::size_t index_of(KEY const & key) noexcept
+            {
+                return static_cast<std::size_t>(range_offset<validator>(
+                    static_cast<underlying_type>(key)));
+            }
+
+            /// \brief get the key at \a index
+            static constexpr KEY key_of(std::size_t index) noexcept
+            {
+                return KEY{prevalidated,
+                           from_range_offset<validator>(
+                               static_cast<std::make_unsigned_t<
+                                   underlying_type>>(index))};
+            }
+        };
+    } // namespace internal
+
+    /** \brief a set of constrained_values stored as one bit per possible key
+     *
+     * Every key a KEY can hold has a fixed bit, found by its distance from the
+     * validator's minimum, so insertion, removal, and lookup are a shift and
+     * a mask with no hashing or allocation.  The storage is sized at compile
+     * time, so bounded_set is only appropriate for small ranges (a
+     * bounded_value<int, 0, 4095> takes 512 bytes).
+     *
+     * Set operations (union, intersection, difference, and size) work on
+     * 64 bits at a time in loops simple enough for compilers to vectorize.
+     * Iteration visits keys in ascending order, skipping empty words and
+     * jumping directly between set bits.
+     *
+     * Every member function is constexpr, so sets can be built at compile
+     * time.
+     *
+     * \tparam KEY a constrained_value whose validator has a range (e.g.,
+     *             bounded_value)
+     */
+    template <typename KEY>
+    class bounded_set
+    {
+        using range = internal::key_range<KEY>;
+        using word_type = internal::set_word;
+
+        static constexpr std::size_t word_count =
+            (range::size + internal::set_word_bits - 1) /
+            internal::set_word_bits;
+
+    public:
+        /// \brief the type of keys
+        using key_type = KEY;
+
+        /// \brief the type of values (the keys themselves)
+        using value_type = KEY;
+
+        /// \brief the type used for sizes
+        using size_type = std::size_t;
+
+        /// \brief an iterator over the keys in the set, in ascending order
+        class const_iterator
+        {
+        public:
+            /// \cond false
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = KEY;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = KEY;
+
+            constexpr const_iterator() noexcept = default;
+
+            constexpr KEY operator*() const noexcept
+            {
+                return range::key_of(index());
+            }
+
+            constexpr const_iterator & operator++() noexcept
+            {
+                _bits &= _bits - 1;
+                skip_empty();
+                return *this;
+            }
+
+            constexpr const_iterator operator++(int) noexcept
+            {
+                auto ret = *this;
+                ++*this;
+                return ret;
+            }
+
+            friend constexpr bool
+            operator==(const_iterator const & lhs,
+                       const_iterator const & rhs) noexcept
+            {
+                return (lhs._word == rhs._word) && (lhs._bits == rhs._bits);
+            }
+
+            friend constexpr bool
+            operator!=(const_iterator const & lhs,
+                       const_iterator const & rhs) noexcept
+            {
+                return !(lhs == rhs);
+            }
+            /// \endcond
+
+            /// \brief get the current key's index (its distance from min)
+            constexpr size_type index() const noexcept
+            {
+                return (_word * internal::set_word_bits) +
+                       internal::lowest_set_bit(_bits);
+            }
+
+        private:
+            friend class bounded_set;
+
+            constexpr const_iterator(word_type const * words,
+                                     size_type word) noexcept
+              : _words{words}
+              , _word{word}
+              , _bits{(word < word_count) ? words[word] : 0}
+            {
+                skip_empty();
+            }
+
+            constexpr const_iterator(word_type const * words, size_type word,
+                                     word_type bits) noexcept
+              : _words{words}
+              , _word{word}
+              , _bits{bits}
+            {
+            }
+
+            constexpr void skip_empty() noexcept
+            {
+                while((_bits == 0) && (_word < word_count))
+                {
+                    ++_word;
+                    _bits = (_word < word_count) ? _words[_word] : 0;
+                }
+            }
+
+            word_type const * _words = nullptr;
+            size_type _word = word_count;
+            word_type _bits = 0;
+        };
+
+        /// \brief the same as const_iterator, since keys can't be modified
+        using iterator = const_iterator;
+
+        /// \brief the number of keys a bounded_set can hold
+        static constexpr size_type capacity = range::size;
+
+        /// \brief construct an empty bounded_set
+        constexpr bounded_set() noexcept = default;
+
+        /// \brief construct a bounded_set containing \a keys
+        constexpr bounded_set(std::initializer_list<KEY> keys) noexcept
+        {
+            for(auto const & key : keys)
+            {
+                insert(key);
+            }
+        }
+
+        /** \brief add a key
+         *
+         * \retval true  \a key was added
+         * \retval false \a key was already in the set
+         */
+        constexpr bool insert(KEY const & key) noexcept
+        {
+            auto const index = range::index_of(key);
+            auto & word = _words[index / internal::set_word_bits];
+            auto const bit = bit_of(index);
+            auto const inserted = (word & bit) == 0;
+            word |= bit;
+            return inserted;
+        }
+
+        /** \brief remove a key
+         *
+         * \return The number of keys removed (0 or 1)
+         */
+        constexpr size_type erase(KEY const & key) noexcept
+        {
+            auto const index = range::index_of(key);
+            auto & word = _words[index / internal::set_word_bits];
+            auto const bit = bit_of(index);
+            auto const erased = (word & bit) != 0;
+            word &= ~bit;
+            return erased ? 1 : 0;
+        }
+
+        /// \brief determine if \a key is in the set
+        constexpr bool contains(KEY const & key) const noexcept
+        {
+            auto const index = range::index_of(key);
+            return (_words[index / internal::set_word_bits] & bit_of(index)) !=
+                   0;
+        }
+
+        /// \brief get the number of times \a key is in the set (0 or 1)
+        constexpr size_type count(KEY const & key) const noexcept
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        /// \brief get the number of keys in the set
+        constexpr size_type size() const noexcept
+        {
+            size_type ret = 0;
+            for(size_type i = 0; i < word_count; ++i)
+            {
+                ret += internal::popcount(_words[i]);
+            }
+            return ret;
+        }
+
+        /// \brief determine if the set is empty
+        constexpr bool empty() const noexcept
+        {
+            word_type any = 0;
+            for(size_type i = 0; i < word_count; ++i)
+            {
+                any |= _words[i];
+            }
+            return any == 0;
+        }
+
+        /// \brief remove every key
+        constexpr void clear() noexcept
+        {
+            for(size_type i = 0; i < word_count; ++i)
+            {
+                _words[i] = 0;
+            }
+        }
+
+        /// \brief get an iterator to the smallest key
+        constexpr const_iterator begin() const noexcept
+        {
+            return const_iterator{_words, 0};
+        }
+
+        /// \brief get an iterator past the largest key
+        constexpr const_iterator end() const noexcept
+        {
+            return const_iterator{_words, word_count, 0};
+        }
+
+        /** \brief find a key
+         *
+         * \return An iterator to \a key, or end() if it isn't in the set
+         */
+        constexpr const_iterator find(KEY const & key) const noexcept
+        {
+            if(!contains(key))
+            {
+                return end();
+            }
+            // the iterator starts at key, with every lower bit in its word
+            // cleared
+            auto const index = range::index_of(key);
+            auto const word = index / internal::set_word_bits;
+            return const_iterator{_words, word,
+                                  _words[word] & ~(bit_of(index) - 1)};
+        }
+
+        /// \brief add every key in \a other (union)
+        constexpr bounded_set & operator|=(bounded_set const & other) noexcept
+        {
+            for(size_type i = 0; i < word_count; ++i)
+            {
+                _words[i] |= other._words[i];
+            }
+            return *this;
+        }
+
+        /// \brief remove every key not in \a other (intersection)
+        constexpr bounded_set & operator&=(bounded_set const & other) noexcept
+        {
+            for(size_type i = 0; i < word_count; ++i)
+            {
+                _words[i] &= other._words[i];
+            }
+            return *this;
+        }
+
+        /// \brief remove every key in \a other (difference)
+        constexpr bounded_set & operator-=(bounded_set const & other) noexcept
+        {
+            for(size_type i = 0; i < word_count; ++i)
+            {
+                _words[i] &= ~other._words[i];
+            }
+            return *this;
+        }
+
+        /// \brief keep keys in exactly one of the sets (symmetric
+        ///        difference)
+        constexpr bounded_set & operator^=(bounded_set const & other) noexcept
+        {
+            for(size_type i = 0; i < word_count; ++i)
+            {
+                _words[i] ^= other._words[i];
+            }
+            return *this;
+        }
+
+        /// \cond false
+        friend constexpr bounded_set operator|(bounded_set lhs,
+                                               bounded_set const & rhs) noexcept
+        {
+            return lhs |= rhs;
+        }
+
+        friend constexpr bounded_set operator&(bounded_set lhs,
+                                               bounded_set const & rhs) noexcept
+        {
+            return lhs &= rhs;
+        }
+
+        friend constexpr bounded_set operator-(bounded_set lhs,
+                                               bounded_set const & rhs) noexcept
+        {
+            return lhs -= rhs;
+        }
+
+        friend constexpr bounded_set operator^(bounded_set lhs,
+                                               bounded_set const & rhs) noexcept
+        {
+            return lhs ^= rhs;
+        }
+
+        friend constexpr bool operator==(bounded_set const & lhs,
+                                         bounded_set const & rhs) noexcept
+        {
+            for(size_type i = 0; i < word_count; ++i)
+            {
+                if(lhs._words[i] != rhs._words[i])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        friend constexpr bool operator!=(bounded_set const & lhs,
+                                         bounded_set const & rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+        /// \endcond
+
+    private:
+        static constexpr word_type bit_of(size_type index) noexcept
+        {
+            return word_type{1} << (index % internal::set_word_bits);
+        }
+
+        word_type _words[word_count] = {};
+    };
+
+#if __cplusplus < 201703L
+    /// \cond false
+    template <typename KEY>
+    constexpr std::size_t bounded_set<KEY>::word_count;
+
+    template <typename KEY>
+    constexpr std::size_t bounded_set<KEY>::capacity;
+    /// \endcond
+#endif
+} // namespace houseguest
+
+#endif
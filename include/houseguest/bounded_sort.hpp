@@ -0,0 +1,273 @@
+#ifndef HOUSEGUEST_BOUNDED_SORT_HPP
+#define HOUSEGUEST_BOUNDED_SORT_HPP 1
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include <houseguest/bounded_value.hpp>
+#include <houseguest/constrained_value.hpp>
+
+/** \file
+ *
+ * \brief Sorting that takes advantage of a validator's range
+ *
+ * Values with a range known at compile time can be sorted without comparing
+ * them: each value is reduced to its distance from the validator's minimum
+ * (a small unsigned key), and the keys are distributed into buckets.  Narrow
+ * ranges with at least as many values as keys use a counting sort, which
+ * makes one pass to count each key and one to write the results.  Otherwise,
+ * a least-significant-digit radix sort over 8-bit digits is used, with one
+ * pass per digit that the range needs.  Either way, sorting takes
+ * O(n + buckets) time instead of O(n log n).  Inputs too short to pay for
+ * the buckets fall back to std::sort.
+ */
+
+namespace houseguest
+{
+    namespace internal
+    {
+        /// \brief the widest range (in bits) sorted with a counting sort
+        constexpr unsigned counting_sort_max_bits = 16;
+
+        /// \brief the number of bits radix sort handles per pass
+        constexpr unsigned radix_digit_bits = 8;
+
+        /// \brief inputs shorter than this use std::sort
+        constexpr std::size_t range_sort_min_size = 64;
+
+        /** \brief the number of values needed per radix sort pass before
+         *         it's faster than std::sort
+         */
+        constexpr std::size_t radix_sort_min_size_per_pass = 256;
+
+        /** \brief details of sorting by offset from a validator's minimum
+         *
+         * \tparam VALIDATOR a type derived from bounded_validator
+         */
+        template <typename VALIDATOR>
+        struct range_sort_traits
+        {
+            static_assert(has_range<VALIDATOR>::value,
+                          "Range sorting requires a validator with a range");
+
+            using value_type = typename VALIDATOR::type;
+
+            /// \brief the type used for keys (offsets from min)
+            using key_type = least_unsigned_t<range_span<VALIDATOR>()>;
+
+            /// \brief the number of significant bits in a key
+            static constexpr unsigned bits =
+                bits_required(range_span<VALIDATOR>());
+
+            /// \brief true if a counting sort can be used
+            static constexpr bool counting = bits <= counting_sort_max_bits;
+
+            static constexpr key_type key_of(value_type value) noexcept
+            {
+                return static_cast<key_type>(range_offset<VALIDATOR>(value));
+            }
+
+            static constexpr value_type value_of(key_type key) noexcept
+            {
+                return from_range_offset<VALIDATOR>(
+                    static_cast<std::make_unsigned_t<value_type>>(key));
+            }
+        };
+
+        // raw values are written as they are...
+        template <typename ELEMENT, typename T>
+        constexpr ELEMENT make_sorted_element(T value, std::true_type) noexcept
+        {
+            return value;
+        }
+
+        // ...and constrained_values skip validation, since every value
+        // written back was read from the input
+        template <typename ELEMENT, typename T>
+        constexpr ELEMENT make_sorted_element(T value,
+                                              std::false_type) noexcept
+        {
+            return ELEMENT{prevalidated, value};
+        }
+
+        template <typename ELEMENT, typename T>
+        constexpr ELEMENT make_sorted_element(T value) noexcept
+        {
+            return make_sorted_element<ELEMENT>(value,
+                                                std::is_same<ELEMENT, T>{});
+        }
+
+        template <typename VALIDATOR, typename ITERATOR>
+        void range_sort(ITERATOR first, ITERATOR last, std::false_type);
+
+        template <typename VALIDATOR, typename ITERATOR>
+        void range_sort(ITERATOR first, ITERATOR last, std::true_type)
+        {
+            using traits = range_sort_traits<VALIDATOR>;
+            using element =
+                typename std::iterator_traits<ITERATOR>::value_type;
+            using value_type = typename traits::value_type;
+
+            // every key in the range is visited, so inputs with fewer
+            // values than keys are cheaper to radix sort
+            if(static_cast<std::size_t>(std::distance(first, last)) <
+               static_cast<std::size_t>(range_span<VALIDATOR>()))
+            {
+                range_sort<VALIDATOR>(first, last, std::false_type{});
+                return;
+            }
+
+            std::vector<std::size_t> counts(
+                static_cast<std::size_t>(range_span<VALIDATOR>()) + 1);
+            for(auto it = first; it != last; ++it)
+            {
+                ++counts[traits::key_of(static_cast<value_type>(*it))];
+            }
+            for(std::size_t key = 0; key < counts.size(); ++key)
+            {
+                first = std::fill_n(
+                    first, counts[key],
+                    make_sorted_element<element>(traits::value_of(
+                        static_cast<typename traits::key_type>(key))));
+            }
+        }
+
+        template <typename VALIDATOR, typename ITERATOR>
+        void range_sort(ITERATOR first, ITERATOR last, std::false_type)
+        {
+            using traits = range_sort_traits<VALIDATOR>;
+            using key_type = typename traits::key_type;
+            using element =
+                typename std::iterator_traits<ITERATOR>::value_type;
+            using value_type = typename traits::value_type;
+
+            constexpr std::size_t buckets = std::size_t{1}
+                                            << radix_digit_bits;
+            constexpr std::size_t digit_mask = buckets - 1;
+            constexpr std::size_t passes =
+                (traits::bits + radix_digit_bits - 1) / radix_digit_bits;
+
+            if(static_cast<std::size_t>(std::distance(first, last)) <
+               passes * radix_sort_min_size_per_pass)
+            {
+                // too few values to pay for every pass's buckets
+                std::sort(first, last);
+                return;
+            }
+
+            std::vector<key_type> keys;
+            keys.reserve(static_cast<std::size_t>(std::distance(first, last)));
+            for(auto it = first; it != last; ++it)
+            {
+                keys.push_back(traits::key_of(static_cast<value_type>(*it)));
+            }
+            std::vector<key_type> sorted(keys.size());
+
+            for(unsigned shift = 0; shift < traits::bits;
+                shift += radix_digit_bits)
+            {
+                std::array<std::size_t, buckets> counts{};
+                for(auto key : keys)
+                {
+                    ++counts[(key >> shift) & digit_mask];
+                }
+                if(std::find(std::begin(counts), std::end(counts),
+                             keys.size()) != std::end(counts))
+                {
+                    // every key has the same digit, so this pass wouldn't
+                    // change anything
+                    continue;
+                }
+                std::size_t position = 0;
+                for(auto & count : counts)
+                {
+                    auto const bucket_size = count;
+                    count = position;
+                    position += bucket_size;
+                }
+                for(auto key : keys)
+                {
+                    sorted[counts[(key >> shift) & digit_mask]++] = key;
+                }
+                keys.swap(sorted);
+            }
+
+            for(auto key : keys)
+            {
+                *first = make_sorted_element<element>(traits::value_of(key));
+                ++first;
+            }
+        }
+
+        /** \brief sort values by their offset from a validator's minimum
+         *
+         * \tparam VALIDATOR a validator with a range.  Every value in
+         *                   [\a first, \a last) must be in that range.
+         * \tparam ITERATOR  a mutable random access iterator over either
+         *                   VALIDATOR::type values or constrained_values
+         *                   using VALIDATOR
+         */
+        template <typename VALIDATOR, typename ITERATOR>
+        void range_sort(ITERATOR first, ITERATOR last)
+        {
+            if(std::distance(first, last) <
+               static_cast<std::ptrdiff_t>(range_sort_min_size))
+            {
+                // too few values to pay for the buckets
+                std::sort(first, last);
+                return;
+            }
+            range_sort<VALIDATOR>(
+                first, last,
+                std::integral_constant<
+                    bool, range_sort_traits<VALIDATOR>::counting>{});
+        }
+    } // namespace internal
+
+    /** \brief sort constrained_values in ascending order
+     *
+     * Values are sorted by their offset from the validator's minimum instead
+     * of by comparison: a counting sort if the range spans 2^16 values or
+     * fewer and there are at least as many values as keys, and a radix sort
+     * otherwise (or std::sort, for inputs too short to benefit).  Like
+     * std::sort, this isn't stable, but since equal constrained_values are
+     * indistinguishable, that's never observable.  Validators are
+     * default-constructed for the sorted values, and validation isn't
+     * repeated.
+     *
+     * \tparam ITERATOR a mutable random access iterator over
+     *                  constrained_values whose validator has a range (e.g.,
+     *                  bounded_value or clamped_value)
+     *
+     * \param first the beginning of the values to sort
+     * \param last  the end of the values to sort
+     *
+     * \note This isn't named sort, since ADL would find it alongside
+     *       std::sort for any iterator over constrained_values.
+     */
+    template <typename ITERATOR>
+    void bounded_sort(ITERATOR first, ITERATOR last)
+    {
+        using element = typename std::iterator_traits<ITERATOR>::value_type;
+        internal::range_sort<typename element::validator>(first, last);
+    }
+
+    /** \brief sort a range of constrained_values in ascending order
+     *
+     * \param range a container of constrained_values (e.g., an std::vector
+     *              of bounded_values)
+     */
+    template <typename RANGE>
+    void bounded_sort(RANGE & range)
+    {
+        using std::begin;
+        using std::end;
+        houseguest::bounded_sort(begin(range), end(range));
+    }
+} // namespace houseguest
+
+#endif
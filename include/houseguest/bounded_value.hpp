@@ -5,7 +5,14 @@
 #include <algorithm>
 #endif
 
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <limits>
 #include <system_error>
+#include <type_traits>
+#include <utility>
 
 #include <houseguest/constrained_value.hpp>
 
@@ -61,6 +68,17 @@ namespace houseguest
         }
     } // namespace internal
 
+    /** \brief create an std::error_code from a bounded_value_error
+     *
+     * This lets a bounded_value_error convert to std::error_code implicitly.
+     *
+     * \param error the error to convert
+     */
+    inline std::error_code make_error_code(bounded_value_error error)
+    {
+        return internal::make_bounded_value_error_code(error);
+    }
+
     template <typename T, T MIN, T MAX>
     struct bounded_validator
     {
@@ -77,6 +95,86 @@ namespace houseguest
         static constexpr T max = MAX;
     };
 
+    namespace internal
+    {
+        /** \brief get the distance between a validator's minimum and maximum
+         *
+         * \tparam VALIDATOR a type derived from bounded_validator
+         *
+         * \return max - min, computed without overflow
+         */
+        template <typename VALIDATOR>
+        constexpr std::make_unsigned_t<typename VALIDATOR::type>
+        range_span() noexcept
+        {
+            using unsigned_type =
+                std::make_unsigned_t<typename VALIDATOR::type>;
+            return static_cast<unsigned_type>(
+                static_cast<unsigned_type>(VALIDATOR::max) -
+                static_cast<unsigned_type>(VALIDATOR::min));
+        }
+
+        /** \brief get the distance between \a value and a validator's minimum
+         *
+         * \tparam VALIDATOR a type derived from bounded_validator
+         *
+         * \param value the value to measure.  If \a value is less-than min,
+         *              the result wraps around to a value greater-than
+         *              range_span.
+         */
+        template <typename VALIDATOR>
+        constexpr std::make_unsigned_t<typename VALIDATOR::type>
+        range_offset(typename VALIDATOR::type value) noexcept
+        {
+            using unsigned_type =
+                std::make_unsigned_t<typename VALIDATOR::type>;
+            return static_cast<unsigned_type>(
+                static_cast<unsigned_type>(value) -
+                static_cast<unsigned_type>(VALIDATOR::min));
+        }
+
+        /** \brief the inverse of range_offset
+         *
+         * \tparam VALIDATOR a type derived from bounded_validator
+         *
+         * \param offset a distance from min
+         */
+        template <typename VALIDATOR>
+        constexpr typename VALIDATOR::type from_range_offset(
+            std::make_unsigned_t<typename VALIDATOR::type> offset) noexcept
+        {
+            using unsigned_type =
+                std::make_unsigned_t<typename VALIDATOR::type>;
+            return static_cast<typename VALIDATOR::type>(
+                static_cast<unsigned_type>(
+                    static_cast<unsigned_type>(VALIDATOR::min) + offset));
+        }
+
+        /// \brief get the number of bits required to represent \a value
+        constexpr unsigned bits_required(std::uintmax_t value) noexcept
+        {
+            unsigned bits = 0;
+            while(value != 0)
+            {
+                ++bits;
+                value >>= 1;
+            }
+            return bits;
+        }
+    } // namespace internal
+
+    namespace internal
+    {
+        template <typename T, T MIN, T MAX>
+        constexpr bounded_value_error check_bounds(T value) noexcept
+        {
+            return (value < MIN)
+                       ? bounded_value_error::below_min
+                       : (value > MAX) ? bounded_value_error::above_max
+                                       : bounded_value_error::success;
+        }
+    } // namespace internal
+
     /** \brief a validator for bounded_value that emits exceptions for invalid
      *         values
      *
@@ -87,6 +185,19 @@ namespace houseguest
     template <typename T, T MIN, T MAX>
     struct exception_validator : bounded_validator<T, MIN, MAX>
     {
+        /** \brief check if a value is between MIN and MAX without throwing
+         *
+         * \param value the value to check
+         *
+         * \retval bounded_value_error::success   \a value is in range
+         * \retval bounded_value_error::below_min \a value is less-than MIN
+         * \retval bounded_value_error::above_max \a value is greater-than MAX
+         */
+        constexpr bounded_value_error check(T value) const noexcept
+        {
+            return internal::check_bounds<T, MIN, MAX>(value);
+        }
+
         /** \brief validate a value is between MIN and MAX
          *
          * \param value the value to validate
@@ -146,6 +257,62 @@ namespace houseguest
     using bounded_value =
         constrained_value<T, exception_validator<T, MIN, MAX>>;
 
+    /** \brief a validator for bounded values that never throws
+     *
+     * checked_validator is intended for code that can't (or doesn't want to)
+     * use exceptions.  Values should be validated through try_make, which
+     * uses check to report problems as a bounded_value_error.  Passing an
+     * invalid value directly to a checked_validator has nowhere to report
+     * the error, so it terminates the program.
+     *
+     * \tparam T   the integral type to operate on
+     * \tparam MIN the minimum legal value
+     * \tparam MAX the maximum legal value
+     */
+    template <typename T, T MIN, T MAX>
+    struct checked_validator : bounded_validator<T, MIN, MAX>
+    {
+        /** \brief check if a value is between MIN and MAX
+         *
+         * \param value the value to check
+         *
+         * \retval bounded_value_error::success   \a value is in range
+         * \retval bounded_value_error::below_min \a value is less-than MIN
+         * \retval bounded_value_error::above_max \a value is greater-than MAX
+         */
+        constexpr bounded_value_error check(T value) const noexcept
+        {
+            return internal::check_bounds<T, MIN, MAX>(value);
+        }
+
+        /** \brief validate a value is between MIN and MAX
+         *
+         * \param value the value to validate
+         *
+         * \retval value The only thing this function will return.
+         *
+         * \note std::terminate is called if \a value is out of range.
+         */
+        constexpr T operator()(T value) const noexcept
+        {
+            return (check(value) == bounded_value_error::success)
+                       ? value
+                       : (std::terminate(), value);
+        }
+    };
+
+    /** \brief a constrained_value that requires values fall between MIN and
+     *         MAX without using exceptions
+     *
+     * Use try_make to construct checked_values from untrusted input.
+     *
+     * \tparam T   the integral type to operate on
+     * \tparam MIN the minimum legal value
+     * \tparam MAX the maximum legal value
+     */
+    template <typename T, T MIN, T MAX>
+    using checked_value = constrained_value<T, checked_validator<T, MIN, MAX>>;
+
     /** \brief a validator that clamps values between MIN and MAX
      *
      * \tparam T   the integral type to operate on
@@ -184,28 +351,880 @@ namespace houseguest
     template <typename T, T MIN, T MAX>
     using clamped_value = constrained_value<T, clamping_validator<T, MIN, MAX>>;
 
-    // TODO: The is_validator_convertible specializations are *very* incomplete.
-    //       These need to be replaced with something that just operates on
-    //       bounded_validator to avoid exponential specializations.
-
     /// \brief specialization for exception_validator
-    template <typename T, T MIN, T MAX, T OTHER_MIN, T OTHER_MAX>
-    struct is_validator_convertible<
-        exception_validator<T, MIN, MAX>,
-        exception_validator<T, OTHER_MIN, OTHER_MAX>>
+    template <typename T, T MIN, T MAX>
+    struct is_range_validator<exception_validator<T, MIN, MAX>> : std::true_type
+    {
+    };
+
+    /// \brief specialization for checked_validator
+    template <typename T, T MIN, T MAX>
+    struct is_range_validator<checked_validator<T, MIN, MAX>> : std::true_type
     {
-        /// \brief validators are convertible if their ranges overlap
-        constexpr static bool value = (MIN <= OTHER_MAX) && (MAX >= OTHER_MIN);
     };
 
     /// \brief specialization for clamping_validator
-    template <typename T, T MIN, T MAX, T OTHER_MIN, T OTHER_MAX>
-    struct is_validator_convertible<clamping_validator<T, MIN, MAX>,
-                                    clamping_validator<T, OTHER_MIN, OTHER_MAX>>
+    template <typename T, T MIN, T MAX>
+    struct is_range_validator<clamping_validator<T, MIN, MAX>> : std::true_type
     {
-        /// \brief validators are convertible if their ranges overlap
-        constexpr static bool value = (MIN <= OTHER_MAX) && (MAX >= OTHER_MIN);
     };
+
+    namespace internal
+    {
+        /// \brief determine if a validator clamps out-of-range values
+        template <typename VALIDATOR>
+        struct clamps : std::false_type
+        {
+        };
+
+        /// \cond false
+        template <typename T, T MIN, T MAX>
+        struct clamps<clamping_validator<T, MIN, MAX>> : std::true_type
+        {
+        };
+        /// \endcond
+    } // namespace internal
+
+    /** \brief create a constrained_value from a constant checked at compile
+     *         time
+     *
+     * \a VALUE is checked against CONSTRAINED's validator while compiling
+     * (by its test function, range, or check function), so an unacceptable
+     * constant is a compile error rather than an exception.  The result is a
+     * constant expression, so tables built from make_bounded are emitted as
+     * constant data with no static initialization.
+     *
+     * \code
+     * using percent = houseguest::bounded_value<int, 0, 100>;
+     * using houseguest::make_bounded;
+     * constexpr percent thresholds[] = {make_bounded<percent, 25>(),
+     *                                   make_bounded<percent, 75>()};
+     * \endcode
+     *
+     * \tparam CONSTRAINED the constrained_value to create (e.g., a
+     *                     bounded_value)
+     * \tparam VALUE       the value
+     */
+    template <typename CONSTRAINED,
+              typename CONSTRAINED::underlying_type VALUE>
+    constexpr CONSTRAINED make_bounded() noexcept
+    {
+        using validator = typename CONSTRAINED::validator;
+        static_assert(internal::accepts(validator{}, VALUE),
+                      "VALUE is rejected by the validator");
+        constexpr CONSTRAINED ret{
+            typename CONSTRAINED::underlying_type{VALUE}};
+        return ret;
+    }
+
+    namespace internal
+    {
+        /** \brief the smallest unsigned type that can hold \a SPAN
+         *
+         * \tparam SPAN the largest value that needs to be represented
+         */
+        template <std::uintmax_t SPAN>
+        using least_unsigned_t = std::conditional_t<
+            (SPAN <= std::numeric_limits<std::uint8_t>::max()), std::uint8_t,
+            std::conditional_t<
+                (SPAN <= std::numeric_limits<std::uint16_t>::max()),
+                std::uint16_t,
+                std::conditional_t<
+                    (SPAN <= std::numeric_limits<std::uint32_t>::max()),
+                    std::uint32_t, std::uint64_t>>>;
+
+        /** \brief a storage policy that stores offsets from a validator's
+         *         minimum
+         *
+         * Values are stored as range_offset in the smallest unsigned type
+         * that can hold range_span, so a range like [1000, 1200] fits in a
+         * single byte.
+         *
+         * \tparam VALIDATOR a type derived from bounded_validator
+         */
+        template <typename VALIDATOR>
+        struct compact_storage
+        {
+            /// \brief the type actually stored
+            using type = least_unsigned_t<range_span<VALIDATOR>()>;
+
+            /// \brief convert a valid value to its offset from min
+            static constexpr type
+            encode(typename VALIDATOR::type value) noexcept
+            {
+                return static_cast<type>(range_offset<VALIDATOR>(value));
+            }
+
+            /// \brief convert an offset from min back to a value
+            static constexpr typename VALIDATOR::type
+            decode(type value) noexcept
+            {
+                using unsigned_type =
+                    std::make_unsigned_t<typename VALIDATOR::type>;
+                return from_range_offset<VALIDATOR>(
+                    static_cast<unsigned_type>(value));
+            }
+        };
+    } // namespace internal
+
+    /** \brief a validator that stores values in as few bytes as possible
+     *
+     * compact_validator behaves exactly like \a VALIDATOR, but
+     * constrained_values using it store their value as an offset from
+     * VALIDATOR::min in the smallest unsigned type that can hold the range.
+     * Values are converted back to VALIDATOR::type on every access.
+     *
+     * \tparam VALIDATOR a type derived from bounded_validator
+     */
+    template <typename VALIDATOR>
+    struct compact_validator : VALIDATOR
+    {
+        /// \brief how constrained_values store validated values
+        using storage_policy = internal::compact_storage<VALIDATOR>;
+    };
+
+    /// \brief specialization for compact_validator
+    template <typename VALIDATOR>
+    struct is_range_validator<compact_validator<VALIDATOR>>
+      : is_range_validator<VALIDATOR>
+    {
+    };
+
+    namespace internal
+    {
+        /// \cond false
+        template <typename VALIDATOR>
+        struct clamps<compact_validator<VALIDATOR>> : clamps<VALIDATOR>
+        {
+        };
+
+        template <typename VALIDATOR, typename U>
+        struct widened_validator<compact_validator<VALIDATOR>, U>
+          : widened_validator<VALIDATOR, U>
+        {
+        };
+        /// \endcond
+    } // namespace internal
+
+    /** \brief a bounded_value that uses the smallest possible storage
+     *
+     * \tparam T   the integral type to operate on
+     * \tparam MIN the minimum legal value
+     * \tparam MAX the maximum legal value
+     */
+    template <typename T, T MIN, T MAX>
+    using compact_bounded_value =
+        constrained_value<T,
+                          compact_validator<exception_validator<T, MIN, MAX>>>;
+
+    /** \brief a clamped_value that uses the smallest possible storage
+     *
+     * \tparam T   the integral type to operate on
+     * \tparam MIN the minimum legal value
+     * \tparam MAX the maximum legal value
+     */
+    template <typename T, T MIN, T MAX>
+    using compact_clamped_value =
+        constrained_value<T,
+                          compact_validator<clamping_validator<T, MIN, MAX>>>;
+
+    /** \brief a hash that maps every value a constrained_value can hold to a
+     *         distinct index
+     *
+     * The hash is the value's distance from the validator's minimum, so
+     * values map onto [0, size) with no collisions.  This is suitable for
+     * indexing a table directly (e.g., an std::array of size elements).
+     *
+     * \tparam CONSTRAINED a constrained_value whose validator has a range
+     */
+    template <typename CONSTRAINED>
+    struct perfect_hash
+    {
+        /// \cond false
+        using validator_type = typename CONSTRAINED::validator;
+        static_assert(internal::has_range<validator_type>::value,
+                      "A perfect hash requires a validator with a range");
+        static_assert(internal::range_span<validator_type>() <
+                          std::numeric_limits<std::size_t>::max(),
+                      "The range is too large to index");
+        /// \endcond
+
+        /// \brief the number of distinct hash values
+        static constexpr std::size_t size =
+            static_cast<std::size_t>(internal::range_span<validator_type>()) +
+            1;
+
+        /// \brief get the index of \a value
+        constexpr std::size_t operator()(CONSTRAINED const & value) const
+            noexcept
+        {
+            return static_cast<std::size_t>(
+                internal::range_offset<validator_type>(
+                    static_cast<typename CONSTRAINED::underlying_type>(value)));
+        }
+    };
+
+#if __cplusplus < 201703L
+    /// \cond false
+    template <typename CONSTRAINED>
+    constexpr std::size_t perfect_hash<CONSTRAINED>::size;
+    /// \endcond
+#endif
+
+    namespace internal
+    {
+        /** \brief determine if every value in [\a min, \a max] fits in \a T
+         *
+         * \tparam T the type to check
+         *
+         * \param min the lowest value in the range
+         * \param max the highest value in the range
+         */
+        template <typename T>
+        constexpr bool range_fits(std::intmax_t min, std::intmax_t max) noexcept
+        {
+            return (std::is_signed<T>::value
+                        ? (min >= static_cast<std::intmax_t>(
+                                      std::numeric_limits<T>::min()))
+                        : (min >= 0)) &&
+                   ((max < 0) ||
+                    (static_cast<std::uintmax_t>(max) <=
+                     static_cast<std::uintmax_t>(
+                         std::numeric_limits<T>::max())));
+        }
+
+        /** \brief get a validator's minimum as an std::intmax_t
+         *
+         * \tparam VALIDATOR a type derived from bounded_validator
+         */
+        template <typename VALIDATOR>
+        constexpr std::intmax_t range_min() noexcept
+        {
+            return static_cast<std::intmax_t>(VALIDATOR::min);
+        }
+
+        /** \brief get a validator's maximum as an std::intmax_t
+         *
+         * \tparam VALIDATOR a type derived from bounded_validator
+         */
+        template <typename VALIDATOR>
+        constexpr std::intmax_t range_max() noexcept
+        {
+            static_assert(
+                std::is_signed<typename VALIDATOR::type>::value ||
+                    (static_cast<std::uintmax_t>(VALIDATOR::max) <=
+                     static_cast<std::uintmax_t>(
+                         std::numeric_limits<std::intmax_t>::max())),
+                "Range is too large for bounded arithmetic");
+            return static_cast<std::intmax_t>(VALIDATOR::max);
+        }
+
+        constexpr std::intmax_t min_of(std::intmax_t a, std::intmax_t b,
+                                       std::intmax_t c,
+                                       std::intmax_t d) noexcept
+        {
+            return (a < b) ? ((a < c) ? ((a < d) ? a : d) : ((c < d) ? c : d))
+                           : ((b < c) ? ((b < d) ? b : d) : ((c < d) ? c : d));
+        }
+
+        constexpr std::intmax_t max_of(std::intmax_t a, std::intmax_t b,
+                                       std::intmax_t c,
+                                       std::intmax_t d) noexcept
+        {
+            return -min_of(-a, -b, -c, -d);
+        }
+
+        /** \brief the result of arithmetic between two bounded_values
+         *
+         * \tparam LHS the validator of the left-hand operand
+         * \tparam RHS the validator of the right-hand operand
+         * \tparam MIN the lowest possible result
+         * \tparam MAX the highest possible result
+         */
+        template <typename LHS, typename RHS, std::intmax_t MIN,
+                  std::intmax_t MAX>
+        struct arithmetic_range
+        {
+            using promoted_type = decltype(std::declval<typename LHS::type>() +
+                                           std::declval<typename RHS::type>());
+
+            /// \brief the integral type of the result
+            using type =
+                std::conditional_t<range_fits<promoted_type>(MIN, MAX),
+                                   promoted_type, std::intmax_t>;
+
+            /// \brief a type that can hold both operands and the result
+            using compute_type = std::conditional_t<
+                range_fits<type>(range_min<LHS>(), range_max<LHS>()) &&
+                    range_fits<type>(range_min<RHS>(), range_max<RHS>()),
+                type, std::intmax_t>;
+
+            /// \brief the bounded_value produced
+            using result_type = constrained_value<
+                type, exception_validator<type, static_cast<type>(MIN),
+                                          static_cast<type>(MAX)>>;
+        };
+
+        template <typename LHS, typename RHS>
+        struct add_range
+          : arithmetic_range<LHS, RHS, range_min<LHS>() + range_min<RHS>(),
+                             range_max<LHS>() + range_max<RHS>()>
+        {
+        };
+
+        template <typename LHS, typename RHS>
+        struct subtract_range
+          : arithmetic_range<LHS, RHS, range_min<LHS>() - range_max<RHS>(),
+                             range_max<LHS>() - range_min<RHS>()>
+        {
+        };
+
+        template <typename LHS, typename RHS>
+        struct multiply_range
+          : arithmetic_range<LHS, RHS,
+                             min_of(range_min<LHS>() * range_min<RHS>(),
+                                    range_min<LHS>() * range_max<RHS>(),
+                                    range_max<LHS>() * range_min<RHS>(),
+                                    range_max<LHS>() * range_max<RHS>()),
+                             max_of(range_min<LHS>() * range_min<RHS>(),
+                                    range_min<LHS>() * range_max<RHS>(),
+                                    range_max<LHS>() * range_min<RHS>(),
+                                    range_max<LHS>() * range_max<RHS>())>
+        {
+        };
+
+        template <typename RHS>
+        constexpr bool excludes_zero() noexcept
+        {
+            return (range_min<RHS>() > 0) || (range_max<RHS>() < 0);
+        }
+
+        // Division results are extreme at the corners of both ranges
+        // (provided the divisor can't change sign).  The divisor is replaced
+        // with 1 when it could be zero so the static_assert in operator/
+        // reports the problem instead of a constant-evaluation failure.
+        template <typename RHS>
+        constexpr std::intmax_t divisor_min() noexcept
+        {
+            return excludes_zero<RHS>() ? range_min<RHS>() : 1;
+        }
+
+        template <typename RHS>
+        constexpr std::intmax_t divisor_max() noexcept
+        {
+            return excludes_zero<RHS>() ? range_max<RHS>() : 1;
+        }
+
+        template <typename LHS, typename RHS>
+        struct divide_range
+          : arithmetic_range<LHS, RHS,
+                             min_of(range_min<LHS>() / divisor_min<RHS>(),
+                                    range_min<LHS>() / divisor_max<RHS>(),
+                                    range_max<LHS>() / divisor_min<RHS>(),
+                                    range_max<LHS>() / divisor_max<RHS>()),
+                             max_of(range_min<LHS>() / divisor_min<RHS>(),
+                                    range_min<LHS>() / divisor_max<RHS>(),
+                                    range_max<LHS>() / divisor_min<RHS>(),
+                                    range_max<LHS>() / divisor_max<RHS>())>
+        {
+        };
+
+        // The magnitude of a remainder is less than the magnitude of the
+        // divisor, and its sign follows the dividend.
+        template <typename RHS>
+        constexpr std::intmax_t remainder_limit() noexcept
+        {
+            return ((-divisor_min<RHS>() > divisor_max<RHS>())
+                        ? -divisor_min<RHS>()
+                        : divisor_max<RHS>()) -
+                   1;
+        }
+
+        template <typename LHS, typename RHS>
+        struct modulus_range
+          : arithmetic_range<
+                LHS, RHS,
+                (range_min<LHS>() >= 0)
+                    ? 0
+                    : ((range_min<LHS>() > -remainder_limit<RHS>())
+                           ? range_min<LHS>()
+                           : -remainder_limit<RHS>()),
+                (range_max<LHS>() <= 0)
+                    ? 0
+                    : ((range_max<LHS>() < remainder_limit<RHS>())
+                           ? range_max<LHS>()
+                           : remainder_limit<RHS>())>
+        {
+        };
+
+        template <typename LHS, typename RHS>
+        constexpr bool valid_shift() noexcept
+        {
+            return (range_min<LHS>() >= 0) && (range_min<RHS>() >= 0) &&
+                   (range_max<RHS>() <
+                    std::numeric_limits<std::intmax_t>::digits);
+        }
+
+        // Shifts are only supported for non-negative operands, so invalid
+        // ranges are replaced with 0 to let operator<< and operator>>
+        // report the problem through a static_assert.
+        template <typename RHS>
+        constexpr std::intmax_t shift_min() noexcept
+        {
+            return (range_min<RHS>() >= 0) ? range_min<RHS>() : 0;
+        }
+
+        template <typename LHS, typename RHS>
+        constexpr std::intmax_t shift_max() noexcept
+        {
+            return valid_shift<LHS, RHS>() ? range_max<RHS>() : 0;
+        }
+
+        template <typename LHS, typename RHS>
+        struct shift_left_range
+          : arithmetic_range<LHS, RHS,
+                             (range_min<LHS>() << shift_min<RHS>()),
+                             (range_max<LHS>() << shift_max<LHS, RHS>())>
+        {
+        };
+
+        template <typename LHS, typename RHS>
+        struct shift_right_range
+          : arithmetic_range<LHS, RHS,
+                             (range_min<LHS>() >> shift_max<LHS, RHS>()),
+                             (range_max<LHS>() >> shift_min<RHS>())>
+        {
+        };
+
+        struct shift_left
+        {
+            template <typename T>
+            constexpr T operator()(T lhs, T rhs) const noexcept
+            {
+                return lhs << rhs;
+            }
+        };
+
+        struct shift_right
+        {
+            template <typename T>
+            constexpr T operator()(T lhs, T rhs) const noexcept
+            {
+                return lhs >> rhs;
+            }
+        };
+
+        /** \brief perform arithmetic on two bounded_values
+         *
+         * \tparam RANGE an arithmetic_range describing the result
+         * \tparam OP    a function object that performs the operation
+         *
+         * The result is guaranteed to fall within RANGE, so it's constructed
+         * without validation.
+         */
+        template <template <typename, typename> class RANGE, typename OP,
+                  typename T1, T1 MIN1, T1 MAX1, typename T2, T2 MIN2,
+                  T2 MAX2>
+        constexpr auto bounded_arithmetic(
+            constrained_value<T1, exception_validator<T1, MIN1, MAX1>> const &
+                lhs,
+            constrained_value<T2, exception_validator<T2, MIN2, MAX2>> const &
+                rhs) noexcept
+        {
+            using range = RANGE<exception_validator<T1, MIN1, MAX1>,
+                                exception_validator<T2, MIN2, MAX2>>;
+            using compute_type = typename range::compute_type;
+            return typename range::result_type{
+                prevalidated,
+                static_cast<typename range::type>(
+                    OP{}(static_cast<compute_type>(static_cast<T1>(lhs)),
+                         static_cast<compute_type>(static_cast<T2>(rhs))))};
+        }
+    } // namespace internal
+
+    /** \brief add two bounded_values
+     *
+     * The result is a bounded_value whose range is computed at compile time
+     * from the operands' ranges (e.g., [0, 10] + [0, 5] produces [0, 15]).
+     * The result's type is the usual promoted type unless the range doesn't
+     * fit, in which case std::intmax_t is used.  Since the result can't fall
+     * outside its range, no runtime validation is performed.
+     */
+    template <typename T1, T1 MIN1, T1 MAX1, typename T2, T2 MIN2, T2 MAX2>
+    constexpr auto operator+(bounded_value<T1, MIN1, MAX1> const & lhs,
+                             bounded_value<T2, MIN2, MAX2> const & rhs) noexcept
+    {
+        return internal::bounded_arithmetic<internal::add_range, std::plus<>>(
+            lhs, rhs);
+    }
+
+    /** \brief subtract two bounded_values
+     *
+     * See operator+ for details on the result.
+     */
+    template <typename T1, T1 MIN1, T1 MAX1, typename T2, T2 MIN2, T2 MAX2>
+    constexpr auto operator-(bounded_value<T1, MIN1, MAX1> const & lhs,
+                             bounded_value<T2, MIN2, MAX2> const & rhs) noexcept
+    {
+        return internal::bounded_arithmetic<internal::subtract_range,
+                                            std::minus<>>(lhs, rhs);
+    }
+
+    /** \brief multiply two bounded_values
+     *
+     * See operator+ for details on the result.
+     */
+    template <typename T1, T1 MIN1, T1 MAX1, typename T2, T2 MIN2, T2 MAX2>
+    constexpr auto operator*(bounded_value<T1, MIN1, MAX1> const & lhs,
+                             bounded_value<T2, MIN2, MAX2> const & rhs) noexcept
+    {
+        return internal::bounded_arithmetic<internal::multiply_range,
+                                            std::multiplies<>>(lhs, rhs);
+    }
+
+    /** \brief divide two bounded_values
+     *
+     * See operator+ for details on the result.  The range of \a rhs can't
+     * include zero.
+     */
+    template <typename T1, T1 MIN1, T1 MAX1, typename T2, T2 MIN2, T2 MAX2>
+    constexpr auto operator/(bounded_value<T1, MIN1, MAX1> const & lhs,
+                             bounded_value<T2, MIN2, MAX2> const & rhs) noexcept
+    {
+        static_assert(
+            internal::excludes_zero<exception_validator<T2, MIN2, MAX2>>(),
+            "Divisor range includes zero");
+        return internal::bounded_arithmetic<internal::divide_range,
+                                            std::divides<>>(lhs, rhs);
+    }
+
+    /** \brief get the remainder of dividing two bounded_values
+     *
+     * See operator+ for details on the result.  The range of \a rhs can't
+     * include zero.
+     */
+    template <typename T1, T1 MIN1, T1 MAX1, typename T2, T2 MIN2, T2 MAX2>
+    constexpr auto operator%(bounded_value<T1, MIN1, MAX1> const & lhs,
+                             bounded_value<T2, MIN2, MAX2> const & rhs) noexcept
+    {
+        static_assert(
+            internal::excludes_zero<exception_validator<T2, MIN2, MAX2>>(),
+            "Divisor range includes zero");
+        return internal::bounded_arithmetic<internal::modulus_range,
+                                            std::modulus<>>(lhs, rhs);
+    }
+
+    /** \brief shift a bounded_value left
+     *
+     * See operator+ for details on the result.  Both ranges must be
+     * non-negative, and \a rhs must be less-than the number of bits in
+     * std::intmax_t.
+     */
+    template <typename T1, T1 MIN1, T1 MAX1, typename T2, T2 MIN2, T2 MAX2>
+    constexpr auto
+    operator<<(bounded_value<T1, MIN1, MAX1> const & lhs,
+               bounded_value<T2, MIN2, MAX2> const & rhs) noexcept
+    {
+        static_assert(
+            internal::valid_shift<exception_validator<T1, MIN1, MAX1>,
+                                  exception_validator<T2, MIN2, MAX2>>(),
+            "Shift operands must be non-negative and in range");
+        return internal::bounded_arithmetic<internal::shift_left_range,
+                                            internal::shift_left>(lhs, rhs);
+    }
+
+    /** \brief shift a bounded_value right
+     *
+     * See operator<< for restrictions.
+     */
+    template <typename T1, T1 MIN1, T1 MAX1, typename T2, T2 MIN2, T2 MAX2>
+    constexpr auto
+    operator>>(bounded_value<T1, MIN1, MAX1> const & lhs,
+               bounded_value<T2, MIN2, MAX2> const & rhs) noexcept
+    {
+        static_assert(
+            internal::valid_shift<exception_validator<T1, MIN1, MAX1>,
+                                  exception_validator<T2, MIN2, MAX2>>(),
+            "Shift operands must be non-negative and in range");
+        return internal::bounded_arithmetic<internal::shift_right_range,
+                                            internal::shift_right>(lhs, rhs);
+    }
+
+    namespace internal
+    {
+#if defined(__GNUC__)
+        template <typename T>
+        constexpr bool add_overflow(T lhs, T rhs, T & result) noexcept
+        {
+            return __builtin_add_overflow(lhs, rhs, &result);
+        }
+
+        template <typename T>
+        constexpr bool subtract_overflow(T lhs, T rhs, T & result) noexcept
+        {
+            return __builtin_sub_overflow(lhs, rhs, &result);
+        }
+
+        template <typename T>
+        constexpr bool multiply_overflow(T lhs, T rhs, T & result) noexcept
+        {
+            return __builtin_mul_overflow(lhs, rhs, &result);
+        }
+#else
+        // Portable equivalents of the GCC/Clang overflow builtins.  Signed
+        // results are computed with unsigned (wrapping) arithmetic, and
+        // overflow is detected from the signs of the operands and result.
+        template <typename T>
+        constexpr bool add_overflow(T lhs, T rhs, T & result) noexcept
+        {
+            using unsigned_type = std::make_unsigned_t<T>;
+            result = static_cast<T>(static_cast<unsigned_type>(
+                static_cast<unsigned_type>(lhs) +
+                static_cast<unsigned_type>(rhs)));
+            return std::is_signed<T>::value
+                       ? (cmp_less(rhs, 0) ? (result > lhs) : (result < lhs))
+                       : (result < lhs);
+        }
+
+        template <typename T>
+        constexpr bool subtract_overflow(T lhs, T rhs, T & result) noexcept
+        {
+            using unsigned_type = std::make_unsigned_t<T>;
+            result = static_cast<T>(static_cast<unsigned_type>(
+                static_cast<unsigned_type>(lhs) -
+                static_cast<unsigned_type>(rhs)));
+            return std::is_signed<T>::value
+                       ? (cmp_less(rhs, 0) ? (result < lhs) : (result > lhs))
+                       : (lhs < rhs);
+        }
+
+        template <typename T>
+        constexpr std::make_unsigned_t<T> unsigned_magnitude(T value) noexcept
+        {
+            using unsigned_type = std::make_unsigned_t<T>;
+            return cmp_less(value, 0)
+                       ? static_cast<unsigned_type>(
+                             unsigned_type{0} -
+                             static_cast<unsigned_type>(value))
+                       : static_cast<unsigned_type>(value);
+        }
+
+        template <typename T>
+        constexpr bool multiply_overflow(T lhs, T rhs, T & result) noexcept
+        {
+            using unsigned_type = std::make_unsigned_t<T>;
+            auto const negative = cmp_less(lhs, 0) != cmp_less(rhs, 0);
+            auto const lhs_magnitude = unsigned_magnitude(lhs);
+            auto const rhs_magnitude = unsigned_magnitude(rhs);
+            // the largest magnitude that fits in T with the result's sign
+            auto const limit = static_cast<unsigned_type>(
+                negative ? (static_cast<unsigned_type>(
+                                std::numeric_limits<T>::max()) +
+                            (std::is_signed<T>::value ? 1 : 0))
+                         : static_cast<unsigned_type>(
+                               std::numeric_limits<T>::max()));
+            auto const product = static_cast<unsigned_type>(
+                static_cast<std::uintmax_t>(lhs_magnitude) * rhs_magnitude);
+            result = static_cast<T>(
+                negative ? static_cast<unsigned_type>(unsigned_type{0} -
+                                                      product)
+                         : product);
+            return (lhs_magnitude != 0) &&
+                   (rhs_magnitude > limit / lhs_magnitude);
+        }
+#endif
+
+        /** \brief clamp \a value to [MIN, MAX] using only min and max
+         *         operations
+         */
+        template <typename T, T MIN, T MAX, typename U>
+        constexpr T saturate(U value) noexcept
+        {
+            return static_cast<T>(
+                (value < static_cast<U>(MIN))
+                    ? static_cast<U>(MIN)
+                    : ((value > static_cast<U>(MAX)) ? static_cast<U>(MAX)
+                                                     : value));
+        }
+
+        /** \brief determine if saturating arithmetic on T can compute exact
+         *         results
+         *
+         * If int is at least twice as wide as T, every sum, difference, and
+         * product of two T values fits in int (or unsigned, for unsigned
+         * products), so the exact result can be clamped directly.  This is
+         * the form compilers turn into saturating vector instructions.
+         * Wider types are computed in T with overflow detection.
+         */
+        template <typename T>
+        constexpr bool saturate_exactly() noexcept
+        {
+            return (sizeof(T) * 2) <= sizeof(int);
+        }
+
+        /** \brief determine if every sum and difference of two values in
+         *         [MIN, MAX] is representable as T
+         *
+         * Ranges that use at most half of T's range can't overflow, so
+         * arithmetic can be done directly in T and clamped without overflow
+         * detection.  Differences of unsigned values can be negative, so
+         * they're only covered for signed types.
+         */
+        template <typename T, T MIN, T MAX>
+        constexpr bool sums_fit() noexcept
+        {
+            return (MIN >= std::numeric_limits<T>::min() / 2) &&
+                   (MAX <= std::numeric_limits<T>::max() / 2);
+        }
+
+        template <typename T, T MIN, T MAX>
+        constexpr T saturating_add(T lhs, T rhs, std::true_type) noexcept
+        {
+            return saturate<T, MIN, MAX>(static_cast<int>(lhs) +
+                                         static_cast<int>(rhs));
+        }
+
+        template <typename T, T MIN, T MAX>
+        constexpr T saturating_add(T lhs, T rhs, std::false_type) noexcept
+        {
+            if(sums_fit<T, MIN, MAX>())
+            {
+                return saturate<T, MIN, MAX>(static_cast<T>(lhs + rhs));
+            }
+            T result{};
+            // An overflowing sum is past the bound in rhs's direction.
+            return add_overflow(lhs, rhs, result)
+                       ? (cmp_less(rhs, 0) ? MIN : MAX)
+                       : saturate<T, MIN, MAX>(result);
+        }
+
+        template <typename T, T MIN, T MAX>
+        constexpr T saturating_subtract(T lhs, T rhs,
+                                        std::true_type) noexcept
+        {
+            return saturate<T, MIN, MAX>(static_cast<int>(lhs) -
+                                         static_cast<int>(rhs));
+        }
+
+        template <typename T, T MIN, T MAX>
+        constexpr T saturating_subtract(T lhs, T rhs,
+                                        std::false_type) noexcept
+        {
+            if(std::is_signed<T>::value && sums_fit<T, MIN, MAX>())
+            {
+                return saturate<T, MIN, MAX>(static_cast<T>(lhs - rhs));
+            }
+            T result{};
+            return subtract_overflow(lhs, rhs, result)
+                       ? (cmp_less(rhs, 0) ? MAX : MIN)
+                       : saturate<T, MIN, MAX>(result);
+        }
+
+        template <typename T, T MIN, T MAX>
+        constexpr T saturating_multiply(T lhs, T rhs,
+                                        std::true_type) noexcept
+        {
+            using compute_type =
+                std::conditional_t<std::is_signed<T>::value, int, unsigned>;
+            return saturate<T, MIN, MAX>(static_cast<compute_type>(lhs) *
+                                         static_cast<compute_type>(rhs));
+        }
+
+        template <typename T, T MIN, T MAX>
+        constexpr T saturating_multiply(T lhs, T rhs,
+                                        std::false_type) noexcept
+        {
+            T result{};
+            return multiply_overflow(lhs, rhs, result)
+                       ? ((cmp_less(lhs, 0) != cmp_less(rhs, 0)) ? MIN : MAX)
+                       : saturate<T, MIN, MAX>(result);
+        }
+
+        /// \brief add two values, clamping the exact sum to [MIN, MAX]
+        template <typename T, T MIN, T MAX>
+        constexpr T saturating_add(T lhs, T rhs) noexcept
+        {
+            return saturating_add<T, MIN, MAX>(
+                lhs, rhs,
+                std::integral_constant<bool, saturate_exactly<T>()>{});
+        }
+
+        /// \brief subtract two values, clamping the exact difference to
+        ///        [MIN, MAX]
+        template <typename T, T MIN, T MAX>
+        constexpr T saturating_subtract(T lhs, T rhs) noexcept
+        {
+            return saturating_subtract<T, MIN, MAX>(
+                lhs, rhs,
+                std::integral_constant<bool, saturate_exactly<T>()>{});
+        }
+
+        /// \brief multiply two values, clamping the exact product to
+        ///        [MIN, MAX]
+        template <typename T, T MIN, T MAX>
+        constexpr T saturating_multiply(T lhs, T rhs) noexcept
+        {
+            return saturating_multiply<T, MIN, MAX>(
+                lhs, rhs,
+                std::integral_constant<bool, saturate_exactly<T>()>{});
+        }
+    } // namespace internal
+
+    /** \brief add two clamped_values
+     *
+     * The exact sum is clamped to the validator's range, so the result
+     * saturates instead of overflowing T.  No branches are required: narrow
+     * types are computed exactly in int, ranges using at most half of T are
+     * computed directly in T, and anything else uses overflow detection (the
+     * compiler's overflow builtins where available) followed by min/max.
+     *
+     * This applies to any constrained_value whose validator clamps (e.g.,
+     * compact_clamped_value, or an instrumented clamping_validator).  The
+     * result is clamped directly, so it isn't passed through the validator.
+     */
+    template <typename T, typename VALIDATOR,
+              typename = std::enable_if_t<internal::clamps<VALIDATOR>::value>>
+    constexpr constrained_value<T, VALIDATOR>
+    operator+(constrained_value<T, VALIDATOR> const & lhs,
+              constrained_value<T, VALIDATOR> const & rhs) noexcept
+    {
+        return constrained_value<T, VALIDATOR>{
+            internal::prevalidated,
+            internal::saturating_add<T, VALIDATOR::min, VALIDATOR::max>(
+                static_cast<T>(lhs), static_cast<T>(rhs))};
+    }
+
+    /** \brief subtract two clamped_values
+     *
+     * See operator+ for details.
+     */
+    template <typename T, typename VALIDATOR,
+              typename = std::enable_if_t<internal::clamps<VALIDATOR>::value>>
+    constexpr constrained_value<T, VALIDATOR>
+    operator-(constrained_value<T, VALIDATOR> const & lhs,
+              constrained_value<T, VALIDATOR> const & rhs) noexcept
+    {
+        return constrained_value<T, VALIDATOR>{
+            internal::prevalidated,
+            internal::saturating_subtract<T, VALIDATOR::min, VALIDATOR::max>(
+                static_cast<T>(lhs), static_cast<T>(rhs))};
+    }
+
+    /** \brief multiply two clamped_values
+     *
+     * See operator+ for details.
+     */
+    template <typename T, typename VALIDATOR,
+              typename = std::enable_if_t<internal::clamps<VALIDATOR>::value>>
+    constexpr constrained_value<T, VALIDATOR>
+    operator*(constrained_value<T, VALIDATOR> const & lhs,
+              constrained_value<T, VALIDATOR> const & rhs) noexcept
+    {
+        return constrained_value<T, VALIDATOR>{
+            internal::prevalidated,
+            internal::saturating_multiply<T, VALIDATOR::min, VALIDATOR::max>(
+                static_cast<T>(lhs), static_cast<T>(rhs))};
+    }
 } // namespace houseguest
 
 namespace std
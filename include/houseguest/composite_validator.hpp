@@ -0,0 +1,669 @@
+#ifndef HOUSEGUEST_COMPOSITE_VALIDATOR_HPP
+#define HOUSEGUEST_COMPOSITE_VALIDATOR_HPP 1
+
+#include <initializer_list>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include <houseguest/bounded_value.hpp>
+#include <houseguest/constrained_value.hpp>
+
+/** \file
+ *
+ * \brief Validators for common constraints, and ways to combine them
+ *
+ * Validators here follow a common protocol so they can be combined with
+ * all_of and any_of:
+ * - \a type is the integral type being validated
+ * - a static, constexpr \a test function reports whether a value is
+ *   acceptable
+ * - a \a check function reports why a value isn't acceptable (as something
+ *   convertible to std::error_code)
+ * - calling the validator returns acceptable values and throws an
+ *   std::system_error for anything else
+ *
+ * Validators that can be expressed as <tt>(value & mask) == pattern</tt>
+ * additionally expose \a mask and \a pattern.  Range validators (e.g.,
+ * exception_validator) can also be combined; they're recognized with
+ * is_range_validator.
+ *
+ * all_of merges the masks and ranges of its components at compile time, so
+ * something like all_of<even, multiple of 8, [0, 1024]> tests a value with a
+ * single masked compare and a single unsigned range compare.
+ */
+
+namespace houseguest
+{
+    /// \brief reasons a constraint can reject a value
+    enum class constraint_error
+    {
+        success = 0,
+        wrong_parity,
+        not_multiple,
+        not_power_of_two,
+        no_match,
+        not_member
+    };
+
+    /// \brief an error category for constraint_error
+    struct constraint_error_category : std::error_category
+    {
+        /// \brief get name of error category
+        const char * name() const noexcept override
+        {
+            return "houseguest::constraint";
+        }
+
+        /// \brief get message from error value
+        std::string message(int ev) const override
+        {
+            switch(static_cast<constraint_error>(ev))
+            {
+            case constraint_error::success:
+                return "success";
+                break;
+
+            case constraint_error::wrong_parity:
+                return "value has the wrong parity";
+                break;
+
+            case constraint_error::not_multiple:
+                return "value is not a multiple of the required factor";
+                break;
+
+            case constraint_error::not_power_of_two:
+                return "value is not a power of two";
+                break;
+
+            case constraint_error::no_match:
+                return "value does not satisfy any constraint";
+                break;
+
+            case constraint_error::not_member:
+                return "value is not in the set of allowed values";
+                break;
+
+            default:
+                return "(unknown error)";
+                break;
+            }
+        }
+    };
+
+    namespace internal
+    {
+        inline std::error_code
+        make_constraint_error_code(constraint_error error)
+        {
+            static constraint_error_category const category_instance{};
+            return std::error_code{static_cast<int>(error), category_instance};
+        }
+    } // namespace internal
+
+    /** \brief create an std::error_code from a constraint_error
+     *
+     * This lets a constraint_error convert to std::error_code implicitly.
+     *
+     * \param error the error to convert
+     */
+    inline std::error_code make_error_code(constraint_error error)
+    {
+        return internal::make_constraint_error_code(error);
+    }
+
+    namespace internal
+    {
+        /** \brief determine if a validator is expressed as a mask
+         *
+         * Validators with \a mask and \a pattern members accept exactly the
+         * values where <tt>(value & mask) == pattern</tt>.
+         */
+        template <typename VALIDATOR, typename = void>
+        struct has_mask : std::false_type
+        {
+        };
+
+        /// \cond false
+        template <typename VALIDATOR>
+        struct has_mask<VALIDATOR,
+                        typename make_void<decltype(VALIDATOR::mask),
+                                           decltype(VALIDATOR::pattern)>::type>
+          : std::true_type
+        {
+        };
+        /// \endcond
+
+        /** \brief a constraint that requires <tt>(value & MASK) ==
+         *         PATTERN</tt>
+         *
+         * \tparam T       the integral type to operate on
+         * \tparam MASK    the bits to check
+         * \tparam PATTERN the required value of those bits
+         */
+        template <typename T, std::make_unsigned_t<T> MASK,
+                  std::make_unsigned_t<T> PATTERN>
+        struct mask_constraint
+        {
+            static_assert(std::is_integral<T>::value, "T must be integral");
+            static_assert((PATTERN & ~MASK) == 0,
+                          "PATTERN can't set bits outside MASK");
+
+            /// \brief the integral type being validated
+            using type = T;
+
+            /// \brief the bits that are checked
+            static constexpr std::make_unsigned_t<T> mask = MASK;
+
+            /// \brief the required value of the checked bits
+            static constexpr std::make_unsigned_t<T> pattern = PATTERN;
+
+            /// \brief determine if \a value is acceptable
+            static constexpr bool test(T value) noexcept
+            {
+                return (static_cast<std::make_unsigned_t<T>>(value) & MASK) ==
+                       PATTERN;
+            }
+        };
+
+        /// \brief a constraint that requires a value be a multiple of \a N
+        template <typename T, T N>
+        struct modulo_constraint
+        {
+            /// \brief the integral type being validated
+            using type = T;
+
+            /// \brief determine if \a value is acceptable
+            static constexpr bool test(T value) noexcept
+            {
+                return (value % N) == 0;
+            }
+        };
+
+        /** \brief pass \a value through a validator that follows the
+         *         composite protocol
+         *
+         * \throw std::system_error if \a validator rejects \a value
+         */
+        template <typename VALIDATOR>
+        constexpr typename VALIDATOR::type
+        apply_constraint(VALIDATOR const & validator,
+                         typename VALIDATOR::type value)
+        {
+            if(!VALIDATOR::test(value))
+            {
+                throw std::system_error{
+                    std::error_code{validator.check(value)}};
+            }
+            return value;
+        }
+    } // namespace internal
+
+    /** \brief a validator that requires values be a multiple of \a N
+     *
+     * If \a N is a power of two, this is a mask validator (and will be fused
+     * with other masks by all_of).
+     *
+     * \tparam T the integral type to operate on
+     * \tparam N the required factor.  \a N must be positive.
+     */
+    template <typename T, T N>
+    struct multiple_of_validator
+      : std::conditional_t<
+            ((N & (N - 1)) == 0),
+            internal::mask_constraint<
+                T, static_cast<std::make_unsigned_t<T>>(N - 1), 0>,
+            internal::modulo_constraint<T, N>>
+    {
+        static_assert(N > 0, "N must be positive");
+
+        /** \brief check if \a value is a multiple of N
+         *
+         * \retval constraint_error::success      \a value is acceptable
+         * \retval constraint_error::not_multiple \a value isn't acceptable
+         */
+        constexpr constraint_error check(T value) const noexcept
+        {
+            return multiple_of_validator::test(value)
+                       ? constraint_error::success
+                       : constraint_error::not_multiple;
+        }
+
+        /** \brief validate \a value is a multiple of N
+         *
+         * \throw std::system_error if \a value isn't a multiple of N
+         */
+        constexpr T operator()(T value) const
+        {
+            return internal::apply_constraint(*this, value);
+        }
+    };
+
+    /** \brief a validator that requires values be a power of two
+     *
+     * \tparam T the integral type to operate on
+     */
+    template <typename T>
+    struct power_of_two_validator
+    {
+        static_assert(std::is_integral<T>::value, "T must be integral");
+
+        /// \brief the integral type being validated
+        using type = T;
+
+        /// \brief determine if \a value is acceptable
+        static constexpr bool test(T value) noexcept
+        {
+            using unsigned_type = std::make_unsigned_t<T>;
+            auto const bits = static_cast<unsigned_type>(value);
+            // non-short-circuiting so there's nothing to branch on
+            return internal::cmp_less(0, value) &
+                   ((bits & static_cast<unsigned_type>(bits - 1)) == 0);
+        }
+
+        /** \brief check if \a value is a power of two
+         *
+         * \retval constraint_error::success          \a value is acceptable
+         * \retval constraint_error::not_power_of_two \a value isn't acceptable
+         */
+        constexpr constraint_error check(T value) const noexcept
+        {
+            return test(value) ? constraint_error::success
+                               : constraint_error::not_power_of_two;
+        }
+
+        /** \brief validate \a value is a power of two
+         *
+         * \throw std::system_error if \a value isn't a power of two
+         */
+        constexpr T operator()(T value) const
+        {
+            return internal::apply_constraint(*this, value);
+        }
+    };
+
+    namespace internal
+    {
+        template <typename T>
+        constexpr T fold_min(std::initializer_list<T> values) noexcept
+        {
+            auto result = std::numeric_limits<T>::max();
+            for(auto value : values)
+            {
+                result = (value < result) ? value : result;
+            }
+            return result;
+        }
+
+        template <typename T>
+        constexpr T fold_max(std::initializer_list<T> values) noexcept
+        {
+            auto result = std::numeric_limits<T>::min();
+            for(auto value : values)
+            {
+                result = (value > result) ? value : result;
+            }
+            return result;
+        }
+
+        template <typename T>
+        constexpr T fold_or(std::initializer_list<T> values) noexcept
+        {
+            T result = 0;
+            for(auto value : values)
+            {
+                result |= value;
+            }
+            return result;
+        }
+
+        constexpr bool fold_and(std::initializer_list<bool> values) noexcept
+        {
+            bool result = true;
+            for(auto value : values)
+            {
+                result &= value;
+            }
+            return result;
+        }
+
+        constexpr bool fold_any(std::initializer_list<bool> values) noexcept
+        {
+            bool result = false;
+            for(auto value : values)
+            {
+                result |= value;
+            }
+            return result;
+        }
+
+        /// \brief determine if mask/pattern pairs can all be satisfied
+        template <typename T>
+        constexpr bool masks_compatible(std::initializer_list<T> masks,
+                                        std::initializer_list<T> patterns)
+        {
+            T seen_mask = 0;
+            T seen_pattern = 0;
+            auto pattern = patterns.begin();
+            for(auto mask : masks)
+            {
+                if(((seen_pattern ^ *pattern) & seen_mask & mask) != 0)
+                {
+                    return false;
+                }
+                seen_mask |= mask;
+                seen_pattern |= *pattern;
+                ++pattern;
+            }
+            return true;
+        }
+
+        /// \brief a component's range, or the full range of \a T
+        template <typename T, typename VALIDATOR,
+                  bool = has_range<VALIDATOR>::value>
+        struct component_range
+        {
+            static constexpr T min = std::numeric_limits<T>::min();
+            static constexpr T max = std::numeric_limits<T>::max();
+        };
+
+        /// \cond false
+        template <typename T, typename VALIDATOR>
+        struct component_range<T, VALIDATOR, true>
+        {
+            static constexpr T min = VALIDATOR::min;
+            static constexpr T max = VALIDATOR::max;
+        };
+        /// \endcond
+
+        /// \brief a component's mask and pattern, or a mask that accepts
+        ///        everything
+        template <typename T, typename VALIDATOR,
+                  bool = has_mask<VALIDATOR>::value>
+        struct component_mask
+        {
+            static constexpr std::make_unsigned_t<T> mask = 0;
+            static constexpr std::make_unsigned_t<T> pattern = 0;
+        };
+
+        /// \cond false
+        template <typename T, typename VALIDATOR>
+        struct component_mask<T, VALIDATOR, true>
+        {
+            static constexpr std::make_unsigned_t<T> mask = VALIDATOR::mask;
+            static constexpr std::make_unsigned_t<T> pattern =
+                VALIDATOR::pattern;
+        };
+        /// \endcond
+
+        /** \brief determine if a component is completely described by its
+         *         range or mask
+         *
+         * all_of doesn't need to call test on these components, since their
+         * range or mask is folded into its own.
+         */
+        template <typename VALIDATOR>
+        struct is_fused
+          : std::integral_constant<bool, is_range_validator<VALIDATOR>::value ||
+                                             has_mask<VALIDATOR>::value>
+        {
+        };
+
+        template <typename VALIDATOR>
+        constexpr bool unfused_test(typename VALIDATOR::type, std::true_type)
+        {
+            return true;
+        }
+
+        template <typename VALIDATOR>
+        constexpr bool unfused_test(typename VALIDATOR::type value,
+                                    std::false_type)
+        {
+            return VALIDATOR::test(value);
+        }
+
+        template <typename VALIDATOR>
+        constexpr bool passes(typename VALIDATOR::type value, std::true_type)
+        {
+            return range_offset<VALIDATOR>(value) <= range_span<VALIDATOR>();
+        }
+
+        template <typename VALIDATOR>
+        constexpr bool passes(typename VALIDATOR::type value, std::false_type)
+        {
+            return VALIDATOR::test(value);
+        }
+
+        /** \brief determine if a component accepts \a value
+         *
+         * Range validators don't provide test, so they're checked using
+         * their range.
+         */
+        template <typename VALIDATOR>
+        constexpr bool passes(typename VALIDATOR::type value)
+        {
+            return passes<VALIDATOR>(value,
+                                     is_range_validator<VALIDATOR>{});
+        }
+
+        /// \brief the members shared by composite validators
+        template <typename T, bool HAS_RANGE, T MIN, T MAX>
+        struct composite_base
+        {
+            /// \brief the integral type being validated
+            using type = T;
+        };
+
+        /// \cond false
+        template <typename T, T MIN, T MAX>
+        struct composite_base<T, true, MIN, MAX>
+          : bounded_validator<T, MIN, MAX>
+        {
+        };
+        /// \endcond
+
+        template <typename VALIDATOR, typename... VALIDATORS>
+        struct all_of_traits
+        {
+            using type = typename VALIDATOR::type;
+            using unsigned_type = std::make_unsigned_t<type>;
+
+            static_assert(fold_and({std::is_same<
+                              type, typename VALIDATORS::type>::value...}),
+                          "Validators must share a type");
+
+            static constexpr bool ranged = fold_any(
+                {internal::has_range<VALIDATOR>::value,
+                 internal::has_range<VALIDATORS>::value...});
+
+            static constexpr type min =
+                fold_max({component_range<type, VALIDATOR>::min,
+                          component_range<type, VALIDATORS>::min...});
+
+            static constexpr type max =
+                fold_min({component_range<type, VALIDATOR>::max,
+                          component_range<type, VALIDATORS>::max...});
+
+            static_assert(min <= max, "Validator ranges don't overlap");
+
+            static constexpr unsigned_type mask =
+                fold_or({component_mask<type, VALIDATOR>::mask,
+                         component_mask<type, VALIDATORS>::mask...});
+
+            static constexpr unsigned_type pattern =
+                fold_or({component_mask<type, VALIDATOR>::pattern,
+                         component_mask<type, VALIDATORS>::pattern...});
+
+            static_assert(
+                masks_compatible(
+                    {component_mask<type, VALIDATOR>::mask,
+                     component_mask<type, VALIDATORS>::mask...},
+                    {component_mask<type, VALIDATOR>::pattern,
+                     component_mask<type, VALIDATORS>::pattern...}),
+                "Validator masks can't be satisfied together");
+
+            using base = composite_base<type, ranged, min, max>;
+        };
+
+        template <typename VALIDATOR, typename... VALIDATORS>
+        struct any_of_traits
+        {
+            using type = typename VALIDATOR::type;
+
+            static_assert(fold_and({std::is_same<
+                              type, typename VALIDATORS::type>::value...}),
+                          "Validators must share a type");
+
+            // a range is only known if every component has one
+            static constexpr bool ranged =
+                fold_and({internal::has_range<VALIDATOR>::value,
+                          internal::has_range<VALIDATORS>::value...});
+
+            static constexpr type min =
+                fold_min({component_range<type, VALIDATOR>::min,
+                          component_range<type, VALIDATORS>::min...});
+
+            static constexpr type max =
+                fold_max({component_range<type, VALIDATOR>::max,
+                          component_range<type, VALIDATORS>::max...});
+
+            using base = composite_base<type, ranged, min, max>;
+        };
+    } // namespace internal
+
+    /** \brief a validator that requires values satisfy every one of
+     *         \a VALIDATORS
+     *
+     * Masks and ranges of the components are combined at compile time:
+     * test performs a single masked compare, a single unsigned range compare,
+     * and calls test for any components that can't be expressed either way.
+     * None of these short-circuit, so there's nothing to branch on.
+     *
+     * If any component has a range, all_of has a range (the intersection of
+     * every component's range).  Since the range doesn't capture the other
+     * constraints, all_of is never a range validator.
+     *
+     * \tparam VALIDATORS validators following the protocol described in
+     *                    composite_validator.hpp.  Every component must share
+     *                    the same type.
+     */
+    template <typename... VALIDATORS>
+    struct all_of : internal::all_of_traits<VALIDATORS...>::base
+    {
+    private:
+        using traits = internal::all_of_traits<VALIDATORS...>;
+        using unsigned_type = typename traits::unsigned_type;
+
+    public:
+        /// \brief the integral type being validated
+        using type = typename traits::type;
+
+        /// \brief determine if \a value is acceptable
+        static constexpr bool test(type value) noexcept
+        {
+            auto const bits = static_cast<unsigned_type>(value);
+            auto const offset =
+                static_cast<unsigned_type>(bits - static_cast<unsigned_type>(
+                                                      traits::min));
+            auto const span = static_cast<unsigned_type>(
+                static_cast<unsigned_type>(traits::max) -
+                static_cast<unsigned_type>(traits::min));
+            return ((bits & traits::mask) == traits::pattern) &
+                   (offset <= span) &
+                   internal::fold_and({internal::unfused_test<VALIDATORS>(
+                       value, internal::is_fused<VALIDATORS>{})...});
+        }
+
+        /** \brief check if \a value is acceptable
+         *
+         * \return An empty error if \a value is acceptable, otherwise the
+         *         error reported by the first component that rejects it.
+         */
+        std::error_code check(type value) const noexcept
+        {
+            if(test(value))
+            {
+                return std::error_code{};
+            }
+            for(auto const & error :
+                {std::error_code{VALIDATORS{}.check(value)}...})
+            {
+                if(error)
+                {
+                    return error;
+                }
+            }
+            return internal::make_constraint_error_code(
+                constraint_error::no_match);
+        }
+
+        /** \brief validate \a value
+         *
+         * \throw std::system_error if any component rejects \a value
+         */
+        constexpr type operator()(type value) const
+        {
+            return internal::apply_constraint(*this, value);
+        }
+    };
+
+    /** \brief a validator that requires values satisfy at least one of
+     *         \a VALIDATORS
+     *
+     * Every component is tested without short-circuiting.  If every
+     * component has a range, any_of's range covers all of them.
+     *
+     * \tparam VALIDATORS validators following the protocol described in
+     *                    composite_validator.hpp.  Every component must share
+     *                    the same type.
+     */
+    template <typename... VALIDATORS>
+    struct any_of : internal::any_of_traits<VALIDATORS...>::base
+    {
+    private:
+        using traits = internal::any_of_traits<VALIDATORS...>;
+
+    public:
+        /// \brief the integral type being validated
+        using type = typename traits::type;
+
+        /// \brief determine if \a value is acceptable
+        static constexpr bool test(type value) noexcept
+        {
+            return internal::fold_any(
+                {internal::passes<VALIDATORS>(value)...});
+        }
+
+        /** \brief check if \a value is acceptable
+         *
+         * \retval constraint_error::success  \a value is acceptable
+         * \retval constraint_error::no_match no component accepts \a value
+         */
+        constexpr constraint_error check(type value) const noexcept
+        {
+            return test(value) ? constraint_error::success
+                               : constraint_error::no_match;
+        }
+
+        /** \brief validate \a value
+         *
+         * \throw std::system_error if no component accepts \a value
+         */
+        constexpr type operator()(type value) const
+        {
+            return internal::apply_constraint(*this, value);
+        }
+    };
+} // namespace houseguest
+
+namespace std
+{
+    /// \brief specialization for constraint_error
+    template <>
+    struct is_error_code_enum<houseguest::constraint_error> : true_type
+    {
+    };
+} // namespace std
+
+#endif
@@ -0,0 +1,621 @@
+#ifndef HOUSEGUEST_CONCURRENT_CACHE_HPP
+#define HOUSEGUEST_CONCURRENT_CACHE_HPP 1
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <houseguest/lock.hpp>
+#include <houseguest/mutex.hpp>
+
+/** \file
+ *
+ * \brief A fixed-size, thread-safe memoization cache
+ *
+ * concurrent_cache splits its entries across independently locked shards, so
+ * threads working on different keys rarely contend.  Hits only take a shared
+ * lock: instead of moving the entry to the front of a list (as an LRU
+ * would), a hit just sets the entry's reference bit, and eviction uses the
+ * CLOCK algorithm to give referenced entries a second chance.  Every entry
+ * and hash table slot is allocated up front, so a full cache replaces
+ * entries in place rather than churning the allocator.
+ */
+
+namespace houseguest
+{
+    /// \brief counts of how a concurrent_cache has been used
+    struct cache_statistics
+    {
+        /// \brief lookups that found a cached value
+        std::uint64_t hits = 0;
+
+        /// \brief lookups that computed a value
+        std::uint64_t misses = 0;
+
+        /// \brief lookups that waited for another thread to compute the
+        ///        same value
+        std::uint64_t coalesced = 0;
+
+        /// \brief entries removed to make room for new ones
+        std::uint64_t evictions = 0;
+
+        /// \brief get the total number of lookups
+        constexpr std::uint64_t lookups() const noexcept
+        {
+            return hits + misses + coalesced;
+        }
+
+        /// \brief get the fraction of lookups that found a cached value
+        constexpr double hit_rate() const noexcept
+        {
+            return (lookups() == 0) ? 0.0
+                                    : static_cast<double>(hits) /
+                                          static_cast<double>(lookups());
+        }
+    };
+
+    namespace internal
+    {
+        /// \brief the default number of shards in a concurrent_cache
+        constexpr std::size_t cache_shard_count = 16;
+
+        /// \brief get the smallest power of two not less-than \a value
+        inline std::size_t next_power_of_two(std::size_t value) noexcept
+        {
+            std::size_t ret = 1;
+            while(ret < value)
+            {
+                ret <<= 1U;
+            }
+            return ret;
+        }
+
+        /** \brief a single lock stripe of a concurrent_cache
+         *
+         * Entries live in a fixed array of nodes and are found through an
+         * open-addressed table of node indices (linear probing, with
+         * backward-shift deletion so no tombstones build up).  There's one
+         * more node than the capacity: once the shard is full, new entries
+         * are built in the spare node before anything is evicted, and the
+         * evicted node becomes the new spare.
+         */
+        template <typename K, typename V, typename HASH, typename KEY_EQUAL,
+                  typename MUTEX>
+        class cache_shard
+        {
+        public:
+            struct entry
+            {
+                K key;
+                V value;
+            };
+
+            cache_shard() = default;
+            cache_shard(cache_shard const &) = delete;
+            cache_shard & operator=(cache_shard const &) = delete;
+
+            ~cache_shard()
+            {
+                // nodes are used in order until the shard fills; after that,
+                // every node but the spare holds an entry
+                auto const used = (_size == _capacity) ? _capacity + 1 : _size;
+                for(std::size_t i = 0; i < used; ++i)
+                {
+                    if(i != _spare)
+                    {
+                        _nodes[i].get().~entry();
+                    }
+                }
+            }
+
+            void reserve(std::size_t capacity)
+            {
+                _capacity = capacity;
+                _spare = capacity;
+                _nodes.reset(new node[capacity + 1]);
+                _table.assign(next_power_of_two(capacity * 2), empty_slot);
+            }
+
+            // requires at least a shared lock
+            entry const * find(K const & key, std::size_t hash,
+                               KEY_EQUAL const & equal) const
+            {
+                auto const position = find_position(key, hash, equal);
+                if(position == npos)
+                {
+                    return nullptr;
+                }
+                auto & found = _nodes[_table[position]];
+                // avoid dirtying the cache line on repeated hits
+                if(!found.referenced.load(std::memory_order_relaxed))
+                {
+                    found.referenced.store(true, std::memory_order_relaxed);
+                }
+                return &found.get();
+            }
+
+            // requires a unique lock; key must not already be present.  If
+            // copying key or value throws, the shard is unchanged.
+            void insert(K const & key, std::size_t hash, V const & value,
+                        KEY_EQUAL const & equal)
+            {
+                auto const full = (_size == _capacity);
+                auto index = full ? _spare : _size;
+                auto evicted = index;
+                auto evicted_position = npos;
+                if(full)
+                {
+                    evicted = victim();
+                    auto & victim_node = _nodes[evicted];
+                    evicted_position = find_position(victim_node.get().key,
+                                                     victim_node.hash, equal);
+                }
+
+                auto & created = _nodes[index];
+                ::new(static_cast<void *>(created.storage)) entry{key, value};
+                created.hash = hash;
+                created.referenced.store(false, std::memory_order_relaxed);
+
+                // nothing below can throw
+                if(full)
+                {
+                    erase_position(evicted_position);
+                    _nodes[evicted].get().~entry();
+                    _spare = evicted;
+                    ++evictions;
+                }
+                else
+                {
+                    ++_size;
+                }
+
+                auto position = home(hash);
+                while(_table[position] != empty_slot)
+                {
+                    position = next(position);
+                }
+                _table[position] = static_cast<std::uint32_t>(index);
+            }
+
+            std::size_t size() const noexcept
+            {
+                return _size;
+            }
+
+            /** \brief find or start the computation of \a key's value
+             *
+             * Requires a unique lock.
+             *
+             * \param started set to true if a new computation was started,
+             *                which the caller must complete with finish
+             *
+             * \return The index of the computation
+             */
+            std::size_t join(K const & key, std::size_t hash,
+                             KEY_EQUAL const & equal, bool & started)
+            {
+                auto free = _flights.size();
+                for(std::size_t i = 0; i < _flights.size(); ++i)
+                {
+                    auto const & current = _flights[i];
+                    if(current.key == nullptr)
+                    {
+                        free = i;
+                    }
+                    else if(!current.done && current.hash == hash &&
+                            equal(*current.key, key))
+                    {
+                        started = false;
+                        return i;
+                    }
+                }
+                if(free == _flights.size())
+                {
+                    _flights.emplace_back();
+                }
+                auto & created = _flights[free];
+                created.key = &key;
+                created.hash = hash;
+                created.done = false;
+                started = true;
+                return free;
+            }
+
+            /** \brief complete a computation started by join
+             *
+             * Requires a unique lock.  If anybody is waiting, they're given a
+             * copy of \a value (or \a error, if \a value is null).
+             */
+            void finish(std::size_t index, V const * value,
+                        std::exception_ptr error)
+            {
+                auto & current = _flights[index];
+                current.done = true;
+                if(current.waiters == 0)
+                {
+                    current.release();
+                    return;
+                }
+                if(value != nullptr)
+                {
+                    current.result.reset(new V(*value));
+                }
+                current.error = std::move(error);
+                _finished.notify_all();
+            }
+
+            /** \brief wait for a computation started by another thread
+             *
+             * \param lock a unique lock on shard_mutex
+             *
+             * \throw Anything thrown by the computation
+             */
+            template <typename LOCK>
+            V wait(LOCK & lock, std::size_t index)
+            {
+                ++_flights[index].waiters;
+                _finished.wait(
+                    lock, [this, index]() { return _flights[index].done; });
+                auto & current = _flights[index];
+                --current.waiters;
+                auto const error = current.error;
+                std::unique_ptr<V> result;
+                if(current.waiters == 0)
+                {
+                    result = std::move(current.result);
+                    current.release();
+                }
+                if(error)
+                {
+                    std::rethrow_exception(error);
+                }
+                return result ? std::move(*result) : *current.result;
+            }
+
+            mutable MUTEX shard_mutex;
+
+            mutable std::atomic<std::uint64_t> hits{0};
+            std::atomic<std::uint64_t> misses{0};
+            std::atomic<std::uint64_t> coalesced{0};
+            std::atomic<std::uint64_t> evictions{0};
+
+        private:
+            static constexpr std::uint32_t empty_slot = 0xFFFFFFFFU;
+            static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+            struct node
+            {
+                entry & get() noexcept
+                {
+                    return *reinterpret_cast<entry *>(storage);
+                }
+
+                std::size_t hash = 0;
+                std::atomic<bool> referenced{false};
+                alignas(entry) unsigned char storage[sizeof(entry)];
+            };
+
+            std::size_t home(std::size_t hash) const noexcept
+            {
+                return hash & (_table.size() - 1);
+            }
+
+            std::size_t next(std::size_t position) const noexcept
+            {
+                return (position + 1) & (_table.size() - 1);
+            }
+
+            std::size_t find_position(K const & key, std::size_t hash,
+                                      KEY_EQUAL const & equal) const
+            {
+                for(auto position = home(hash); _table[position] != empty_slot;
+                    position = next(position))
+                {
+                    auto & candidate = _nodes[_table[position]];
+                    if(candidate.hash == hash &&
+                       equal(candidate.get().key, key))
+                    {
+                        return position;
+                    }
+                }
+                return npos;
+            }
+
+            void erase_position(std::size_t position) noexcept
+            {
+                // shift later members of the probe sequence back, so lookups
+                // never stop early at the hole
+                auto hole = position;
+                for(auto current = next(hole); _table[current] != empty_slot;
+                    current = next(current))
+                {
+                    auto const wanted = home(_nodes[_table[current]].hash);
+                    auto const distance_to_hole =
+                        (hole - wanted) & (_table.size() - 1);
+                    auto const distance_to_current =
+                        (current - wanted) & (_table.size() - 1);
+                    if(distance_to_hole <= distance_to_current)
+                    {
+                        _table[hole] = _table[current];
+                        hole = current;
+                    }
+                }
+                _table[hole] = empty_slot;
+            }
+
+            // CLOCK: sweep the hand, clearing reference bits, until an
+            // unreferenced entry is found
+            std::size_t victim() noexcept
+            {
+                while(true)
+                {
+                    auto & candidate = _nodes[_hand];
+                    auto const index = _hand;
+                    _hand = (_hand == _capacity) ? 0 : _hand + 1;
+                    if(index == _spare)
+                    {
+                        continue;
+                    }
+                    if(!candidate.referenced.load(std::memory_order_relaxed))
+                    {
+                        return index;
+                    }
+                    candidate.referenced.store(false,
+                                               std::memory_order_relaxed);
+                }
+            }
+
+            // a computation in progress.  key points to the computing
+            // thread's argument, so it's only valid until done is set.
+            struct flight
+            {
+                void release() noexcept
+                {
+                    key = nullptr;
+                    result.reset();
+                    error = nullptr;
+                }
+
+                K const * key = nullptr;
+                std::size_t hash = 0;
+                bool done = false;
+                std::size_t waiters = 0;
+                std::unique_ptr<V> result;
+                std::exception_ptr error;
+            };
+
+            std::unique_ptr<node[]> _nodes;
+            // slots are reused, so this only grows with the number of
+            // simultaneous misses
+            std::vector<flight> _flights;
+            std::condition_variable_any _finished;
+            std::vector<std::uint32_t> _table;
+            std::size_t _capacity = 0;
+            std::size_t _size = 0;
+            std::size_t _spare = 0;
+            std::size_t _hand = 0;
+        };
+
+#if __cplusplus < 201703L
+        template <typename K, typename V, typename HASH, typename KEY_EQUAL,
+                  typename MUTEX>
+        constexpr std::uint32_t
+            cache_shard<K, V, HASH, KEY_EQUAL, MUTEX>::empty_slot;
+
+        template <typename K, typename V, typename HASH, typename KEY_EQUAL,
+                  typename MUTEX>
+        constexpr std::size_t cache_shard<K, V, HASH, KEY_EQUAL, MUTEX>::npos;
+#endif
+    } // namespace internal
+
+    /** \brief a fixed-size, thread-safe cache of computed values
+     *
+     * Keys are spread across shards by hash, and each shard has its own
+     * mutex.  A hit takes a shared lock and copies the cached value; a miss
+     * computes the value without holding any lock, then takes a unique lock
+     * to store it.  If several threads miss on the same key at once, only one
+     * computes the value and the rest wait for its result.
+     *
+     * Once a shard is full, storing a value evicts an entry chosen by the
+     * CLOCK algorithm (an approximation of least-recently-used).
+     *
+     * \tparam K         the key type.  It must be copy constructible.
+     * \tparam V         the cached type.  It must be copy constructible, since
+     *                   values are returned by copy (the cached entry may be
+     *                   evicted at any time).
+     * \tparam HASH      the hash function for \a K
+     * \tparam KEY_EQUAL the equality comparison for \a K
+     * \tparam MUTEX     the mutex for each shard.  This type must support both
+     *                   unique and shared locks.
+     */
+    template <typename K, typename V, typename HASH = std::hash<K>,
+              typename KEY_EQUAL = std::equal_to<K>,
+              typename MUTEX = houseguest::shared_mutex>
+    class concurrent_cache
+    {
+    public:
+        /// \brief the key type
+        using key_type = K;
+
+        /// \brief the cached type
+        using mapped_type = V;
+
+        /// \brief the type used for sizes
+        using size_type = std::size_t;
+
+        /** \brief construct a concurrent_cache
+         *
+         * Storage for every entry is allocated here.
+         *
+         * \param capacity    the number of values to cache.  Each shard holds
+         *                    an equal share (rounded up), so the cache may
+         *                    hold slightly more.
+         * \param shard_count the number of independently locked shards
+         *
+         * \throw std::invalid_argument if \a capacity or \a shard_count is
+         *                              zero
+         */
+        explicit concurrent_cache(
+            size_type capacity,
+            size_type shard_count = internal::cache_shard_count,
+            HASH hash = HASH{}, KEY_EQUAL equal = KEY_EQUAL{})
+          : _hash{std::move(hash)}
+          , _equal{std::move(equal)}
+          , _shard_count{shard_count}
+        {
+            if(capacity == 0 || shard_count == 0)
+            {
+                throw std::invalid_argument{
+                    "concurrent_cache requires a capacity and shards"};
+            }
+            _shards.reset(new shard_type[shard_count]);
+            _shard_capacity = (capacity + shard_count - 1) / shard_count;
+            for(size_type i = 0; i < shard_count; ++i)
+            {
+                _shards[i].reserve(_shard_capacity);
+            }
+        }
+
+        concurrent_cache(concurrent_cache const &) = delete;
+        concurrent_cache & operator=(concurrent_cache const &) = delete;
+
+        /** \brief get the cached value for \a key, computing it if needed
+         *
+         * \param key the key to look up
+         * \param fn  a function called as fn(key) to compute the value if
+         *            it isn't cached.  No locks are held while it runs.
+         *
+         * \return A copy of the value for \a key
+         *
+         * \throw Anything thrown by \a fn.  Nothing is cached, and any thread
+         *        waiting for the same key receives the same exception.
+         */
+        template <typename FN>
+        V get_or_compute(K const & key, FN && fn)
+        {
+            auto const hash = _hash(key);
+            auto & shard = shard_for(hash);
+            auto const shard_hash = hash / _shard_count;
+            {
+                shared_lock_t<MUTEX> const lock{shard.shard_mutex};
+                auto const * found = shard.find(key, shard_hash, _equal);
+                if(found != nullptr)
+                {
+                    increment(shard.hits);
+                    return found->value;
+                }
+            }
+
+            std::size_t flight = 0;
+            {
+                unique_lock_t<MUTEX> lock{shard.shard_mutex};
+                // another thread may have stored it since the shared lock
+                // was released
+                auto const * found = shard.find(key, shard_hash, _equal);
+                if(found != nullptr)
+                {
+                    increment(shard.hits);
+                    return found->value;
+                }
+                bool started = false;
+                flight = shard.join(key, shard_hash, _equal, started);
+                if(!started)
+                {
+                    increment(shard.coalesced);
+                    return shard.wait(lock, flight);
+                }
+            }
+
+            increment(shard.misses);
+            try
+            {
+                V value = std::forward<FN>(fn)(key);
+                unique_lock_t<MUTEX> const lock{shard.shard_mutex};
+                shard.insert(key, shard_hash, value, _equal);
+                shard.finish(flight, &value, nullptr);
+                return value;
+            }
+            catch(...)
+            {
+                unique_lock_t<MUTEX> const lock{shard.shard_mutex};
+                shard.finish(flight, nullptr, std::current_exception());
+                throw;
+            }
+        }
+
+        /// \brief get the number of cached values
+        size_type size() const
+        {
+            size_type ret = 0;
+            for(size_type i = 0; i < _shard_count; ++i)
+            {
+                shared_lock_t<MUTEX> const lock{_shards[i].shard_mutex};
+                ret += _shards[i].size();
+            }
+            return ret;
+        }
+
+        /// \brief get the maximum number of cached values
+        size_type capacity() const noexcept
+        {
+            return _shard_capacity * _shard_count;
+        }
+
+        /// \brief get the number of shards
+        size_type shard_count() const noexcept
+        {
+            return _shard_count;
+        }
+
+        /** \brief get the usage counts from every shard
+         *
+         * Counts are kept with relaxed atomics, so a snapshot taken while
+         * other threads use the cache may be slightly inconsistent.
+         */
+        cache_statistics statistics() const noexcept
+        {
+            cache_statistics ret;
+            for(size_type i = 0; i < _shard_count; ++i)
+            {
+                auto const & shard = _shards[i];
+                ret.hits += shard.hits.load(std::memory_order_relaxed);
+                ret.misses += shard.misses.load(std::memory_order_relaxed);
+                ret.coalesced +=
+                    shard.coalesced.load(std::memory_order_relaxed);
+                ret.evictions +=
+                    shard.evictions.load(std::memory_order_relaxed);
+            }
+            return ret;
+        }
+
+    private:
+        using shard_type =
+            internal::cache_shard<K, V, HASH, KEY_EQUAL, MUTEX>;
+
+        static void increment(std::atomic<std::uint64_t> & counter) noexcept
+        {
+            counter.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        shard_type & shard_for(std::size_t hash) const noexcept
+        {
+            return _shards[hash % _shard_count];
+        }
+
+        HASH _hash;
+        KEY_EQUAL _equal;
+        size_type _shard_count;
+        size_type _shard_capacity = 0;
+        std::unique_ptr<shard_type[]> _shards;
+    };
+} // namespace houseguest
+
+#endif
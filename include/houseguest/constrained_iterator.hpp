@@ -0,0 +1,173 @@
+#ifndef HOUSEGUEST_CONSTRAINED_ITERATOR_HPP
+#define HOUSEGUEST_CONSTRAINED_ITERATOR_HPP 1
+
+#include <cstddef>
+#include <iterator>
+
+#include <houseguest/constrained_value.hpp>
+
+namespace houseguest
+{
+    /** \brief an iterator over raw values that are known to be valid
+     *
+     * constrained_iterator walks contiguous storage of raw \a T values that
+     * have already been validated, producing constrained_values on
+     * dereference.  Since the values were validated when they were stored,
+     * dereferencing never runs the validator.
+     *
+     * \tparam T         the integral type being stored
+     * \tparam VALIDATOR the validator every stored value satisfies.
+     *                   VALIDATOR must be default constructible.
+     *
+     * \note Dereferencing produces a constrained_value by value, not a
+     *       reference, so this is a read-only iterator.
+     */
+    template <typename T, typename VALIDATOR>
+    class constrained_iterator
+    {
+    public:
+        /// \cond false
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = constrained_value<T, VALIDATOR>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+        /// \endcond
+
+        /// \brief construct a singular constrained_iterator
+        constexpr constrained_iterator() noexcept = default;
+
+        /** \brief construct a constrained_iterator
+         *
+         * \param position a pointer to a value that satisfies VALIDATOR (or
+         *                 one past the end of such values)
+         */
+        explicit constexpr constrained_iterator(T const * position) noexcept
+          : _position{position}
+        {
+        }
+
+        /// \brief retrieve the current value
+        constexpr value_type operator*() const
+        {
+            return value_type{internal::prevalidated, *_position};
+        }
+
+        /// \brief retrieve a value relative to the current position
+        constexpr value_type operator[](difference_type offset) const
+        {
+            return value_type{internal::prevalidated, _position[offset]};
+        }
+
+        /// \brief get the underlying pointer
+        constexpr T const * base() const noexcept
+        {
+            return _position;
+        }
+
+        /// \cond false
+        constrained_iterator & operator++() noexcept
+        {
+            ++_position;
+            return *this;
+        }
+
+        constrained_iterator operator++(int) noexcept
+        {
+            auto ret = *this;
+            ++_position;
+            return ret;
+        }
+
+        constrained_iterator & operator--() noexcept
+        {
+            --_position;
+            return *this;
+        }
+
+        constrained_iterator operator--(int) noexcept
+        {
+            auto ret = *this;
+            --_position;
+            return ret;
+        }
+
+        constrained_iterator & operator+=(difference_type offset) noexcept
+        {
+            _position += offset;
+            return *this;
+        }
+
+        constrained_iterator & operator-=(difference_type offset) noexcept
+        {
+            _position -= offset;
+            return *this;
+        }
+
+        friend constexpr constrained_iterator
+        operator+(constrained_iterator it, difference_type offset) noexcept
+        {
+            return constrained_iterator{it._position + offset};
+        }
+
+        friend constexpr constrained_iterator
+        operator+(difference_type offset, constrained_iterator it) noexcept
+        {
+            return constrained_iterator{it._position + offset};
+        }
+
+        friend constexpr constrained_iterator
+        operator-(constrained_iterator it, difference_type offset) noexcept
+        {
+            return constrained_iterator{it._position - offset};
+        }
+
+        friend constexpr difference_type
+        operator-(constrained_iterator lhs, constrained_iterator rhs) noexcept
+        {
+            return lhs._position - rhs._position;
+        }
+
+        friend constexpr bool operator==(constrained_iterator lhs,
+                                         constrained_iterator rhs) noexcept
+        {
+            return lhs._position == rhs._position;
+        }
+
+        friend constexpr bool operator!=(constrained_iterator lhs,
+                                         constrained_iterator rhs) noexcept
+        {
+            return lhs._position != rhs._position;
+        }
+
+        friend constexpr bool operator<(constrained_iterator lhs,
+                                        constrained_iterator rhs) noexcept
+        {
+            return lhs._position < rhs._position;
+        }
+
+        friend constexpr bool operator<=(constrained_iterator lhs,
+                                         constrained_iterator rhs) noexcept
+        {
+            return lhs._position <= rhs._position;
+        }
+
+        friend constexpr bool operator>(constrained_iterator lhs,
+                                        constrained_iterator rhs) noexcept
+        {
+            return lhs._position > rhs._position;
+        }
+
+        friend constexpr bool operator>=(constrained_iterator lhs,
+                                         constrained_iterator rhs) noexcept
+        {
+            return lhs._position >= rhs._position;
+        }
+        /// \endcond
+
+    private:
+        T const * _position = nullptr;
+    };
+} // namespace houseguest
+
+#endif
@@ -0,0 +1,333 @@
+#ifndef HOUSEGUEST_CONSTRAINED_SPAN_HPP
+#define HOUSEGUEST_CONSTRAINED_SPAN_HPP 1
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#include <houseguest/bounded_algorithm.hpp>
+#include <houseguest/constrained_iterator.hpp>
+#include <houseguest/constrained_value.hpp>
+#include <houseguest/validation_result.hpp>
+
+/** \file
+ *
+ * \brief Validated views over raw values stored elsewhere
+ *
+ * A constrained_span checks a buffer of raw values once (e.g., a
+ * memory-mapped file) and then hands out constrained_values straight from
+ * the buffer, with no copies and no further checks.  Large buffers can be
+ * validated a chunk at a time with constrained_span_reader, so each chunk is
+ * checked just before it's used.
+ */
+
+namespace houseguest
+{
+    namespace internal
+    {
+        /// \brief the default number of values constrained_span_reader
+        ///        validates at once
+        constexpr std::size_t span_chunk_size = 4096;
+
+        /** \brief check a buffer of raw values for a constrained_span
+         *
+         * The buffer is scanned in a single vectorizable pass.  If a value is
+         * rejected, it's passed through a VALIDATOR so the same exception is
+         * thrown as if it had been validated on its own.
+         */
+        template <typename T, typename VALIDATOR>
+        void validate_span(T const * data, std::size_t size)
+        {
+            auto const last = data + size;
+            auto const it = validate_all<VALIDATOR>(data, last);
+            if(it != last)
+            {
+                VALIDATOR{}(T{*it});
+            }
+        }
+    } // namespace internal
+
+    /** \brief a read-only view over raw values that satisfy a validator
+     *
+     * Every value is validated when the constrained_span is created;
+     * afterwards, elements are produced as constrained_values without running
+     * the validator again.  constrained_span doesn't own its values, so the
+     * buffer must outlive it and must not be modified while it's in use.
+     *
+     * Since values can't be modified, VALIDATOR must reject invalid values
+     * (e.g., exception_validator or a composite_validator) rather than
+     * adjusting them.
+     *
+     * \tparam T         the integral type being viewed
+     * \tparam VALIDATOR the validator every value must satisfy.  VALIDATOR
+     *                   must be default constructible and have a range or a
+     *                   test function.
+     */
+    template <typename T, typename VALIDATOR>
+    class constrained_span
+    {
+        static_assert(internal::has_check<VALIDATOR, T>::value,
+                      "Values can't be adjusted, so VALIDATOR must reject "
+                      "them");
+        static_assert(internal::has_range<VALIDATOR>::value ||
+                          internal::has_test<VALIDATOR>::value,
+                      "VALIDATOR must have a range or a test function");
+
+    public:
+        /// \brief the type of elements
+        using value_type = constrained_value<T, VALIDATOR>;
+
+        /// \brief the type used for sizes
+        using size_type = std::size_t;
+
+        /// \brief an iterator over the elements
+        using iterator = constrained_iterator<T, VALIDATOR>;
+
+        /// \brief the same as iterator, since elements can't be modified
+        using const_iterator = iterator;
+
+        /// \brief construct an empty constrained_span
+        constexpr constrained_span() noexcept = default;
+
+        /** \brief construct a constrained_span
+         *
+         * \param data the values to view
+         * \param size the number of values
+         *
+         * \throw std::system_error (or whatever VALIDATOR throws) if any value
+         *                          is rejected
+         */
+        constrained_span(T const * data, size_type size)
+          : _data{data}
+          , _size{size}
+        {
+            internal::validate_span<T, VALIDATOR>(data, size);
+        }
+
+        /** \brief construct a constrained_span
+         *
+         * \param first the beginning of the values to view
+         * \param last  the end of the values to view
+         *
+         * \throw std::system_error (or whatever VALIDATOR throws) if any value
+         *                          is rejected
+         */
+        constrained_span(T const * first, T const * last)
+          : constrained_span{first, static_cast<size_type>(last - first)}
+        {
+        }
+
+        /** \brief construct a constrained_span over an array
+         *
+         * \throw std::system_error (or whatever VALIDATOR throws) if any value
+         *                          is rejected
+         */
+        template <std::size_t N>
+        constrained_span(T const (&values)[N])
+          : constrained_span{values, N}
+        {
+        }
+
+        /** \brief construct a constrained_span from values that have already
+         *         been validated
+         *
+         * \internal
+         *
+         * \param data the values to view.  Every value must already be
+         *             acceptable to VALIDATOR.
+         * \param size the number of values
+         */
+        constexpr constrained_span(internal::prevalidated_t, T const * data,
+                                   size_type size) noexcept
+          : _data{data}
+          , _size{size}
+        {
+        }
+
+        /// \brief get the number of elements
+        constexpr size_type size() const noexcept
+        {
+            return _size;
+        }
+
+        /// \brief determine if there are no elements
+        constexpr bool empty() const noexcept
+        {
+            return _size == 0;
+        }
+
+        /// \brief get the underlying values
+        constexpr T const * data() const noexcept
+        {
+            return _data;
+        }
+
+        /// \brief get the element at \a index, which must be less-than size()
+        constexpr value_type operator[](size_type index) const noexcept
+        {
+            return value_type{internal::prevalidated, _data[index]};
+        }
+
+        /** \brief get the element at \a index
+         *
+         * \throw std::out_of_range if \a index isn't less-than size()
+         */
+        constexpr value_type at(size_type index) const
+        {
+            if(index >= _size)
+            {
+                throw std::out_of_range{"constrained_span index"};
+            }
+            return (*this)[index];
+        }
+
+        /// \brief get the first element (the span must not be empty)
+        constexpr value_type front() const noexcept
+        {
+            return (*this)[0];
+        }
+
+        /// \brief get the last element (the span must not be empty)
+        constexpr value_type back() const noexcept
+        {
+            return (*this)[_size - 1];
+        }
+
+        /// \brief get an iterator to the first element
+        constexpr iterator begin() const noexcept
+        {
+            return iterator{_data};
+        }
+
+        /// \brief get an iterator past the last element
+        constexpr iterator end() const noexcept
+        {
+            return iterator{_data + _size};
+        }
+
+        /** \brief get a view of part of the span
+         *
+         * No validation is required, since every element has already been
+         * validated.
+         *
+         * \param offset the index of the first element to view, which must
+         *               not be greater-than size()
+         * \param count  the number of elements to view.  This is limited to
+         *               the number of elements after \a offset.
+         */
+        constexpr constrained_span
+        subspan(size_type offset,
+                size_type count = static_cast<size_type>(-1)) const
+            noexcept
+        {
+            return constrained_span{
+                internal::prevalidated, _data + offset,
+                (count < _size - offset) ? count : _size - offset};
+        }
+
+        /// \brief get a view of the first \a count elements
+        constexpr constrained_span first(size_type count) const noexcept
+        {
+            return subspan(0, count);
+        }
+
+        /// \brief get a view of the last \a count elements
+        constexpr constrained_span last(size_type count) const noexcept
+        {
+            return subspan(_size - count, count);
+        }
+
+    private:
+        T const * _data = nullptr;
+        size_type _size = 0;
+    };
+
+    /** \brief validate a buffer of raw values one chunk at a time
+     *
+     * Validating a multi-gigabyte buffer before touching any of it means
+     * reading it twice.  constrained_span_reader instead validates each chunk
+     * as it's requested, so the values are still in cache when they're used
+     * and processing can start right away.  If a chunk contains an invalid
+     * value, the exception is thrown when that chunk is requested; every
+     * chunk returned before then is valid.
+     *
+     * \tparam T         the integral type being viewed
+     * \tparam VALIDATOR the validator every value must satisfy (see
+     *                   constrained_span)
+     */
+    template <typename T, typename VALIDATOR>
+    class constrained_span_reader
+    {
+    public:
+        /// \brief the type of each chunk
+        using span_type = constrained_span<T, VALIDATOR>;
+
+        /// \brief the type used for sizes
+        using size_type = std::size_t;
+
+        /** \brief construct a constrained_span_reader
+         *
+         * No values are validated until they're requested.
+         *
+         * \param data       the values to read
+         * \param size       the number of values
+         * \param chunk_size the number of values to validate at once, which
+         *                   must be greater-than zero
+         */
+        constexpr constrained_span_reader(
+            T const * data, size_type size,
+            size_type chunk_size = internal::span_chunk_size) noexcept
+          : _data{data}
+          , _size{size}
+          , _chunk_size{chunk_size}
+        {
+        }
+
+        /** \brief validate and return the next chunk
+         *
+         * \return The next (at most chunk_size) values, or an empty
+         *         constrained_span if every value has been read.
+         *
+         * \throw std::system_error (or whatever VALIDATOR throws) if any value
+         *                          in the chunk is rejected.  The reader
+         *                          doesn't advance, so the chunk will be
+         *                          checked again if it's requested again.
+         */
+        span_type next()
+        {
+            auto const count = (_chunk_size < remaining()) ? _chunk_size
+                                                           : remaining();
+            internal::validate_span<T, VALIDATOR>(_data + _position, count);
+            span_type const ret{internal::prevalidated, _data + _position,
+                                count};
+            _position += count;
+            return ret;
+        }
+
+        /// \brief get the number of values that have been validated
+        constexpr size_type position() const noexcept
+        {
+            return _position;
+        }
+
+        /// \brief get the number of values that haven't been read
+        constexpr size_type remaining() const noexcept
+        {
+            return _size - _position;
+        }
+
+        /// \brief determine if every value has been read
+        constexpr bool done() const noexcept
+        {
+            return _position == _size;
+        }
+
+    private:
+        T const * _data;
+        size_type _size;
+        size_type _chunk_size;
+        size_type _position = 0;
+    };
+} // namespace houseguest
+
+#endif
@@ -1,13 +1,130 @@
 #ifndef HOUSEGUEST_CONSTRAINED_VALUE_HPP
 #define HOUSEGUEST_CONSTRAINED_VALUE_HPP 1
 
-#include <tuple>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <type_traits>
+#include <utility>
 
 namespace houseguest
 {
     namespace internal
     {
+        /** \brief a tag to construct from a value that's already been validated
+         *
+         * \internal
+         *
+         * Bulk operations validate entire ranges at once; this tag lets them
+         * construct constrained_values without running VALIDATOR again.
+         */
+        struct prevalidated_t
+        {
+        };
+
+        /// \brief an instance of prevalidated_t
+        constexpr prevalidated_t prevalidated{};
+
+        template <typename...>
+        struct make_void
+        {
+            using type = void;
+        };
+
+        /** \brief how constrained_value_storage represents values
+         *
+         * \internal
+         *
+         * By default, values are stored as-is.  A validator can change this
+         * by providing a nested storage_policy type with the same members
+         * (e.g., to store values in a narrower type).
+         *
+         * \tparam T         the integral type being managed
+         * \tparam VALIDATOR the validator being used
+         */
+        template <typename T, typename VALIDATOR, typename = void>
+        struct storage_policy
+        {
+            /// \brief the type actually stored
+            using type = T;
+
+            /// \brief convert a (valid) value to its stored representation
+            static constexpr type encode(T value) noexcept
+            {
+                return value;
+            }
+
+            /// \brief convert a stored representation back to a value
+            static constexpr T decode(type value) noexcept
+            {
+                return value;
+            }
+        };
+
+        /// \cond false
+        template <typename T, typename VALIDATOR>
+        struct storage_policy<T, VALIDATOR,
+                              typename make_void<
+                                  typename VALIDATOR::storage_policy>::type>
+          : VALIDATOR::storage_policy
+        {
+        };
+        /// \endcond
+
+        /** \brief a value stored alongside its validator
+         *
+         * \internal
+         *
+         * Empty validators are stored as a base class, so they take no space.
+         * Unlike std::tuple, this is trivially copyable whenever the value and
+         * validator are, which lets constrained_values be passed in registers
+         * just like the raw value.
+         *
+         * \tparam VALUE     the type being stored
+         * \tparam VALIDATOR the validator being stored
+         */
+        template <typename VALUE, typename VALIDATOR,
+                  bool = std::is_empty<VALIDATOR>::value>
+        struct compressed_storage : private VALIDATOR
+        {
+            constexpr compressed_storage(VALUE value, VALIDATOR && validator)
+              : VALIDATOR(std::forward<VALIDATOR>(validator))
+              , stored{value}
+            {
+            }
+
+            constexpr VALIDATOR & validator() noexcept
+            {
+                return *this;
+            }
+
+            VALUE stored;
+        };
+
+        /// \cond false
+        template <typename VALUE, typename VALIDATOR>
+        struct compressed_storage<VALUE, VALIDATOR, false>
+        {
+            constexpr compressed_storage(VALUE value, VALIDATOR && validator)
+              : stored{value}
+              , _validator(std::forward<VALIDATOR>(validator))
+            {
+            }
+
+            constexpr VALIDATOR & validator() noexcept
+            {
+                return _validator;
+            }
+
+            VALUE stored;
+
+        private:
+            VALIDATOR _validator;
+        };
+        /// \endcond
+
         /** \brief a type to manage storage for constrained_value
          *
          * \internal
@@ -28,50 +145,361 @@ namespace houseguest
              * \param value     the initial value to use
              * \param validator the validator to own
              */
-            constrained_value_storage(T && value, VALIDATOR && validator)
-              : _data{make_storage(std::forward<T>(value), std::forward<VALIDATOR>(validator))}
+            constexpr constrained_value_storage(T && value,
+                                                VALIDATOR && validator)
+              : _data{make_storage(std::forward<T>(value),
+                                   std::forward<VALIDATOR>(validator))}
             {
             }
 
-            /// \brief get the stored value
-            constexpr T & value() noexcept
+            /** \brief construct constrained_value_storage without validation
+             *
+             * \param value     the initial value to use.  \a value must already
+             *                  be acceptable to \a validator.
+             * \param validator the validator to own
+             */
+            constexpr constrained_value_storage(prevalidated_t, T && value,
+                                                VALIDATOR && validator)
+              : _data{policy::encode(std::forward<T>(value)),
+                      std::forward<VALIDATOR>(validator)}
             {
-                return std::get<0>(_data);
             }
 
             /// \brief get the stored value
             constexpr T value() const noexcept
             {
-                return std::get<0>(_data);
+                return policy::decode(_data.stored);
             }
 
             /// \brief get the stored validator
             constexpr VALIDATOR & validator() noexcept
             {
-                return std::get<1>(_data);
+                return _data.validator();
             }
 
         private:
-            // Using a tuple means the compiler should optimize away any
-            // storage for empty VALIDATOR types.  Compiler Explorer seems to
-            // verify this.
-            using storage = std::tuple<T, VALIDATOR>;
+            using policy = storage_policy<T, VALIDATOR>;
 
-            static storage make_storage(T && value, VALIDATOR && validator)
+            using storage =
+                compressed_storage<typename policy::type, VALIDATOR>;
+
+            static constexpr storage make_storage(T && value,
+                                                  VALIDATOR && validator)
             {
                 auto temp_value = validator(std::forward<T>(value));
-                return std::make_tuple(std::move(temp_value), std::forward<VALIDATOR>(validator));
+                return storage{policy::encode(std::move(temp_value)),
+                               std::forward<VALIDATOR>(validator)};
             }
 
             // make sure this optimization is turned on
             static_assert(!std::is_empty<VALIDATOR>::value ||
-                              (sizeof(storage) == sizeof(T)),
+                              (sizeof(storage) ==
+                               sizeof(typename policy::type)),
                           "Non-empty validator is impacting size");
 
             storage _data;
         };
     } // namespace internal
 
+    namespace internal
+    {
+        /// \cond false
+        template <typename T, typename U>
+        constexpr bool cmp_less(T t, U u, std::false_type,
+                                std::false_type) noexcept
+        {
+            return t < u;
+        }
+
+        template <typename T, typename U>
+        constexpr bool cmp_less(T t, U u, std::true_type,
+                                std::true_type) noexcept
+        {
+            return t < u;
+        }
+
+        template <typename T, typename U>
+        constexpr bool cmp_less(T t, U u, std::true_type,
+                                std::false_type) noexcept
+        {
+            return (t < 0) || (static_cast<std::make_unsigned_t<T>>(t) < u);
+        }
+
+        template <typename T, typename U>
+        constexpr bool cmp_less(T t, U u, std::false_type,
+                                std::true_type) noexcept
+        {
+            return (u > 0) && (t < static_cast<std::make_unsigned_t<U>>(u));
+        }
+        /// \endcond
+
+        /** \brief compare integers of different types without conversion
+         *         surprises
+         *
+         * \retval true  \a t is mathematically less-than \a u
+         * \retval false \a t is mathematically greater-than or equal to \a u
+         */
+        template <typename T, typename U>
+        constexpr bool cmp_less(T t, U u) noexcept
+        {
+            return cmp_less(
+                t, u, std::integral_constant<bool, std::is_signed<T>::value>{},
+                std::integral_constant<bool, std::is_signed<U>::value>{});
+        }
+
+        /** \brief determine if a validator restricts values to a range
+         *
+         * Validators with a range provide \a type, \a min, and \a max
+         * members (e.g., anything derived from bounded_validator).  Every
+         * value accepted by such a validator falls between min and max.
+         */
+        template <typename VALIDATOR, typename = void>
+        struct has_range : std::false_type
+        {
+        };
+
+        /// \cond false
+        template <typename VALIDATOR>
+        struct has_range<VALIDATOR, typename make_void<
+                                        typename VALIDATOR::type,
+                                        decltype(VALIDATOR::min),
+                                        decltype(VALIDATOR::max)>::type>
+          : std::true_type
+        {
+        };
+        /// \endcond
+
+        /** \brief determine if a validator can test values without
+         *         modifying or rejecting them
+         *
+         * Validators with a test provide a static function that reports
+         * whether a VALIDATOR::type value is acceptable (see
+         * composite_validator.hpp).
+         */
+        template <typename VALIDATOR, typename = void>
+        struct has_test : std::false_type
+        {
+        };
+
+        /// \cond false
+        template <typename VALIDATOR>
+        struct has_test<VALIDATOR,
+                        typename make_void<decltype(VALIDATOR::test(
+                            std::declval<typename VALIDATOR::type>()))>::type>
+          : std::true_type
+        {
+        };
+        /// \endcond
+
+        /** \brief determine if a validator can report problems without
+         *         throwing
+         *
+         * Validators with a check function return an error (which converts to
+         * std::error_code) instead of throwing; a value-initialized error
+         * means success.
+         */
+        template <typename VALIDATOR, typename T, typename = void>
+        struct has_check : std::false_type
+        {
+        };
+
+        /// \cond false
+        template <typename VALIDATOR, typename T>
+        struct has_check<VALIDATOR, T,
+                         typename make_void<decltype(
+                             std::declval<VALIDATOR const &>().check(
+                                 std::declval<T>()))>::type> : std::true_type
+        {
+        };
+
+        template <typename VALIDATOR, typename T, typename RANGE,
+                  typename CHECK>
+        constexpr bool accepts(VALIDATOR const &, T value, std::true_type,
+                               RANGE, CHECK) noexcept
+        {
+            return VALIDATOR::test(value);
+        }
+
+        template <typename VALIDATOR, typename T, typename CHECK>
+        constexpr bool accepts(VALIDATOR const &, T value, std::false_type,
+                               std::true_type, CHECK) noexcept
+        {
+            return !cmp_less(value, VALIDATOR::min) &&
+                   !cmp_less(VALIDATOR::max, value);
+        }
+
+        template <typename VALIDATOR, typename T>
+        constexpr bool accepts(VALIDATOR const & validator, T value,
+                               std::false_type, std::false_type,
+                               std::true_type) noexcept
+        {
+            return validator.check(value) ==
+                   decltype(validator.check(value)){};
+        }
+
+        template <typename VALIDATOR, typename T>
+        constexpr bool accepts(VALIDATOR const &, T, std::false_type,
+                               std::false_type, std::false_type) noexcept
+        {
+            return true;
+        }
+        /// \endcond
+
+        /** \brief determine if \a validator would accept \a value unchanged
+         *
+         * The validator is never invoked.  Validators with a test function
+         * use it; otherwise, validators with a range check the range, and
+         * validators with a check function use that.  Validators with none of
+         * those can't be checked without running them, so every value is
+         * assumed to be acceptable.
+         */
+        template <typename VALIDATOR, typename T>
+        constexpr bool accepts(VALIDATOR const & validator, T value) noexcept
+        {
+            return accepts(validator, value, has_test<VALIDATOR>{},
+                           has_range<VALIDATOR>{},
+                           has_check<VALIDATOR, T>{});
+        }
+
+        /// \brief verify \a value is acceptable to \a validator in debug
+        ///        builds
+        template <typename VALIDATOR, typename T>
+        constexpr T assume_valid(VALIDATOR const & validator, T value) noexcept
+        {
+            assert(accepts(validator, value));
+            (void)validator;
+            return value;
+        }
+
+        /** \brief the range of values a constrained_value can hold
+         *
+         * \tparam T         the integral type being stored
+         * \tparam VALIDATOR the validator in use.  If VALIDATOR has a range,
+         *                   it's used; otherwise, the full range of \a T is
+         *                   assumed.
+         */
+        template <typename T, typename VALIDATOR,
+                  bool = has_range<VALIDATOR>::value>
+        struct value_range
+        {
+            /// \brief the lowest possible value
+            static constexpr T min = std::numeric_limits<T>::min();
+
+            /// \brief the highest possible value
+            static constexpr T max = std::numeric_limits<T>::max();
+        };
+
+        /// \cond false
+        template <typename T, typename VALIDATOR>
+        struct value_range<T, VALIDATOR, true>
+        {
+            static constexpr typename VALIDATOR::type min = VALIDATOR::min;
+            static constexpr typename VALIDATOR::type max = VALIDATOR::max;
+        };
+        /// \endcond
+
+        /// \brief determine if every value of \a FROM fits in \a TO
+        template <typename FROM, typename TO>
+        constexpr bool range_within() noexcept
+        {
+            return !cmp_less(FROM::min, TO::min) &&
+                   !cmp_less(TO::max, FROM::max);
+        }
+
+        /** \brief find the first of \a CANDIDATES that can hold every value
+         *         of both \a FROM and \a TO
+         *
+         * \a type is void if none of them can.
+         */
+        template <typename FROM, typename TO, typename... CANDIDATES>
+        struct common_range_type
+        {
+            using type = void;
+        };
+
+        /// \cond false
+        template <typename FROM, typename TO, typename CANDIDATE,
+                  typename... CANDIDATES>
+        struct common_range_type<FROM, TO, CANDIDATE, CANDIDATES...>
+          : std::conditional_t<
+                range_within<FROM, value_range<CANDIDATE, void>>() &&
+                    range_within<TO, value_range<CANDIDATE, void>>(),
+                std::enable_if<true, CANDIDATE>,
+                common_range_type<FROM, TO, CANDIDATES...>>
+        {
+        };
+        /// \endcond
+
+        /** \brief rebuild \a VALIDATOR to operate on values of type \a U
+         *
+         * Validators shaped like bounded_validator (a type and two bounds)
+         * keep their bounds and policy; \a type is void for anything else.
+         */
+        template <typename VALIDATOR, typename U>
+        struct widened_validator
+        {
+            using type = void;
+        };
+
+        /// \cond false
+        template <template <typename X, X, X> class VALIDATOR, typename T,
+                  T MIN, T MAX, typename U>
+        struct widened_validator<VALIDATOR<T, MIN, MAX>, U>
+        {
+            using type = VALIDATOR<U, MIN, MAX>;
+        };
+
+        template <typename T, typename COMMON, typename WIDE,
+                  typename VALIDATOR, typename U>
+        constexpr T narrow(VALIDATOR const &, U value, WIDE const & wide)
+        {
+            return static_cast<T>(wide(static_cast<COMMON>(value)));
+        }
+
+        template <typename T, typename COMMON, typename WIDE,
+                  typename VALIDATOR, typename U>
+        constexpr T narrow(VALIDATOR const & validator, U value, void const *)
+        {
+            return validator(
+                cmp_less(value, std::numeric_limits<T>::min())
+                    ? std::numeric_limits<T>::min()
+                    : cmp_less(std::numeric_limits<T>::max(), value)
+                          ? std::numeric_limits<T>::max()
+                          : static_cast<T>(value));
+        }
+        /// \endcond
+
+        /** \brief validate a value that \a T might not be able to represent
+         *
+         * If \a VALIDATOR can be rebuilt around a type that holds both \a U
+         * and \a VALIDATOR's range, the value is validated in that type and
+         * the result narrowed to \a T.  Otherwise (e.g., custom validators,
+         * or ranges no integer type can hold together), the value is
+         * saturated to \a T's limits before \a validator sees it.
+         *
+         * \return \a value, converted to \a T and acceptable to \a validator
+         */
+        template <typename T, typename VALIDATOR, typename U>
+        constexpr T narrow(VALIDATOR const & validator, U value)
+        {
+            using common_type =
+                typename common_range_type<value_range<U, void>,
+                                           value_range<T, VALIDATOR>, U,
+                                           std::intmax_t,
+                                           std::uintmax_t>::type;
+            using wide_type =
+                typename widened_validator<VALIDATOR, common_type>::type;
+            using tag = std::conditional_t<std::is_void<wide_type>::value,
+                                           void const *, wide_type>;
+            return narrow<T, common_type, wide_type>(validator, value, tag{});
+        }
+
+        /// \brief a tag for conversions \a T can't always represent
+        struct narrowing_t
+        {
+        };
+    } // namespace internal
+
     /** \brief a trait to determine if two validators are compatible
      *
      * \tparam FROM the validator being converted from
@@ -79,21 +507,93 @@ namespace houseguest
      *
      * \note By default, validators are considered compatible.  This lets even
      *       incompatible validators attempt to convert, although that may
-     *       result in runtime errors.
+     *       result in runtime errors.  Validators with a range (see
+     *       bounded_validator) are compatible if their ranges overlap, even if
+     *       their underlying types differ.
      */
-    template <typename FROM, typename TO>
+    template <typename FROM, typename TO, typename = void>
     struct is_validator_convertible
     {
         /// \brief a variable to determine if validators are convertible
         constexpr static bool value = true;
     };
 
+    /// \brief specialization for validators with a range
+    template <typename FROM, typename TO>
+    struct is_validator_convertible<
+        FROM, TO,
+        std::enable_if_t<internal::has_range<FROM>::value &&
+                         internal::has_range<TO>::value>>
+    {
+        /// \brief validators are convertible if their ranges overlap
+        constexpr static bool value =
+            !internal::cmp_less(TO::max, FROM::min) &&
+            !internal::cmp_less(FROM::max, TO::min);
+    };
+
     template <typename FROM, typename TO>
 #if __cplusplus >= 201703L
     inline
 #endif
     constexpr auto is_validator_convertible_v =
-        is_validator_convertible<TO, FROM>::value;
+        is_validator_convertible<FROM, TO>::value;
+
+    /** \brief a trait to determine if a validator accepts every value in its
+     *         range (and nothing else)
+     *
+     * Validators like exception_validator and clamping_validator only care
+     * about a value's range, so any value that falls in that range can be
+     * stored without running them.  Validators with additional requirements
+     * (or no range at all) must leave this false.
+     *
+     * \tparam VALIDATOR the validator to check
+     */
+    template <typename VALIDATOR>
+    struct is_range_validator : std::false_type
+    {
+    };
+
+    /** \brief a trait to determine if converting between validators can skip
+     *         validation
+     *
+     * Conversion can skip validation if every value \a FROM can hold is
+     * acceptable to \a TO, which is true when \a TO is a range validator and
+     * \a FROM's range is a subset of \a TO's.
+     *
+     * \tparam FROM the validator being converted from
+     * \tparam TO   the validator being converted to
+     */
+    template <typename FROM, typename TO, typename = void>
+    struct is_validator_subset : std::false_type
+    {
+    };
+
+    /// \brief specialization for validators with a range
+    template <typename FROM, typename TO>
+    struct is_validator_subset<
+        FROM, TO,
+        std::enable_if_t<internal::has_range<FROM>::value &&
+                         is_range_validator<TO>::value>>
+      : std::integral_constant<bool, internal::range_within<FROM, TO>()>
+    {
+    };
+
+    /** \brief a tag to construct a constrained_value without validation
+     *
+     * The caller guarantees the value is already acceptable to the validator
+     * (e.g., because it was just clamped, or came from a constrained_value
+     * with a narrower range).  In debug builds, this is verified with assert;
+     * when NDEBUG is defined, the check is compiled out entirely.
+     */
+    struct unchecked_t
+    {
+        /// \cond false
+        explicit unchecked_t() = default;
+        /// \endcond
+    };
+
+    /// \brief an instance of unchecked_t
+    constexpr unchecked_t unchecked{};
 
     /** \brief An integral type constrained in some way
      *
@@ -126,9 +626,47 @@ namespace houseguest
         {
         }
 
+        /** \brief Construct a constrained_value from a validated value
+         *
+         * \internal
+         *
+         * \param value     The initial value.  \a value is stored as-is, so it
+         *                  must already be acceptable to \a validator.  Like
+         *                  unchecked, this is checked with assert in debug
+         *                  builds.
+         * \param validator a VALIDATOR to use
+         */
+        constexpr constrained_value(internal::prevalidated_t, T value,
+                                    VALIDATOR && validator = VALIDATOR{})
+          : _data{internal::prevalidated,
+                  internal::assume_valid(validator, std::move(value)),
+                  std::forward<VALIDATOR>(validator)}
+        {
+        }
+
+        /** \brief Construct a constrained_value without running the
+         *         validator
+         *
+         * This skips validation in hot paths where \a value is known to be
+         * acceptable: the validator is never run.
+         *
+         * \param value     The initial value.  \a value is stored as-is, so it
+         *                  must already be acceptable to \a validator.  This is
+         *                  checked with assert in debug builds.
+         * \param validator a VALIDATOR to use
+         */
+        constexpr constrained_value(unchecked_t, T value,
+                                    VALIDATOR && validator = VALIDATOR{})
+          : _data{internal::prevalidated,
+                  internal::assume_valid(validator, std::move(value)),
+                  std::forward<VALIDATOR>(validator)}
+        {
+        }
+
         /** \brief Construct a constrained_value from a different
          * constrained_value
          *
+         * \tparam OTHER_T         The integral type used by \a other.
          * \tparam OTHER_VALIDATOR The VALIDATOR used by \a other.  This
          *                         parameter is unused beyond matching
          *                         arbitrary constrained_values.
@@ -136,17 +674,31 @@ namespace houseguest
          * \param other A constrained_value to construct from.  \a other must
          *              be constrained in a way that's compatible with the
          *              constrained_value being constructed (i.e., there's at
-         *              least some overlap between valid ranges). \a other's
-         *              value will be passed through \a validator.
-         *              \param validator a VALIDATOR to use for the constructed
-         *              constrained_value
+         *              least some overlap between valid ranges).  If
+         *              is_validator_subset says every value \a other can hold
+         *              is acceptable, it's copied without validation;
+         *              otherwise, \a other's value will be passed through
+         *              \a validator.  If T can't represent every value
+         *              \a other can hold, the value is validated before
+         *              it's narrowed, so it's rejected or clamped instead
+         *              of wrapping.
+         * \param validator a VALIDATOR to use for the constructed
+         *                  constrained_value
          */
-        template <typename OTHER_VALIDATOR>
+        template <typename OTHER_T, typename OTHER_VALIDATOR>
         explicit constexpr constrained_value(
-            constrained_value<T, OTHER_VALIDATOR> const & other,
-            VALIDATOR && validator =
-                VALIDATOR{}) noexcept(noexcept(validator(static_cast<T>(other))))
-          : _data{static_cast<T>(other), std::forward<VALIDATOR>(validator)}
+            constrained_value<OTHER_T, OTHER_VALIDATOR> const & other,
+            VALIDATOR && validator = VALIDATOR{}) noexcept(
+            is_validator_subset<OTHER_VALIDATOR, VALIDATOR>::value ||
+            noexcept(validator(static_cast<T>(static_cast<OTHER_T>(other)))))
+          : constrained_value{
+                static_cast<OTHER_T>(other), std::forward<VALIDATOR>(validator),
+                std::conditional_t<
+                    internal::range_within<
+                        internal::value_range<OTHER_T, OTHER_VALIDATOR>,
+                        internal::value_range<T, void>>(),
+                    is_validator_subset<OTHER_VALIDATOR, VALIDATOR>,
+                    internal::narrowing_t>{}}
         {
             static_assert(
                 is_validator_convertible<OTHER_VALIDATOR, VALIDATOR>::value,
@@ -204,8 +756,77 @@ namespace houseguest
         /// \endcond
 
     private:
+        // converted values that are known to be acceptable
+        template <typename U>
+        constexpr constrained_value(U value, VALIDATOR && validator,
+                                    std::true_type)
+          : _data{internal::prevalidated, static_cast<T>(value),
+                  std::forward<VALIDATOR>(validator)}
+        {
+        }
+
+        // converted values that need validation
+        template <typename U>
+        constexpr constrained_value(U value, VALIDATOR && validator,
+                                    std::false_type)
+          : _data{static_cast<T>(value), std::forward<VALIDATOR>(validator)}
+        {
+        }
+
+        // converted values that need validation before T can hold them
+        template <typename U>
+        constexpr constrained_value(U value, VALIDATOR && validator,
+                                    internal::narrowing_t)
+          : _data{internal::prevalidated,
+                  internal::narrow<T>(validator, value),
+                  std::forward<VALIDATOR>(validator)}
+        {
+        }
+
         internal::constrained_value_storage<T, VALIDATOR> _data;
     };
+
+    namespace internal
+    {
+        // values with a range hash to their offset from min
+        template <typename VALIDATOR, typename T>
+        constexpr std::size_t hash_value(T value, std::true_type) noexcept
+        {
+            using unsigned_type = std::make_unsigned_t<T>;
+            return static_cast<std::size_t>(static_cast<unsigned_type>(
+                static_cast<unsigned_type>(value) -
+                static_cast<unsigned_type>(VALIDATOR::min)));
+        }
+
+        template <typename VALIDATOR, typename T>
+        std::size_t hash_value(T value, std::false_type) noexcept
+        {
+            return std::hash<T>{}(value);
+        }
+    } // namespace internal
 } // namespace houseguest
 
+namespace std
+{
+    /** \brief specialization for constrained_value
+     *
+     * If the validator has a range, values hash to their distance from its
+     * minimum, which never collides and keeps small ranges in a small number
+     * of buckets.  Otherwise, the underlying value is hashed.
+     */
+    template <typename T, typename VALIDATOR>
+    struct hash<houseguest::constrained_value<T, VALIDATOR>>
+    {
+        /// \brief hash \a value
+        std::size_t
+        operator()(houseguest::constrained_value<T, VALIDATOR> const & value)
+            const noexcept
+        {
+            return houseguest::internal::hash_value<VALIDATOR>(
+                static_cast<T>(value),
+                houseguest::internal::has_range<VALIDATOR>{});
+        }
+    };
+} // namespace std
+
 #endif
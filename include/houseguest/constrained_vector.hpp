@@ -0,0 +1,324 @@
+#ifndef HOUSEGUEST_CONSTRAINED_VECTOR_HPP
+#define HOUSEGUEST_CONSTRAINED_VECTOR_HPP 1
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <houseguest/bounded_algorithm.hpp>
+#include <houseguest/bounded_sort.hpp>
+#include <houseguest/constrained_iterator.hpp>
+#include <houseguest/constrained_value.hpp>
+
+namespace houseguest
+{
+    /** \brief a contiguous container of constrained values
+     *
+     * constrained_vector stores raw \a T values (exactly like an
+     * std::vector<T>), but every path that can change those values runs them
+     * through VALIDATOR first.  Bulk operations (assign, append, transform)
+     * validate the entire range in one pass rather than element by element.
+     *
+     * \tparam T         the integral type to store
+     * \tparam VALIDATOR the validator every stored value must satisfy.
+     *                   VALIDATOR is default-constructed whenever values
+     *                   need validation.
+     * \tparam ALLOCATOR the allocator for the underlying std::vector
+     */
+    template <typename T, typename VALIDATOR,
+              typename ALLOCATOR = std::allocator<T>>
+    class constrained_vector
+    {
+    public:
+        /// \brief the type produced when accessing elements
+        using value_type = constrained_value<T, VALIDATOR>;
+
+        /// \brief the integral type being stored
+        using underlying_type = T;
+
+        /// \brief the validator type
+        using validator = VALIDATOR;
+
+        /// \brief the type used for sizes and indices
+        using size_type = typename std::vector<T, ALLOCATOR>::size_type;
+
+        /// \brief an iterator that produces value_types
+        using const_iterator = constrained_iterator<T, VALIDATOR>;
+
+        /// \brief construct an empty constrained_vector
+        constrained_vector() = default;
+
+        /** \brief construct a constrained_vector from a range of raw values
+         *
+         * \param first the beginning of the values to store
+         * \param last  the end of the values to store
+         */
+        template <typename ITERATOR>
+        constrained_vector(ITERATOR first, ITERATOR last)
+        {
+            append(first, last);
+        }
+
+        /** \brief construct a constrained_vector from raw values
+         *
+         * \param values the values to store
+         */
+        constrained_vector(std::initializer_list<T> values)
+        {
+            append(std::begin(values), std::end(values));
+        }
+
+        /** \brief replace the contents with a range of raw values
+         *
+         * \param first the beginning of the values to store
+         * \param last  the end of the values to store
+         *
+         * \note If validation throws, the constrained_vector is left empty.
+         */
+        template <typename ITERATOR>
+        void assign(ITERATOR first, ITERATOR last)
+        {
+            _values.clear();
+            append(first, last);
+        }
+
+        /** \brief add a range of raw values to the end
+         *
+         * All new values are validated in a single pass after being copied
+         * in.
+         *
+         * \param first the beginning of the values to append
+         * \param last  the end of the values to append
+         *
+         * \note If validation throws, the constrained_vector is unchanged.
+         */
+        template <typename ITERATOR>
+        void append(ITERATOR first, ITERATOR last)
+        {
+            auto const old_size = _values.size();
+            _values.insert(std::end(_values), first, last);
+            try
+            {
+                auto const appended =
+                    std::begin(_values) +
+                    static_cast<std::ptrdiff_t>(old_size);
+                VALIDATOR v{};
+                internal::bulk_apply(v, appended, std::end(_values));
+            }
+            catch(...)
+            {
+                _values.resize(old_size);
+                throw;
+            }
+        }
+
+        /** \brief add a raw value to the end
+         *
+         * \param value the value to add.  \a value will be passed through
+         *              VALIDATOR prior to being stored.
+         */
+        void push_back(T value)
+        {
+            VALIDATOR v{};
+            _values.push_back(v(std::move(value)));
+        }
+
+        /** \brief add a constrained value to the end
+         *
+         * \param value the value to add.  It's already been validated, so it
+         *              will be stored without further checks.
+         */
+        void push_back(value_type const & value)
+        {
+            _values.push_back(static_cast<T>(value));
+        }
+
+        /// \brief remove the last value
+        void pop_back()
+        {
+            _values.pop_back();
+        }
+
+        /** \brief change the number of stored values
+         *
+         * \param count the new size
+         * \param value the value to use for any new elements
+         */
+        void resize(size_type count, value_type const & value)
+        {
+            _values.resize(count, static_cast<T>(value));
+        }
+
+        /** \brief replace a single value
+         *
+         * \param index the position to replace
+         * \param value the new value.  \a value will be passed through
+         *              VALIDATOR prior to being stored.
+         */
+        void set(size_type index, T value)
+        {
+            VALIDATOR v{};
+            _values[index] = v(std::move(value));
+        }
+
+        /** \brief replace a single value
+         *
+         * \param index the position to replace
+         * \param value the new value
+         */
+        void set(size_type index, value_type const & value)
+        {
+            _values[index] = static_cast<T>(value);
+        }
+
+        /** \brief apply a function to every value
+         *
+         * \a fn is applied to every value, then the results are validated in
+         * a single pass.  The results are only stored if \a fn and
+         * validation both succeed.
+         *
+         * \param fn a callable that takes a T and returns a T
+         *
+         * \note If \a fn or validation throws, the constrained_vector is left
+         *       unchanged.
+         */
+        template <typename FN>
+        void transform(FN && fn)
+        {
+            std::vector<T, ALLOCATOR> values{_values.get_allocator()};
+            values.reserve(_values.size());
+            std::transform(std::begin(_values), std::end(_values),
+                           std::back_inserter(values), std::forward<FN>(fn));
+            VALIDATOR v{};
+            internal::bulk_apply(v, std::begin(values), std::end(values));
+            _values.swap(values);
+        }
+
+        /** \brief sort the stored values in ascending order
+         *
+         * If VALIDATOR has a range, values are sorted by their offset from
+         * its minimum using houseguest::bounded_sort's counting or radix sort;
+         * otherwise, std::sort is used.
+         */
+        void sort()
+        {
+            sort_values(internal::has_range<VALIDATOR>{});
+        }
+
+        /** \brief sort the stored values
+         *
+         * Reordering values can't invalidate them, so no validation is
+         * performed.
+         *
+         * \param compare a comparison function over T
+         */
+        template <typename COMPARE>
+        void sort(COMPARE && compare)
+        {
+            std::sort(std::begin(_values), std::end(_values),
+                      std::forward<COMPARE>(compare));
+        }
+
+        /// \brief remove all values
+        void clear() noexcept
+        {
+            _values.clear();
+        }
+
+        /// \brief reserve space for at least \a count values
+        void reserve(size_type count)
+        {
+            _values.reserve(count);
+        }
+
+        /// \brief get the number of values that fit without reallocation
+        size_type capacity() const noexcept
+        {
+            return _values.capacity();
+        }
+
+        /// \brief get the number of stored values
+        size_type size() const noexcept
+        {
+            return _values.size();
+        }
+
+        /// \brief determine if there are no stored values
+        bool empty() const noexcept
+        {
+            return _values.empty();
+        }
+
+        /** \brief get raw access to the stored values
+         *
+         * \return A pointer to size() contiguous values, each of which
+         *         satisfies VALIDATOR.
+         */
+        T const * data() const noexcept
+        {
+            return _values.data();
+        }
+
+        /// \brief access a stored value
+        value_type operator[](size_type index) const
+        {
+            return value_type{internal::prevalidated, _values[index]};
+        }
+
+        /** \brief access a stored value with bounds checking
+         *
+         * \throw std::out_of_range if \a index isn't less-than size()
+         */
+        value_type at(size_type index) const
+        {
+            return value_type{internal::prevalidated, _values.at(index)};
+        }
+
+        /// \brief get an iterator to the first value
+        const_iterator begin() const noexcept
+        {
+            return const_iterator{_values.data()};
+        }
+
+        /// \brief get an iterator past the last value
+        const_iterator end() const noexcept
+        {
+            return const_iterator{_values.data() + _values.size()};
+        }
+
+        /// \cond false
+        friend bool operator==(constrained_vector const & lhs,
+                               constrained_vector const & rhs)
+        {
+            return lhs._values == rhs._values;
+        }
+
+        friend bool operator!=(constrained_vector const & lhs,
+                               constrained_vector const & rhs)
+        {
+            return lhs._values != rhs._values;
+        }
+        /// \endcond
+
+    private:
+        void sort_values(std::true_type)
+        {
+            internal::range_sort<VALIDATOR>(std::begin(_values),
+                                            std::end(_values));
+        }
+
+        void sort_values(std::false_type)
+        {
+            std::sort(std::begin(_values), std::end(_values));
+        }
+
+        std::vector<T, ALLOCATOR> _values;
+    };
+} // namespace houseguest
+
+#endif
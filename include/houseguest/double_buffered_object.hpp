@@ -0,0 +1,360 @@
+#ifndef HOUSEGUEST_DOUBLE_BUFFERED_OBJECT_HPP
+#define HOUSEGUEST_DOUBLE_BUFFERED_OBJECT_HPP 1
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+/** \file
+ *
+ * \brief An object with a single producer and many readers that never block
+ *        each other
+ */
+
+namespace houseguest
+{
+    template <typename T, std::size_t BUFFERS>
+    class double_buffered_object;
+
+    /** \brief A class to provide access to the newest published copy of an
+     *         object
+     *
+     * A buffer_read_handle keeps its copy from being reused by the producer,
+     * but doesn't stop newer copies from being published.
+     *
+     * \tparam T       The type being managed
+     * \tparam BUFFERS The number of copies of T
+     */
+    template <typename T, std::size_t BUFFERS>
+#if __cplusplus >= 201703L
+    class [[nodiscard]] buffer_read_handle
+#else
+    class buffer_read_handle
+#endif
+    {
+    public:
+        /// \cond false
+        buffer_read_handle(T const & t, std::atomic<std::size_t> & readers,
+                           std::uint64_t version) noexcept
+          : _t{&t}
+          , _readers{&readers}
+          , _version{version}
+        {
+        }
+        /// \endcond
+
+        buffer_read_handle(buffer_read_handle && other) noexcept
+          : _t{other._t}
+          , _readers{other._readers}
+          , _version{other._version}
+        {
+            other._readers = nullptr;
+        }
+
+        buffer_read_handle(buffer_read_handle const &) = delete;
+        buffer_read_handle & operator=(buffer_read_handle const &) = delete;
+        buffer_read_handle & operator=(buffer_read_handle &&) = delete;
+
+        ~buffer_read_handle()
+        {
+            if(_readers != nullptr)
+            {
+                _readers->fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        /** \brief Retreive a reference to the managed object
+         *
+         * \return A reference to the managed object
+         */
+        T const & operator*() const noexcept
+        {
+            return *_t;
+        }
+
+        /** \brief Retreive a pointer to the managed object
+         *
+         * \return A pointer to the managed object
+         */
+        T const * operator->() const noexcept
+        {
+            return _t;
+        }
+
+        /** \brief Get the number of times the object had been published when
+         *         this copy was read
+         */
+        std::uint64_t version() const noexcept
+        {
+            return _version;
+        }
+
+    private:
+        T const * _t;
+        std::atomic<std::size_t> * _readers;
+        std::uint64_t _version;
+    };
+
+    /** \brief A class to provide access to the producer's private copy of an
+     *         object
+     *
+     * Changes are invisible to readers until the buffer_write_handle is
+     * destroyed, at which point they're published all at once.
+     *
+     * \tparam T       The type being managed
+     * \tparam BUFFERS The number of copies of T
+     */
+    template <typename T, std::size_t BUFFERS>
+#if __cplusplus >= 201703L
+    class [[nodiscard]] buffer_write_handle
+#else
+    class buffer_write_handle
+#endif
+    {
+    public:
+        /// \brief Construct an empty buffer_write_handle
+        buffer_write_handle() noexcept = default;
+
+        /// \cond false
+        buffer_write_handle(double_buffered_object<T, BUFFERS> & owner,
+                            std::size_t index) noexcept
+          : _owner{&owner}
+          , _index{index}
+        {
+        }
+        /// \endcond
+
+        buffer_write_handle(buffer_write_handle && other) noexcept
+          : _owner{other._owner}
+          , _index{other._index}
+        {
+            other._owner = nullptr;
+        }
+
+        buffer_write_handle(buffer_write_handle const &) = delete;
+        buffer_write_handle & operator=(buffer_write_handle const &) = delete;
+        buffer_write_handle & operator=(buffer_write_handle &&) = delete;
+
+        /// \brief Publish the changes
+        ~buffer_write_handle()
+        {
+            if(_owner != nullptr)
+            {
+                _owner->publish(_index);
+            }
+        }
+
+        /// \brief Determine if the handle holds a buffer
+        explicit operator bool() const noexcept
+        {
+            return _owner != nullptr;
+        }
+
+        /** \brief Retreive a reference to the managed object
+         *
+         * \return A reference to the managed object
+         */
+        T & operator*() const noexcept
+        {
+            return _owner->buffer(_index);
+        }
+
+        /** \brief Retrieve a pointer to the managed object
+         *
+         * \return A pointer to the managed object
+         */
+        T * operator->() const noexcept
+        {
+            return &_owner->buffer(_index);
+        }
+
+    private:
+        double_buffered_object<T, BUFFERS> * _owner = nullptr;
+        std::size_t _index = 0;
+    };
+
+    namespace internal
+    {
+        template <typename T, typename... Ts, std::size_t... Is>
+        std::array<T, sizeof...(Is)> make_buffers(std::index_sequence<Is...>,
+                                                  Ts const &... ts)
+        {
+            // each element is built separately from the same arguments
+            return {{((void)Is, T{ts...})...}};
+        }
+    } // namespace internal
+
+    /** \brief Provide lock-free publication of an object from one producer
+     *         to many readers
+     *
+     * The producer fills a private back buffer through write and publishes
+     * it with a single atomic store when the handle is destroyed.  Readers
+     * get the most recently published buffer through read.  Neither side
+     * takes a lock, and readers never wait for the producer to finish
+     * writing.
+     *
+     * A buffer can't be written while any reader holds it, so the producer
+     * needs a buffer that's neither the published one nor held by a reader.
+     * With three buffers (the default), the producer never waits as long as
+     * readers release their handles before two more buffers are published;
+     * more buffers let readers linger on older copies.
+     *
+     * \tparam T       The type to manage.  Each buffer holds its own T.
+     * \tparam BUFFERS The number of copies of T.  At least two are required.
+     *
+     * \note Only one thread may write at a time.
+     * \note A write handle starts with whatever its buffer held when it was
+     *       last written (or constructed), not the newest published value.
+     *       Producers should overwrite everything they publish.
+     */
+    template <typename T, std::size_t BUFFERS = 3>
+    class double_buffered_object
+    {
+        static_assert(BUFFERS >= 2, "At least two buffers are required");
+
+    public:
+        /// \brief The type that provides write access to a \a T
+        using write_handle_type = buffer_write_handle<T, BUFFERS>;
+
+        /// \brief The type that provides read access to a \a T
+        using read_handle_type = buffer_read_handle<T, BUFFERS>;
+
+        /** \brief Construct a double_buffered_object
+         *
+         * \tparam Ts Any extra types passed to the constructor
+         *
+         * \param ts Extra arguments passed to every buffer's constructor.
+         */
+        template <typename... Ts>
+        explicit double_buffered_object(Ts const &... ts)
+          : _buffers{internal::make_buffers<T>(
+                std::make_index_sequence<BUFFERS>{}, ts...)}
+        {
+            for(auto & readers : _readers)
+            {
+                readers.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        double_buffered_object(double_buffered_object const &) = delete;
+        double_buffered_object &
+        operator=(double_buffered_object const &) = delete;
+
+        /** \brief Construct a write_handle for a back buffer
+         *
+         * If every back buffer is held by a reader, this yields until one is
+         * released.
+         *
+         * \return A write_handle to fill in the next version of T
+         */
+        auto write()
+        {
+            std::size_t index = 0;
+            while(!find_back_buffer(index))
+            {
+                std::this_thread::yield();
+            }
+            return write_handle_type{*this, index};
+        }
+
+        /** \brief Construct a write_handle for a back buffer without waiting
+         *
+         * \return A write_handle to fill in the next version of T, or an
+         *         empty handle if every back buffer is held by a reader
+         */
+        write_handle_type try_write() noexcept
+        {
+            std::size_t index = 0;
+            if(!find_back_buffer(index))
+            {
+                return write_handle_type{};
+            }
+            return write_handle_type{*this, index};
+        }
+
+        /** \brief Construct a read_handle for the newest published buffer
+         *
+         * This never waits for the producer.  It only retries if a new
+         * buffer is published while it's starting.
+         *
+         * \return A read_handle to the newest T
+         */
+        read_handle_type read() const noexcept
+        {
+            auto published = _published.load(std::memory_order_seq_cst);
+            while(true)
+            {
+                auto & readers = _readers[index_of(published)];
+                readers.fetch_add(1, std::memory_order_seq_cst);
+                // if the buffer is still published, the producer can't have
+                // chosen it, and won't until it's released
+                auto const current =
+                    _published.load(std::memory_order_seq_cst);
+                if(current == published)
+                {
+                    return read_handle_type{_buffers[index_of(published)],
+                                            readers, version_of(published)};
+                }
+                readers.fetch_sub(1, std::memory_order_release);
+                published = current;
+            }
+        }
+
+        /// \brief Get the number of times a buffer has been published
+        std::uint64_t version() const noexcept
+        {
+            return version_of(_published.load(std::memory_order_acquire));
+        }
+
+    private:
+        friend write_handle_type;
+
+        static std::size_t index_of(std::uint64_t published) noexcept
+        {
+            return static_cast<std::size_t>(published % BUFFERS);
+        }
+
+        static std::uint64_t version_of(std::uint64_t published) noexcept
+        {
+            return published / BUFFERS;
+        }
+
+        bool find_back_buffer(std::size_t & index) const noexcept
+        {
+            auto const published =
+                index_of(_published.load(std::memory_order_relaxed));
+            for(std::size_t i = 1; i < BUFFERS; ++i)
+            {
+                index = (published + i) % BUFFERS;
+                if(_readers[index].load(std::memory_order_seq_cst) == 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        T & buffer(std::size_t index) noexcept
+        {
+            return _buffers[index];
+        }
+
+        void publish(std::size_t index) noexcept
+        {
+            // the version and index change together, so a buffer that's
+            // republished never looks unchanged to a reader
+            auto const next =
+                (version() + 1) * BUFFERS + static_cast<std::uint64_t>(index);
+            _published.store(next, std::memory_order_seq_cst);
+        }
+
+        std::array<T, BUFFERS> _buffers;
+        mutable std::atomic<std::size_t> _readers[BUFFERS];
+        std::atomic<std::uint64_t> _published{0};
+    };
+} // namespace houseguest
+
+#endif
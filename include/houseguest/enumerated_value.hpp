@@ -0,0 +1,333 @@
+#ifndef HOUSEGUEST_ENUMERATED_VALUE_HPP
+#define HOUSEGUEST_ENUMERATED_VALUE_HPP 1
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include <houseguest/bounded_value.hpp>
+#include <houseguest/composite_validator.hpp>
+#include <houseguest/constrained_value.hpp>
+
+/** \file
+ *
+ * \brief Validators for values restricted to a fixed set
+ *
+ * Membership is tested with a strategy chosen at compile time:
+ * - if every value fits in a 64-value window, a single 64-bit mask
+ * - otherwise, a perfect hash table (one multiply, one shift, one load, and
+ *   one compare) if a collision-free multiplier can be found
+ * - otherwise, a branch-free binary search over the sorted values
+ */
+
+namespace houseguest
+{
+    namespace internal
+    {
+        /** \brief a fixed-size array that can be modified in constant
+         *         expressions
+         *
+         * std::array's non-const members aren't constexpr until C++17.
+         */
+        template <typename T, std::size_t N>
+        struct constexpr_array
+        {
+            /// \brief get a value
+            constexpr T const & operator[](std::size_t index) const noexcept
+            {
+                return values[index];
+            }
+
+            /// \brief the stored values
+            T values[N];
+        };
+
+        template <typename T, std::size_t N>
+        constexpr constexpr_array<T, N>
+        sort_values(constexpr_array<T, N> values) noexcept
+        {
+            // insertion sort; sets are small and this only runs at compile
+            // time
+            for(std::size_t i = 1; i < N; ++i)
+            {
+                auto const value = values.values[i];
+                auto j = i;
+                for(; (j > 0) && (value < values.values[j - 1]); --j)
+                {
+                    values.values[j] = values.values[j - 1];
+                }
+                values.values[j] = value;
+            }
+            return values;
+        }
+
+        template <typename T, std::size_t N>
+        constexpr bool all_distinct(constexpr_array<T, N> sorted) noexcept
+        {
+            for(std::size_t i = 1; i < N; ++i)
+            {
+                if(sorted[i - 1] == sorted[i])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// \brief the hash used by hashed_set
+        template <typename T>
+        constexpr std::size_t set_hash(T value, unsigned bits,
+                                       std::uint64_t seed) noexcept
+        {
+            auto const key = static_cast<std::uint64_t>(
+                static_cast<std::make_unsigned_t<T>>(value));
+            return static_cast<std::size_t>((key * seed) >> (64 - bits));
+        }
+
+        /// \brief the largest table a perfect hash will use, in bits
+        constexpr unsigned max_hash_bits = 12;
+
+        /// \brief the number of multipliers tried for each table size
+        constexpr unsigned hash_seed_attempts = 128;
+
+        /// \brief parameters for a perfect hash
+        struct hash_parameters
+        {
+            unsigned bits;
+            std::uint64_t seed;
+        };
+
+        template <typename T, std::size_t N>
+        constexpr bool is_perfect_hash(constexpr_array<T, N> const & values,
+                                       unsigned bits,
+                                       std::uint64_t seed) noexcept
+        {
+            std::uint64_t used[(1U << max_hash_bits) / 64] = {};
+            for(std::size_t i = 0; i < N; ++i)
+            {
+                auto const slot = set_hash(values[i], bits, seed);
+                auto const bit = std::uint64_t{1} << (slot % 64);
+                if((used[slot / 64] & bit) != 0)
+                {
+                    return false;
+                }
+                used[slot / 64] |= bit;
+            }
+            return true;
+        }
+
+        /** \brief search for a collision-free multiplicative hash
+         *
+         * Tables between 2 and 16 times the number of values are tried.
+         *
+         * \return The parameters found, or bits of 0 if no perfect hash was
+         *         found.
+         */
+        template <typename T, std::size_t N>
+        constexpr hash_parameters
+        find_perfect_hash(constexpr_array<T, N> const & values) noexcept
+        {
+            auto const first_bits = bits_required(N - 1) + 1;
+            for(auto bits = first_bits;
+                (bits < first_bits + 4) && (bits <= max_hash_bits); ++bits)
+            {
+                for(std::uint64_t attempt = 0; attempt < hash_seed_attempts;
+                    ++attempt)
+                {
+                    // odd multiples of the golden ratio
+                    auto const seed =
+                        0x9E3779B97F4A7C15ULL * ((attempt * 2) + 1);
+                    if(is_perfect_hash(values, bits, seed))
+                    {
+                        return {bits, seed};
+                    }
+                }
+            }
+            return {0, 0};
+        }
+
+        /// \brief test membership with a 64-bit mask
+        template <typename T, T MIN, T MAX, T... VALUES>
+        struct bitmask_set
+        {
+            using range = bounded_validator<T, MIN, MAX>;
+
+            static constexpr std::uint64_t bits = fold_or(
+                {(std::uint64_t{1} << range_offset<range>(VALUES))...});
+
+            static constexpr bool test(T value) noexcept
+            {
+                auto const offset = range_offset<range>(value);
+                // the shift is masked so it's always defined; the range
+                // check rejects anything it wraps
+                return (offset <= range_span<range>()) &
+                       (((bits >> (offset % 64)) & 1) != 0);
+            }
+        };
+
+        /// \brief test membership with a perfect hash
+        template <typename T, unsigned BITS, std::uint64_t SEED, T... VALUES>
+        struct hashed_set
+        {
+            static constexpr std::size_t table_size = std::size_t{1} << BITS;
+
+            static constexpr constexpr_array<T, table_size> make_table()
+            {
+                constexpr_array<T, sizeof...(VALUES)> const values{
+                    {VALUES...}};
+                constexpr_array<T, table_size> result{};
+                // Unused slots hold a value that hashes elsewhere, so they
+                // never match.
+                for(std::size_t i = 0; i < table_size; ++i)
+                {
+                    result.values[i] = values[0];
+                }
+                for(std::size_t i = 0; i < sizeof...(VALUES); ++i)
+                {
+                    result.values[set_hash(values[i], BITS, SEED)] =
+                        values[i];
+                }
+                return result;
+            }
+
+            static constexpr constexpr_array<T, table_size> table =
+                make_table();
+
+            static constexpr bool test(T value) noexcept
+            {
+                return table[set_hash(value, BITS, SEED)] == value;
+            }
+        };
+
+#if __cplusplus < 201703L
+        /// \cond false
+        template <typename T, unsigned BITS, std::uint64_t SEED, T... VALUES>
+        constexpr constexpr_array<
+            T, hashed_set<T, BITS, SEED, VALUES...>::table_size>
+            hashed_set<T, BITS, SEED, VALUES...>::table;
+        /// \endcond
+#endif
+
+        /// \brief test membership with a binary search
+        template <typename T, T... VALUES>
+        struct sorted_set
+        {
+            static constexpr std::size_t size = sizeof...(VALUES);
+
+            static constexpr constexpr_array<T, size> values =
+                sort_values(constexpr_array<T, size>{{VALUES...}});
+
+            static constexpr bool test(T value) noexcept
+            {
+                std::size_t first = 0;
+                std::size_t length = size;
+                while(length > 1)
+                {
+                    auto const half = length / 2;
+                    first = (values[first + half] <= value) ? first + half
+                                                            : first;
+                    length -= half;
+                }
+                return values[first] == value;
+            }
+        };
+
+#if __cplusplus < 201703L
+        /// \cond false
+        template <typename T, T... VALUES>
+        constexpr constexpr_array<T, sorted_set<T, VALUES...>::size>
+            sorted_set<T, VALUES...>::values;
+        /// \endcond
+#endif
+
+        template <typename T, T... VALUES>
+        struct one_of_traits
+        {
+            static_assert(std::is_integral<T>::value, "T must be integral");
+            static_assert(sizeof...(VALUES) > 0,
+                          "At least one value is required");
+
+            static constexpr T min = fold_min<T>({VALUES...});
+            static constexpr T max = fold_max<T>({VALUES...});
+
+            static constexpr constexpr_array<T, sizeof...(VALUES)> values{
+                {VALUES...}};
+
+            static_assert(all_distinct(sort_values(values)),
+                          "Values must be distinct");
+
+            using range = bounded_validator<T, min, max>;
+
+            static constexpr hash_parameters hash =
+                (range_span<range>() < 64) ? hash_parameters{0, 0}
+                                           : find_perfect_hash(values);
+
+            using set = std::conditional_t<
+                (range_span<range>() < 64),
+                bitmask_set<T, min, max, VALUES...>,
+                std::conditional_t<
+                    (hash.bits != 0),
+                    hashed_set<T, hash.bits, hash.seed, VALUES...>,
+                    sorted_set<T, VALUES...>>>;
+        };
+    } // namespace internal
+
+    /** \brief a validator that only accepts values in a fixed set
+     *
+     * one_of_validator has a range (the smallest and largest values in the
+     * set), so it converts to and from bounded types like any other ranged
+     * validator.  Since the range includes values that aren't in the set,
+     * it's not a range validator.
+     *
+     * \tparam T      the integral type to operate on
+     * \tparam VALUES the acceptable values.  These must be distinct, but can
+     *                be in any order.
+     */
+    template <typename T, T... VALUES>
+    struct one_of_validator
+      : bounded_validator<T, internal::one_of_traits<T, VALUES...>::min,
+                          internal::one_of_traits<T, VALUES...>::max>
+    {
+        /// \brief determine if \a value is in the set
+        static constexpr bool test(T value) noexcept
+        {
+            return internal::one_of_traits<T, VALUES...>::set::test(value);
+        }
+
+        /** \brief check if \a value is in the set
+         *
+         * \retval constraint_error::success    \a value is acceptable
+         * \retval constraint_error::not_member \a value isn't acceptable
+         */
+        constexpr constraint_error check(T value) const noexcept
+        {
+            return test(value) ? constraint_error::success
+                               : constraint_error::not_member;
+        }
+
+        /** \brief validate \a value is in the set
+         *
+         * \param value the value to validate
+         *
+         * \retval value The only thing this function will return.
+         *
+         * \throw std::system_error if \a value isn't in the set
+         */
+        constexpr T operator()(T value) const
+        {
+            return internal::apply_constraint(*this, value);
+        }
+    };
+
+    /** \brief a constrained_value that only accepts values in a fixed set
+     *
+     * \tparam T      the integral type to operate on
+     * \tparam VALUES the acceptable values
+     */
+    template <typename T, T... VALUES>
+    using enumerated_value =
+        constrained_value<T, one_of_validator<T, VALUES...>>;
+} // namespace houseguest
+
+#endif
@@ -0,0 +1,402 @@
+#ifndef HOUSEGUEST_INSTRUMENTED_VALIDATOR_HPP
+#define HOUSEGUEST_INSTRUMENTED_VALIDATOR_HPP 1
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include <houseguest/bounded_parse.hpp>
+#include <houseguest/bounded_value.hpp>
+#include <houseguest/constrained_value.hpp>
+#include <houseguest/mutex.hpp>
+
+/** \file
+ *
+ * \brief Opt-in counting of how often validators see out-of-range values
+ *
+ * Wrapping a validator in instrumented_validator counts every value passed
+ * through it as in range, below min, or above max, so silent clamping (or
+ * frequent rejection) shows up in metrics.  Counting is disabled unless
+ * HOUSEGUEST_INSTRUMENT_VALIDATORS is defined before this header is
+ * included; while disabled, instrumented_validator<VALIDATOR> is exactly
+ * VALIDATOR, so there's no cost of any kind.  The snapshot functions are
+ * available either way (and report nothing while disabled), so code that
+ * scrapes them doesn't need to change.
+ *
+ * \note HOUSEGUEST_INSTRUMENT_VALIDATORS must be defined the same way in every
+ *       translation unit of a program.
+ */
+
+namespace houseguest
+{
+    /// \brief counts of values seen by an instrumented validator
+    struct validation_snapshot
+    {
+        /// \brief values between min and max
+        std::uint64_t in_range = 0;
+
+        /// \brief values less-than min
+        std::uint64_t below_min = 0;
+
+        /// \brief values greater-than max
+        std::uint64_t above_max = 0;
+
+        /// \brief get the total number of values seen
+        constexpr std::uint64_t total() const noexcept
+        {
+            return in_range + below_min + above_max;
+        }
+    };
+
+    /// \brief the counts for a single validator type
+    struct named_validation_snapshot
+    {
+        /// \brief the validator's name, as reported by std::type_info::name
+        char const * validator;
+
+        /// \brief the validator's counts
+        validation_snapshot counts;
+    };
+
+    namespace internal
+    {
+        /// \brief the possible outcomes of validating a value
+        enum class validation_event
+        {
+            in_range,
+            below_min,
+            above_max
+        };
+
+        /** \brief counters updated by a single thread
+         *
+         * Only the owning thread writes, so relaxed increments never contend;
+         * other threads only read while taking a snapshot.
+         */
+        struct thread_validation_counters
+        {
+            std::atomic<std::uint64_t> in_range{0};
+            std::atomic<std::uint64_t> below_min{0};
+            std::atomic<std::uint64_t> above_max{0};
+
+            void record(validation_event event) noexcept
+            {
+                auto & counter =
+                    (event == validation_event::in_range)
+                        ? in_range
+                        : ((event == validation_event::below_min) ? below_min
+                                                                  : above_max);
+                counter.store(counter.load(std::memory_order_relaxed) + 1,
+                              std::memory_order_relaxed);
+            }
+
+            void add_to(validation_snapshot & snapshot) const noexcept
+            {
+                snapshot.in_range += in_range.load(std::memory_order_relaxed);
+                snapshot.below_min +=
+                    below_min.load(std::memory_order_relaxed);
+                snapshot.above_max +=
+                    above_max.load(std::memory_order_relaxed);
+            }
+        };
+
+        class validation_statistics;
+
+        /// \brief every validation_statistics that has been created
+        class validation_registry
+        {
+        public:
+            static validation_registry & instance()
+            {
+                static validation_registry registry;
+                return registry;
+            }
+
+            void add(validation_statistics * statistics)
+            {
+                std::lock_guard<mutex> const lock{_mutex};
+                _statistics.push_back(statistics);
+            }
+
+            std::vector<validation_statistics *> statistics() const
+            {
+                std::lock_guard<mutex> const lock{_mutex};
+                return _statistics;
+            }
+
+        private:
+            mutable mutex _mutex;
+            std::vector<validation_statistics *> _statistics;
+        };
+
+        /** \brief the counts for a single validator type
+         *
+         * Each thread that records an event registers its own counters.  When
+         * a thread exits, its counts are folded into a running total.
+         */
+        class validation_statistics
+        {
+        public:
+            explicit validation_statistics(char const * name)
+              : _name{name}
+            {
+                validation_registry::instance().add(this);
+            }
+
+            char const * name() const noexcept
+            {
+                return _name;
+            }
+
+            void attach(thread_validation_counters * counters)
+            {
+                std::lock_guard<mutex> const lock{_mutex};
+                _threads.push_back(counters);
+            }
+
+            void detach(thread_validation_counters * counters)
+            {
+                std::lock_guard<mutex> const lock{_mutex};
+                counters->add_to(_exited);
+                for(auto & thread : _threads)
+                {
+                    if(thread == counters)
+                    {
+                        thread = _threads.back();
+                        _threads.pop_back();
+                        break;
+                    }
+                }
+            }
+
+            validation_snapshot snapshot() const
+            {
+                std::lock_guard<mutex> const lock{_mutex};
+                auto ret = _exited;
+                for(auto const * thread : _threads)
+                {
+                    thread->add_to(ret);
+                }
+                return ret;
+            }
+
+        private:
+            char const * _name;
+            mutable mutex _mutex;
+            std::vector<thread_validation_counters *> _threads;
+            validation_snapshot _exited;
+        };
+
+        template <typename VALIDATOR>
+        validation_statistics & statistics_for()
+        {
+            static validation_statistics statistics{
+                typeid(VALIDATOR).name()};
+            return statistics;
+        }
+
+        /// \brief a thread's counters, registered for as long as the thread
+        ///        runs
+        template <typename VALIDATOR>
+        class thread_validation_registration
+        {
+        public:
+            thread_validation_registration()
+              : _statistics{statistics_for<VALIDATOR>()}
+            {
+                _statistics.attach(&_counters);
+            }
+
+            ~thread_validation_registration()
+            {
+                _statistics.detach(&_counters);
+            }
+
+            thread_validation_registration(
+                thread_validation_registration const &) = delete;
+            thread_validation_registration &
+            operator=(thread_validation_registration const &) = delete;
+
+            void record(validation_event event) noexcept
+            {
+                _counters.record(event);
+            }
+
+        private:
+            validation_statistics & _statistics;
+            thread_validation_counters _counters;
+        };
+
+        template <typename VALIDATOR>
+        void record_validation(validation_event event)
+        {
+            thread_local thread_validation_registration<VALIDATOR>
+                registration;
+            registration.record(event);
+        }
+
+        /** \brief a validator that counts the values it sees
+         *
+         * \tparam VALIDATOR the validator to count values for.  It must have a
+         *                   range.
+         * \tparam COUNTED   the validator the counts are reported for.  This
+         *                   differs from VALIDATOR only when VALIDATOR has
+         *                   been widened to validate a conversion.
+         */
+        template <typename VALIDATOR, typename COUNTED = VALIDATOR>
+        struct counting_validator : VALIDATOR
+        {
+            static_assert(has_range<VALIDATOR>::value,
+                          "Instrumentation requires a validator with a range");
+
+            template <typename T>
+            decltype(auto) operator()(T && value) const
+            {
+                record(value);
+                return VALIDATOR::operator()(std::forward<T>(value));
+            }
+
+            /// \brief count \a value, then forward to VALIDATOR's check
+            ///        (e.g., for try_make or parse)
+            template <typename T, typename V = VALIDATOR>
+            auto check(T value) const
+                -> decltype(std::declval<V const &>().check(value))
+            {
+                record(value);
+                return V::check(value);
+            }
+
+        private:
+            template <typename T>
+            static void record(T const & value)
+            {
+                record_validation<COUNTED>(
+                    cmp_less(value, VALIDATOR::min)
+                        ? validation_event::below_min
+                        : (cmp_less(VALIDATOR::max, value)
+                               ? validation_event::above_max
+                               : validation_event::in_range));
+            }
+        };
+
+        /// \cond false
+        // parse checks the range itself, so count what it decided
+        template <typename VALIDATOR, typename COUNTED>
+        struct parse_observer<counting_validator<VALIDATOR, COUNTED>>
+        {
+            static void observe(parse_status status)
+            {
+                record_validation<COUNTED>(
+                    (status == parse_status::below_min)
+                        ? validation_event::below_min
+                        : ((status == parse_status::above_max)
+                               ? validation_event::above_max
+                               : validation_event::in_range));
+            }
+        };
+
+        template <typename VALIDATOR, typename COUNTED>
+        struct clamps<counting_validator<VALIDATOR, COUNTED>>
+          : clamps<VALIDATOR>
+        {
+        };
+
+        template <typename WIDE, typename COUNTED>
+        struct widened_counting_validator
+        {
+            using type = counting_validator<WIDE, COUNTED>;
+        };
+
+        template <typename COUNTED>
+        struct widened_counting_validator<void, COUNTED>
+        {
+            using type = void;
+        };
+
+        // conversions are validated in the wider type, but still counted
+        // for the original validator
+        template <typename VALIDATOR, typename COUNTED, typename U>
+        struct widened_validator<counting_validator<VALIDATOR, COUNTED>, U>
+          : widened_counting_validator<
+                typename widened_validator<VALIDATOR, U>::type, COUNTED>
+        {
+        };
+        /// \endcond
+    } // namespace internal
+
+    /// \brief specialization for counting_validator
+    template <typename VALIDATOR, typename COUNTED>
+    struct is_range_validator<internal::counting_validator<VALIDATOR, COUNTED>>
+      : is_range_validator<VALIDATOR>
+    {
+    };
+
+    /** \brief a validator that counts how often values fall outside
+     *         VALIDATOR's range
+     *
+     * Every value passed through the validator (or its check function, as
+     * try_make does) is counted before VALIDATOR sees it, so clamped and
+     * rejected values are both counted.  Numbers read by parse are counted
+     * too, even though parse checks the range itself.  Counts are
+     * kept per thread with relaxed atomics and combined by
+     * validation_counts.  Values that never reach the validator (e.g.,
+     * constrained_values copied from one another, or the results of
+     * saturating arithmetic) aren't counted.
+     *
+     * The instrumented validator has the same traits as VALIDATOR (e.g.,
+     * is_range_validator), so it works everywhere VALIDATOR does.
+     *
+     * If HOUSEGUEST_INSTRUMENT_VALIDATORS isn't defined, this is VALIDATOR.
+     *
+     * \tparam VALIDATOR a validator with a range (e.g., clamping_validator)
+     */
+#if defined(HOUSEGUEST_INSTRUMENT_VALIDATORS)
+    template <typename VALIDATOR>
+    using instrumented_validator = internal::counting_validator<VALIDATOR>;
+#else
+    template <typename VALIDATOR>
+    using instrumented_validator = VALIDATOR;
+#endif
+
+    /** \brief get the counts for an instrumented validator
+     *
+     * \tparam VALIDATOR the validator passed to instrumented_validator
+     *
+     * \return Everything counted so far, from every thread.  If
+     *         instrumentation is disabled, every count is zero.
+     */
+    template <typename VALIDATOR>
+    validation_snapshot validation_counts()
+    {
+#if defined(HOUSEGUEST_INSTRUMENT_VALIDATORS)
+        return internal::statistics_for<VALIDATOR>().snapshot();
+#else
+        return {};
+#endif
+    }
+
+    /** \brief get the counts for every instrumented validator that has seen a
+     *         value
+     *
+     * This is intended for exporting to a metrics system.  If
+     * instrumentation is disabled, the result is empty.
+     */
+    inline std::vector<named_validation_snapshot> all_validation_counts()
+    {
+        std::vector<named_validation_snapshot> ret;
+#if defined(HOUSEGUEST_INSTRUMENT_VALIDATORS)
+        for(auto const * statistics :
+            internal::validation_registry::instance().statistics())
+        {
+            ret.push_back({statistics->name(), statistics->snapshot()});
+        }
+#endif
+        return ret;
+    }
+} // namespace houseguest
+
+#endif
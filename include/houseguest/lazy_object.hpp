@@ -0,0 +1,191 @@
+#ifndef HOUSEGUEST_LAZY_OBJECT_HPP
+#define HOUSEGUEST_LAZY_OBJECT_HPP 1
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <new>
+#include <utility>
+
+#include <houseguest/lock.hpp>
+#include <houseguest/mutex.hpp>
+#include <houseguest/thread_safe_object.hpp>
+
+/** \file
+ *
+ * \brief Thread-safe objects that aren't constructed until they're needed
+ */
+
+namespace houseguest
+{
+    /** \brief Provide a thread-safe wrapper around a type that's constructed
+     *         on first use
+     *
+     * lazy_object offers the same read and write handles as
+     * threadsafe_object, but the managed T isn't created until something
+     * asks for it.  Expensive state that may never be used (e.g., parsed
+     * rules or compiled tables) costs nothing at startup, and prewarm can
+     * build it on another thread before it's needed.
+     *
+     * Initialization is double-checked: once T exists, determining that it
+     * exists is a single acquire load, with no locking.  Only threads that
+     * arrive before T exists contend for a lock, and exactly one of them
+     * constructs it.
+     *
+     * \tparam T     The type to manage.
+     * \tparam MUTEX The mutex to handle locking for read and write handles.
+     *               This type must support both unique and shared locks.
+     */
+    template <typename T, typename MUTEX = houseguest::shared_mutex>
+    class lazy_object
+    {
+    public:
+        /// \brief The type that provides write access to a \a T
+        using write_handle_type = write_handle<T, MUTEX>;
+
+        /// \brief The type that provides read access to a \a T
+        using read_handle_type = read_handle<T, MUTEX>;
+
+        /// \brief The type of function that creates a \a T
+        using factory_type = std::function<T()>;
+
+        /// \brief Construct a lazy_object that default constructs T
+        lazy_object()
+          : lazy_object{[]() { return T{}; }}
+        {
+        }
+
+        /** \brief Construct a lazy_object
+         *
+         * \param factory A function that creates the managed T.  It's called
+         *                at most once (unless it throws), by whichever thread
+         *                first needs T, and released afterwards.
+         */
+        explicit lazy_object(factory_type factory)
+          : _factory{std::move(factory)}
+        {
+        }
+
+        lazy_object(lazy_object const &) = delete;
+        lazy_object & operator=(lazy_object const &) = delete;
+
+        /** \brief Destroy the managed T, if it was created
+         *
+         * \note Any future returned by prewarm must be complete before a
+         *       lazy_object is destroyed.
+         */
+        ~lazy_object()
+        {
+            auto * const object = _object.load(std::memory_order_acquire);
+            if(object != nullptr)
+            {
+                object->~T();
+            }
+        }
+
+        /** \brief Construct a write_handle for the underlying data
+         *
+         * If T doesn't exist yet, it's created first.  Otherwise, this
+         * behaves exactly like threadsafe_object::write.
+         *
+         * \return A write_handle to modify the managed T
+         *
+         * \throw Anything thrown while creating T
+         */
+        auto write()
+        {
+            auto & object = instance();
+            typename write_handle_type::lock_type lock{_m};
+            return write_handle_type{object, std::move(lock)};
+        }
+
+        /** \brief Construct a read_handle for the underlying data
+         *
+         * If T doesn't exist yet, it's created first.  Otherwise, this
+         * behaves exactly like threadsafe_object::read.
+         *
+         * \return A read_handle to access the managed T
+         *
+         * \throw Anything thrown while creating T
+         */
+        auto read() const
+        {
+            auto const & object = instance();
+            typename read_handle_type::lock_type lock{_m};
+            return read_handle_type{object, std::move(lock)};
+        }
+
+        /** \brief Access the underlying data without locking
+         *
+         * This is intended for state that never changes once it's created.
+         * After T exists, this is a single acquire load.
+         *
+         * \return A reference to the managed T
+         *
+         * \throw Anything thrown while creating T
+         *
+         * \warning No lock is held, so the result must not be used while
+         *          anything might hold a write_handle.
+         */
+        T const & get() const
+        {
+            return instance();
+        }
+
+        /// \brief Determine if the managed T has been created
+        bool initialized() const noexcept
+        {
+            return _object.load(std::memory_order_acquire) != nullptr;
+        }
+
+        /** \brief Create the managed T on another thread
+         *
+         * \return A future that's ready once T exists.  If creating T
+         *         throws, the exception is stored in the future and T will be
+         *         created again when it's next needed.
+         *
+         * \note The future must be kept until it's ready, since destroying it
+         *       waits for T to be created.
+         */
+#if __cplusplus >= 201703L
+        [[nodiscard]]
+#endif
+        std::future<void>
+        prewarm()
+        {
+            return std::async(std::launch::async, [this]() { instance(); });
+        }
+
+    private:
+        T & instance() const
+        {
+            auto * const object = _object.load(std::memory_order_acquire);
+            if(object != nullptr)
+            {
+                return *object;
+            }
+            return create();
+        }
+
+        T & create() const
+        {
+            lock_guard_t<mutex> const lock{_create_mutex};
+            auto * object = _object.load(std::memory_order_relaxed);
+            if(object == nullptr)
+            {
+                object = ::new(static_cast<void *>(&_storage)) T(_factory());
+                _object.store(object, std::memory_order_release);
+                _factory = nullptr;
+            }
+            return *object;
+        }
+
+        mutable std::atomic<T *> _object{nullptr};
+        mutable MUTEX _m;
+        mutable mutex _create_mutex;
+        mutable factory_type _factory;
+        alignas(T) mutable unsigned char _storage[sizeof(T)];
+    };
+} // namespace houseguest
+
+#endif
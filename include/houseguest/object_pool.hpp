@@ -0,0 +1,599 @@
+#ifndef HOUSEGUEST_OBJECT_POOL_HPP
+#define HOUSEGUEST_OBJECT_POOL_HPP 1
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <houseguest/bounded_value.hpp>
+#include <houseguest/mutex.hpp>
+#include <houseguest/validation_result.hpp>
+
+/** \file
+ *
+ * \brief A thread-safe pool of reusable objects
+ *
+ * Each thread keeps a small cache of free objects, so acquiring and releasing
+ * objects normally touches nothing shared.  Threads only lock the pool's
+ * shared depot when their cache runs empty or overflows, and then they move
+ * a batch of objects at once.
+ */
+
+namespace houseguest
+{
+    /// \brief counts of how an object_pool has been used
+    struct pool_statistics
+    {
+        /// \brief acquisitions served from the calling thread's cache
+        std::uint64_t hits = 0;
+
+        /// \brief acquisitions that needed the shared depot
+        std::uint64_t misses = 0;
+
+        /// \brief objects created by the pool
+        std::uint64_t created = 0;
+
+        /// \brief get the total number of acquisitions
+        constexpr std::uint64_t acquisitions() const noexcept
+        {
+            return hits + misses;
+        }
+
+        /// \brief get the fraction of acquisitions that avoided the depot
+        constexpr double hit_rate() const noexcept
+        {
+            return (acquisitions() == 0)
+                       ? 0.0
+                       : static_cast<double>(hits) /
+                             static_cast<double>(acquisitions());
+        }
+    };
+
+    namespace internal
+    {
+        /// \brief the default number of free objects each thread caches
+        constexpr std::size_t pool_cache_size = 32;
+
+        /// \brief free objects cached by a single thread for a single pool
+        template <typename T>
+        struct pool_cache
+        {
+            explicit pool_cache(std::size_t capacity)
+            {
+                objects.reserve(capacity);
+            }
+
+            ~pool_cache()
+            {
+                for(auto * object : objects)
+                {
+                    delete object;
+                }
+            }
+
+            pool_cache(pool_cache const &) = delete;
+            pool_cache & operator=(pool_cache const &) = delete;
+
+            // only the owning thread writes, so there's no contention
+            static void increment(std::atomic<std::uint64_t> & counter)
+            {
+                counter.store(counter.load(std::memory_order_relaxed) + 1,
+                              std::memory_order_relaxed);
+            }
+
+            void add_to(pool_statistics & statistics) const noexcept
+            {
+                statistics.hits += hits.load(std::memory_order_relaxed);
+                statistics.misses += misses.load(std::memory_order_relaxed);
+            }
+
+            std::vector<T *> objects;
+            std::atomic<std::uint64_t> hits{0};
+            std::atomic<std::uint64_t> misses{0};
+        };
+
+        /// \brief get a number no other pool has used
+        inline std::uint64_t next_pool_id() noexcept
+        {
+            static std::atomic<std::uint64_t> id{0};
+            return id.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        template <typename T, std::size_t MAX_OBJECTS>
+        class pool_depot;
+
+        /** \brief every cache a thread has created
+         *
+         * When the thread exits, each cache's objects go back to their pool's
+         * depot (or are destroyed, if the pool is gone).
+         */
+        template <typename DEPOT, typename T>
+        class thread_pool_caches
+        {
+        public:
+            thread_pool_caches() = default;
+            thread_pool_caches(thread_pool_caches const &) = delete;
+            thread_pool_caches &
+            operator=(thread_pool_caches const &) = delete;
+
+            ~thread_pool_caches()
+            {
+                for(auto & entry : _entries)
+                {
+                    auto const depot = entry.depot.lock();
+                    if(depot)
+                    {
+                        depot->detach(*entry.cache);
+                    }
+                }
+            }
+
+            pool_cache<T> & find(DEPOT & depot)
+            {
+                // threads usually work with a single pool
+                if(!_entries.empty() && _entries.back().id == depot.id())
+                {
+                    return *_entries.back().cache;
+                }
+                for(auto & entry : _entries)
+                {
+                    if(entry.id == depot.id())
+                    {
+                        std::swap(entry, _entries.back());
+                        return *_entries.back().cache;
+                    }
+                }
+                return add(depot);
+            }
+
+        private:
+            struct registration
+            {
+                std::uint64_t id;
+                std::weak_ptr<DEPOT> depot;
+                std::unique_ptr<pool_cache<T>> cache;
+            };
+
+            pool_cache<T> & add(DEPOT & depot)
+            {
+                // caches for destroyed pools still hold objects
+                _entries.erase(std::remove_if(std::begin(_entries),
+                                              std::end(_entries),
+                                              [](registration const & r) {
+                                                  return r.depot.expired();
+                                              }),
+                               std::end(_entries));
+
+                std::unique_ptr<pool_cache<T>> cache{
+                    new pool_cache<T>{depot.cache_size()}};
+                depot.attach(*cache);
+                _entries.push_back(
+                    registration{depot.id(), depot.shared_from_this(),
+                          std::move(cache)});
+                return *_entries.back().cache;
+            }
+
+            std::vector<registration> _entries;
+        };
+
+        /** \brief the state shared by every thread using an object_pool
+         *
+         * Everything here is protected by a mutex, except the per-thread
+         * caches themselves.
+         */
+        template <typename T, std::size_t MAX_OBJECTS>
+        class pool_depot
+          : public std::enable_shared_from_this<pool_depot<T, MAX_OBJECTS>>
+        {
+        public:
+            using count_type = bounded_value<std::size_t, 0, MAX_OBJECTS>;
+
+            pool_depot(std::size_t cache_size, std::function<T()> factory)
+              : _id{next_pool_id()}
+              , _cache_size{cache_size}
+              , _factory{std::move(factory)}
+            {
+            }
+
+            ~pool_depot()
+            {
+                for(auto * object : _free)
+                {
+                    delete object;
+                }
+            }
+
+            pool_depot(pool_depot const &) = delete;
+            pool_depot & operator=(pool_depot const &) = delete;
+
+            std::uint64_t id() const noexcept
+            {
+                return _id;
+            }
+
+            std::size_t cache_size() const noexcept
+            {
+                return _cache_size;
+            }
+
+            /** \brief get an object
+             *
+             * \param error set if the pool already holds MAX_OBJECTS objects
+             *
+             * \return The object, or null if \a error was set
+             */
+            T * acquire(std::error_code & error)
+            {
+                auto & cache = local_cache();
+                if(!cache.objects.empty())
+                {
+                    pool_cache<T>::increment(cache.hits);
+                    auto * const object = cache.objects.back();
+                    cache.objects.pop_back();
+                    return object;
+                }
+
+                pool_cache<T>::increment(cache.misses);
+                {
+                    std::lock_guard<mutex> const lock{_mutex};
+                    if(!_free.empty())
+                    {
+                        auto * const object = _free.back();
+                        _free.pop_back();
+                        move_objects(_free, cache.objects, _cache_size / 2);
+                        return object;
+                    }
+
+                    auto const next = houseguest::try_make<count_type>(
+                        static_cast<std::size_t>(_size) + 1);
+                    if(!next)
+                    {
+                        error = next.error();
+                        return nullptr;
+                    }
+                    _size = *next;
+                }
+                return create();
+            }
+
+            /// \brief return an object acquired from this depot
+            void release(T * object)
+            {
+                auto & cache = local_cache();
+                if(cache.objects.size() == _cache_size)
+                {
+                    // keep half, so alternating acquires and releases don't
+                    // bounce off the depot every time
+                    std::lock_guard<mutex> const lock{_mutex};
+                    move_objects(cache.objects, _free, (_cache_size + 1) / 2);
+                }
+                cache.objects.push_back(object);
+            }
+
+            count_type size() const
+            {
+                std::lock_guard<mutex> const lock{_mutex};
+                return _size;
+            }
+
+            pool_statistics statistics() const
+            {
+                std::lock_guard<mutex> const lock{_mutex};
+                auto ret = _exited;
+                for(auto const * cache : _caches)
+                {
+                    cache->add_to(ret);
+                }
+                ret.created = static_cast<std::size_t>(_size);
+                return ret;
+            }
+
+            void attach(pool_cache<T> & cache)
+            {
+                std::lock_guard<mutex> const lock{_mutex};
+                _caches.push_back(&cache);
+            }
+
+            void detach(pool_cache<T> & cache)
+            {
+                std::lock_guard<mutex> const lock{_mutex};
+                cache.add_to(_exited);
+                move_objects(cache.objects, _free, cache.objects.size());
+                for(auto & current : _caches)
+                {
+                    if(current == &cache)
+                    {
+                        current = _caches.back();
+                        _caches.pop_back();
+                        break;
+                    }
+                }
+            }
+
+        private:
+            static void move_objects(std::vector<T *> & from,
+                                     std::vector<T *> & to, std::size_t count)
+            {
+                auto const first =
+                    from.end() -
+                    static_cast<std::ptrdiff_t>(std::min(count, from.size()));
+                to.insert(to.end(), first, from.end());
+                from.erase(first, from.end());
+            }
+
+            pool_cache<T> & local_cache()
+            {
+                thread_local thread_pool_caches<pool_depot, T> caches;
+                return caches.find(*this);
+            }
+
+            T * create()
+            {
+                try
+                {
+                    return new T(_factory());
+                }
+                catch(...)
+                {
+                    std::lock_guard<mutex> const lock{_mutex};
+                    _size = count_type{static_cast<std::size_t>(_size) - 1};
+                    throw;
+                }
+            }
+
+            std::uint64_t const _id;
+            std::size_t const _cache_size;
+            std::function<T()> const _factory;
+            mutable mutex _mutex;
+            std::vector<T *> _free;
+            std::vector<pool_cache<T> *> _caches;
+            pool_statistics _exited;
+            count_type _size{0};
+        };
+    } // namespace internal
+
+    /** \brief exclusive access to an object borrowed from an object_pool
+     *
+     * The object goes back to the pool when the pool_handle is destroyed or
+     * reset.  A pool_handle must not outlive the pool it came from.
+     *
+     * \tparam T           the pooled type
+     * \tparam MAX_OBJECTS the pool's capacity
+     */
+    template <typename T, std::size_t MAX_OBJECTS>
+#if __cplusplus >= 201703L
+    class [[nodiscard]] pool_handle
+#else
+    class pool_handle
+#endif
+    {
+    public:
+        /// \brief construct an empty pool_handle
+        pool_handle() noexcept = default;
+
+        /// \cond false
+        pool_handle(internal::pool_depot<T, MAX_OBJECTS> & depot,
+                    T * object) noexcept
+          : _depot{&depot}
+          , _object{object}
+        {
+        }
+        /// \endcond
+
+        pool_handle(pool_handle && other) noexcept
+          : _depot{other._depot}
+          , _object{other._object}
+        {
+            other._object = nullptr;
+        }
+
+        pool_handle & operator=(pool_handle && other) noexcept
+        {
+            if(this != &other)
+            {
+                reset();
+                _depot = other._depot;
+                _object = other._object;
+                other._object = nullptr;
+            }
+            return *this;
+        }
+
+        pool_handle(pool_handle const &) = delete;
+        pool_handle & operator=(pool_handle const &) = delete;
+
+        ~pool_handle()
+        {
+            reset();
+        }
+
+        /// \brief return the object to the pool early
+        void reset()
+        {
+            if(_object != nullptr)
+            {
+                _depot->release(_object);
+                _object = nullptr;
+            }
+        }
+
+        /// \brief determine if the handle holds an object
+        explicit operator bool() const noexcept
+        {
+            return _object != nullptr;
+        }
+
+        /// \brief get the object, or null if the handle is empty
+        T * get() const noexcept
+        {
+            return _object;
+        }
+
+        /** \brief Retreive a reference to the borrowed object
+         *
+         * \pre The handle isn't empty
+         */
+        T & operator*() const noexcept
+        {
+            return *_object;
+        }
+
+        /** \brief Retrieve a pointer to the borrowed object
+         *
+         * \pre The handle isn't empty
+         */
+        T * operator->() const noexcept
+        {
+            return _object;
+        }
+
+    private:
+        internal::pool_depot<T, MAX_OBJECTS> * _depot = nullptr;
+        T * _object = nullptr;
+    };
+
+    /** \brief a thread-safe pool of reusable objects
+     *
+     * Objects are created on demand and never destroyed until the pool is.
+     * Released objects are handed out again as they were left, so callers
+     * should reset any state they care about.
+     *
+     * Each thread caches up to cache_size free objects.  Acquiring from a
+     * non-empty cache (a hit) and releasing into a cache that isn't full
+     * take no locks.  Otherwise, objects move between the cache and a shared
+     * depot in batches of about half the cache size.  Objects a thread still
+     * caches when it exits go back to the depot.
+     *
+     * \tparam T           the pooled type
+     * \tparam MAX_OBJECTS the most objects the pool will create.  By default,
+     *                     the pool is unbounded.  Free objects cached by
+     *                     other threads can't be borrowed, so a bounded pool
+     *                     should allow for cache_size free objects per
+     *                     thread.
+     *
+     * \note If a pool is destroyed, objects cached by other threads are
+     *       destroyed when those threads exit or next register with a pool of
+     *       the same type.
+     */
+    template <typename T,
+              std::size_t MAX_OBJECTS = std::numeric_limits<std::size_t>::max()>
+    class object_pool
+    {
+    public:
+        /// \brief the type that returns objects to the pool
+        using handle_type = pool_handle<T, MAX_OBJECTS>;
+
+        /// \brief the type used to count objects
+        using size_type =
+            typename internal::pool_depot<T, MAX_OBJECTS>::count_type;
+
+        /// \brief The type of function that creates a \a T
+        using factory_type = std::function<T()>;
+
+        /** \brief construct an object_pool that default constructs objects
+         *
+         * \param cache_size the number of free objects each thread caches
+         *
+         * \throw std::invalid_argument if \a cache_size is zero
+         */
+        explicit object_pool(
+            std::size_t cache_size = internal::pool_cache_size)
+          : object_pool{cache_size, []() { return T{}; }}
+        {
+        }
+
+        /** \brief construct an object_pool
+         *
+         * \param cache_size the number of free objects each thread caches
+         * \param factory    a function that creates each object
+         *
+         * \throw std::invalid_argument if \a cache_size is zero
+         */
+        object_pool(std::size_t cache_size, factory_type factory)
+        {
+            if(cache_size == 0)
+            {
+                throw std::invalid_argument{
+                    "object_pool requires a cache size"};
+            }
+            _depot = std::make_shared<depot_type>(cache_size,
+                                                  std::move(factory));
+        }
+
+        object_pool(object_pool const &) = delete;
+        object_pool & operator=(object_pool const &) = delete;
+
+        /** \brief borrow an object
+         *
+         * \throw std::system_error if the pool already holds MAX_OBJECTS
+         *                          objects and none are free
+         * \throw Anything thrown while creating an object
+         */
+        handle_type acquire()
+        {
+            std::error_code error;
+            auto * const object = _depot->acquire(error);
+            if(object == nullptr)
+            {
+                throw std::system_error{error};
+            }
+            return handle_type{*_depot, object};
+        }
+
+        /** \brief borrow an object if the pool isn't exhausted
+         *
+         * \return A handle to the object, or an empty handle if the pool
+         *         already holds MAX_OBJECTS objects and none are free
+         *
+         * \throw Anything thrown while creating an object
+         */
+        handle_type try_acquire()
+        {
+            std::error_code error;
+            auto * const object = _depot->acquire(error);
+            if(object == nullptr)
+            {
+                return handle_type{};
+            }
+            return handle_type{*_depot, object};
+        }
+
+        /// \brief get the number of objects the pool has created
+        size_type size() const
+        {
+            return _depot->size();
+        }
+
+        /// \brief get the number of free objects each thread caches
+        std::size_t cache_size() const noexcept
+        {
+            return _depot->cache_size();
+        }
+
+        /** \brief get the usage counts from every thread
+         *
+         * Counts are kept with relaxed atomics, so a snapshot taken while
+         * other threads use the pool may be slightly inconsistent.
+         */
+        pool_statistics statistics() const
+        {
+            return _depot->statistics();
+        }
+
+    private:
+        using depot_type = internal::pool_depot<T, MAX_OBJECTS>;
+
+        std::shared_ptr<depot_type> _depot;
+    };
+} // namespace houseguest
+
+#endif
@@ -3,21 +3,53 @@
 
 #include <type_traits>
 
+#include <houseguest/composite_validator.hpp>
+#include <houseguest/constrained_value.hpp>
+
 namespace houseguest
 {
+    /** \brief a validator that requires values be even or odd
+     *
+     * \tparam T    the integral type to operate on
+     * \tparam EVEN true if values must be even, false if they must be odd
+     */
     template <typename T, bool EVEN>
     struct oddeven_validator
+      : internal::mask_constraint<T, 1, (EVEN ? 0 : 1)>
     {
-        static_assert(std::is_integral<T>::value, "T must be integral");
+        /** \brief check if \a value has the right parity
+         *
+         * \retval constraint_error::success      \a value is acceptable
+         * \retval constraint_error::wrong_parity \a value isn't acceptable
+         */
+        constexpr constraint_error check(T value) const noexcept
+        {
+            return oddeven_validator::test(value)
+                       ? constraint_error::success
+                       : constraint_error::wrong_parity;
+        }
 
-        T operator()(T val)
+        /** \brief validate \a value has the right parity
+         *
+         * \param value the value to validate
+         *
+         * \retval value The only thing this function will return.
+         *
+         * \throw std::system_error if \a value has the wrong parity
+         */
+        constexpr T operator()(T value) const
         {
-            if((val & 1) != EVEN)
-            {
-            }
-            return val;
+            return internal::apply_constraint(*this, value);
         }
     };
+
+    /** \brief a constrained_value that requires values be even or odd
+     *
+     * \tparam T    the integral type to operate on
+     * \tparam EVEN true if values must be even, false if they must be odd
+     */
+    template <typename T, bool EVEN>
+    using oddeven_value = constrained_value<T, oddeven_validator<T, EVEN>>;
 } // namespace houseguest
 
 #endif
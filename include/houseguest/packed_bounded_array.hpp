@@ -0,0 +1,540 @@
+#ifndef HOUSEGUEST_PACKED_BOUNDED_ARRAY_HPP
+#define HOUSEGUEST_PACKED_BOUNDED_ARRAY_HPP 1
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <houseguest/bounded_algorithm.hpp>
+#include <houseguest/bounded_value.hpp>
+
+namespace houseguest
+{
+    /** \brief a dynamically-sized array of bounded values packed into the
+     *         minimum number of bits
+     *
+     * Each value is stored as its distance from MIN using exactly as many
+     * bits as required to represent MAX - MIN, so a
+     * packed_bounded_array<int, 0, 100> uses 7 bits per value instead of 32.
+     * Values are packed back to back into 64-bit words and may straddle word
+     * boundaries; an extra padding word at the end of storage lets every
+     * access touch exactly two words without branching.
+     *
+     * \tparam T   the integral type to operate on
+     * \tparam MIN the minimum legal value
+     * \tparam MAX the maximum legal value
+     */
+    template <typename T, T MIN, T MAX>
+    class packed_bounded_array
+    {
+        using word_type = std::uint64_t;
+        using offset_type = std::make_unsigned_t<T>;
+        using range_type = bounded_validator<T, MIN, MAX>;
+
+        static constexpr std::size_t word_bits =
+            std::numeric_limits<word_type>::digits;
+
+    public:
+        /// \brief the type produced when accessing elements
+        using value_type = bounded_value<T, MIN, MAX>;
+
+        /// \brief the type used for sizes and indices
+        using size_type = std::size_t;
+
+        /// \brief the number of bits used to store each value
+        static constexpr unsigned bits_per_value =
+            internal::bits_required(internal::range_span<range_type>());
+
+        /// \brief a proxy that refers to a single packed value
+        class reference
+        {
+        public:
+            /// \cond false
+            reference(reference const & other) noexcept = default;
+            /// \endcond
+
+            /// \brief retrieve the referenced value
+            operator value_type() const noexcept
+            {
+                return _array->get(_index);
+            }
+
+            /// \brief retrieve the referenced value as a raw T
+            operator T() const noexcept
+            {
+                return static_cast<T>(_array->get(_index));
+            }
+
+            /// \brief replace the referenced value
+            reference & operator=(value_type const & value) noexcept
+            {
+                _array->set(_index, value);
+                return *this;
+            }
+
+            /** \brief replace the referenced value
+             *
+             * \param value the new value.  \a value will be validated prior
+             *              to being stored.
+             */
+            reference & operator=(T value)
+            {
+                _array->set(_index, value_type{std::move(value)});
+                return *this;
+            }
+
+            /// \brief replace the referenced value with another packed value
+            reference & operator=(reference const & other) noexcept
+            {
+                _array->set(_index, static_cast<value_type>(other));
+                return *this;
+            }
+
+        private:
+            friend class packed_bounded_array;
+
+            reference(packed_bounded_array * array, size_type index) noexcept
+              : _array{array}
+              , _index{index}
+            {
+            }
+
+            packed_bounded_array * _array;
+            size_type _index;
+        };
+
+        /// \brief a random-access iterator that produces reference proxies
+        template <typename ARRAY, typename REFERENCE>
+        class basic_iterator
+        {
+        public:
+            /// \cond false
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = packed_bounded_array::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = REFERENCE;
+
+            basic_iterator() noexcept = default;
+
+            basic_iterator(ARRAY * array, size_type index) noexcept
+              : _array{array}
+              , _index{index}
+            {
+            }
+
+            reference operator*() const noexcept
+            {
+                return (*_array)[_index];
+            }
+
+            reference operator[](difference_type offset) const noexcept
+            {
+                return (*_array)[advance(offset)];
+            }
+
+            basic_iterator & operator++() noexcept
+            {
+                ++_index;
+                return *this;
+            }
+
+            basic_iterator operator++(int) noexcept
+            {
+                auto ret = *this;
+                ++_index;
+                return ret;
+            }
+
+            basic_iterator & operator--() noexcept
+            {
+                --_index;
+                return *this;
+            }
+
+            basic_iterator operator--(int) noexcept
+            {
+                auto ret = *this;
+                --_index;
+                return ret;
+            }
+
+            basic_iterator & operator+=(difference_type offset) noexcept
+            {
+                _index = advance(offset);
+                return *this;
+            }
+
+            basic_iterator & operator-=(difference_type offset) noexcept
+            {
+                _index = advance(-offset);
+                return *this;
+            }
+
+            friend basic_iterator operator+(basic_iterator it,
+                                            difference_type offset) noexcept
+            {
+                return it += offset;
+            }
+
+            friend basic_iterator operator+(difference_type offset,
+                                            basic_iterator it) noexcept
+            {
+                return it += offset;
+            }
+
+            friend basic_iterator operator-(basic_iterator it,
+                                            difference_type offset) noexcept
+            {
+                return it -= offset;
+            }
+
+            friend difference_type operator-(basic_iterator lhs,
+                                             basic_iterator rhs) noexcept
+            {
+                return static_cast<difference_type>(lhs._index) -
+                       static_cast<difference_type>(rhs._index);
+            }
+
+            friend bool operator==(basic_iterator lhs,
+                                   basic_iterator rhs) noexcept
+            {
+                return lhs._index == rhs._index;
+            }
+
+            friend bool operator!=(basic_iterator lhs,
+                                   basic_iterator rhs) noexcept
+            {
+                return lhs._index != rhs._index;
+            }
+
+            friend bool operator<(basic_iterator lhs,
+                                  basic_iterator rhs) noexcept
+            {
+                return lhs._index < rhs._index;
+            }
+
+            friend bool operator<=(basic_iterator lhs,
+                                   basic_iterator rhs) noexcept
+            {
+                return lhs._index <= rhs._index;
+            }
+
+            friend bool operator>(basic_iterator lhs,
+                                  basic_iterator rhs) noexcept
+            {
+                return lhs._index > rhs._index;
+            }
+
+            friend bool operator>=(basic_iterator lhs,
+                                   basic_iterator rhs) noexcept
+            {
+                return lhs._index >= rhs._index;
+            }
+            /// \endcond
+
+        private:
+            size_type advance(difference_type offset) const noexcept
+            {
+                return static_cast<size_type>(
+                    static_cast<difference_type>(_index) + offset);
+            }
+
+            ARRAY * _array = nullptr;
+            size_type _index = 0;
+        };
+
+        /// \brief an iterator that produces reference proxies
+        using iterator = basic_iterator<packed_bounded_array, reference>;
+
+        /// \brief an iterator that produces value_types
+        using const_iterator =
+            basic_iterator<packed_bounded_array const, value_type>;
+
+        /// \brief construct an empty packed_bounded_array
+        packed_bounded_array()
+          : _words(words_required(0), 0)
+        {
+        }
+
+        /** \brief construct a packed_bounded_array
+         *
+         * \param count the number of values
+         * \param value the value to store in every position
+         */
+        explicit packed_bounded_array(
+            size_type count,
+            value_type const & value = value_type{internal::prevalidated, MIN})
+          : _words(words_required(0), 0)
+        {
+            resize(count, value);
+        }
+
+        /// \brief get the number of stored values
+        size_type size() const noexcept
+        {
+            return _size;
+        }
+
+        /// \brief determine if there are no stored values
+        bool empty() const noexcept
+        {
+            return _size == 0;
+        }
+
+        /// \brief get the number of bytes used to store values
+        size_type storage_bytes() const noexcept
+        {
+            return _words.size() * sizeof(word_type);
+        }
+
+        /** \brief change the number of stored values
+         *
+         * \param count the new size
+         * \param value the value to store in any new positions
+         */
+        void resize(size_type count, value_type const & value = value_type{
+                                         internal::prevalidated, MIN})
+        {
+            auto const old_size = _size;
+            if(count < old_size)
+            {
+                clear_from(count);
+            }
+            _words.resize(words_required(count), 0);
+            _size = count;
+            for(auto i = old_size; i < count; ++i)
+            {
+                set(i, value);
+            }
+        }
+
+        /// \brief add a value to the end
+        void push_back(value_type const & value)
+        {
+            _words.resize(words_required(_size + 1), 0);
+            ++_size;
+            set(_size - 1, value);
+        }
+
+        /** \brief add a raw value to the end
+         *
+         * \param value the value to add.  It will be validated prior to being
+         *              stored.
+         */
+        void push_back(T value)
+        {
+            push_back(value_type{std::move(value)});
+        }
+
+        /// \brief remove all values
+        void clear() noexcept
+        {
+            _words.assign(words_required(0), 0);
+            _size = 0;
+        }
+
+        /// \brief retrieve the value at \a index
+        value_type get(size_type index) const noexcept
+        {
+            return value_type{
+                internal::prevalidated,
+                internal::from_range_offset<range_type>(
+                    static_cast<offset_type>(read_bits(index)))};
+        }
+
+        /// \brief replace the value at \a index
+        void set(size_type index, value_type const & value) noexcept
+        {
+            write_bits(index, internal::range_offset<range_type>(
+                                  static_cast<T>(value)));
+        }
+
+        /// \brief access a value
+        reference operator[](size_type index) noexcept
+        {
+            return reference{this, index};
+        }
+
+        /// \brief access a value
+        value_type operator[](size_type index) const noexcept
+        {
+            return get(index);
+        }
+
+        /** \brief access a value with bounds checking
+         *
+         * \throw std::out_of_range if \a index isn't less-than size()
+         */
+        reference at(size_type index)
+        {
+            check_index(index);
+            return reference{this, index};
+        }
+
+        /** \brief access a value with bounds checking
+         *
+         * \throw std::out_of_range if \a index isn't less-than size()
+         */
+        value_type at(size_type index) const
+        {
+            check_index(index);
+            return get(index);
+        }
+
+        /** \brief copy a range of values out as raw T
+         *
+         * \param index the position of the first value to copy
+         * \param count the number of values to copy
+         * \param out   where to write the values
+         *
+         * \return \a out advanced past the last value written
+         */
+        template <typename OUTPUT>
+        OUTPUT unpack(size_type index, size_type count, OUTPUT out) const
+        {
+            for(auto i = index; i < index + count; ++i)
+            {
+                *out = internal::from_range_offset<range_type>(
+                    static_cast<offset_type>(read_bits(i)));
+                ++out;
+            }
+            return out;
+        }
+
+        /** \brief store a range of raw values
+         *
+         * The entire range is validated before anything is stored; if any
+         * value is out of range, the exception is thrown and the
+         * packed_bounded_array is unchanged.
+         *
+         * \tparam ITERATOR a forward iterator, since the range is read once
+         *                  to validate it and again to store it
+         *
+         * \param first the beginning of the values to store
+         * \param last  the end of the values to store
+         * \param index the position to store the first value.  The range
+         *              [index, index + distance(first, last)) must already
+         *              exist.
+         */
+        template <typename ITERATOR>
+        void pack(ITERATOR first, ITERATOR last, size_type index)
+        {
+            static_assert(
+                std::is_base_of<std::forward_iterator_tag,
+                                typename std::iterator_traits<
+                                    ITERATOR>::iterator_category>::value,
+                "pack reads the range twice, so it requires forward "
+                "iterators");
+            auto const bad = validate_all<range_type>(first, last);
+            if(bad != last)
+            {
+                exception_validator<T, MIN, MAX>{}(*bad);
+            }
+            for(; first != last; ++first, ++index)
+            {
+                write_bits(index, internal::range_offset<range_type>(*first));
+            }
+        }
+
+        /// \brief get an iterator to the first value
+        iterator begin() noexcept
+        {
+            return iterator{this, 0};
+        }
+
+        /// \brief get an iterator past the last value
+        iterator end() noexcept
+        {
+            return iterator{this, _size};
+        }
+
+        /// \brief get an iterator to the first value
+        const_iterator begin() const noexcept
+        {
+            return const_iterator{this, 0};
+        }
+
+        /// \brief get an iterator past the last value
+        const_iterator end() const noexcept
+        {
+            return const_iterator{this, _size};
+        }
+
+    private:
+        static_assert(bits_per_value <= word_bits,
+                      "Values must fit in a single word");
+
+        static constexpr word_type value_mask =
+            (bits_per_value == word_bits)
+                ? ~word_type{0}
+                : ((word_type{1} << (bits_per_value % word_bits)) - 1);
+
+        static constexpr size_type words_required(size_type count) noexcept
+        {
+            // always keep a spare word so reads and writes can touch two
+            // words unconditionally
+            return ((count * bits_per_value) / word_bits) + 2;
+        }
+
+        word_type read_bits(size_type index) const noexcept
+        {
+            auto const bit = index * bits_per_value;
+            auto const word = bit / word_bits;
+            auto const shift = bit % word_bits;
+            // the two-step shift is well-defined even when shift is 0
+            auto const low = _words[word] >> shift;
+            auto const high =
+                (_words[word + 1] << 1) << (word_bits - 1 - shift);
+            return (low | high) & value_mask;
+        }
+
+        void write_bits(size_type index, word_type offset) noexcept
+        {
+            auto const bit = index * bits_per_value;
+            auto const word = bit / word_bits;
+            auto const shift = bit % word_bits;
+            _words[word] =
+                (_words[word] & ~(value_mask << shift)) | (offset << shift);
+            auto const high_mask = (value_mask >> 1) >> (word_bits - 1 - shift);
+            _words[word + 1] = (_words[word + 1] & ~high_mask) |
+                               ((offset >> 1) >> (word_bits - 1 - shift));
+        }
+
+        void clear_from(size_type index) noexcept
+        {
+            auto const bit = index * bits_per_value;
+            auto const word = bit / word_bits;
+            auto const shift = bit % word_bits;
+            _words[word] &= ~(~word_type{0} << shift);
+            for(auto i = word + 1; i < _words.size(); ++i)
+            {
+                _words[i] = 0;
+            }
+        }
+
+        void check_index(size_type index) const
+        {
+            if(index >= _size)
+            {
+                throw std::out_of_range{"packed_bounded_array index"};
+            }
+        }
+
+        std::vector<word_type> _words;
+        size_type _size = 0;
+    };
+
+#if __cplusplus < 201703L
+    /// \cond false
+    template <typename T, T MIN, T MAX>
+    constexpr unsigned packed_bounded_array<T, MIN, MAX>::bits_per_value;
+    /// \endcond
+#endif
+} // namespace houseguest
+
+#endif
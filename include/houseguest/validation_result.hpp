@@ -0,0 +1,161 @@
+#ifndef HOUSEGUEST_VALIDATION_RESULT_HPP
+#define HOUSEGUEST_VALIDATION_RESULT_HPP 1
+
+#include <cassert>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <houseguest/constrained_value.hpp>
+
+/** \file
+ *
+ * \brief Exception-free construction of constrained_values
+ */
+
+namespace houseguest
+{
+    /** \brief either a constrained_value or the reason one couldn't be
+     *         created
+     *
+     * \tparam CONSTRAINED the constrained_value type being created
+     */
+    template <typename CONSTRAINED>
+#if __cplusplus >= 201703L
+    class [[nodiscard]] validation_result
+#else
+    class validation_result
+#endif
+    {
+    public:
+        /// \brief the constrained_value type
+        using value_type = CONSTRAINED;
+
+        /** \brief construct a successful validation_result
+         *
+         * \param value the created value
+         */
+        validation_result(value_type const & value) noexcept
+          : _value{static_cast<underlying_type>(value)}
+        {
+        }
+
+        /** \brief construct a failed validation_result
+         *
+         * \param error the reason validation failed.  \a error must not be
+         *              empty.
+         */
+        validation_result(std::error_code error) noexcept
+          : _error{error}
+        {
+            assert(_error);
+        }
+
+        /// \brief determine if validation succeeded
+        bool has_value() const noexcept
+        {
+            return !_error;
+        }
+
+        /// \brief determine if validation succeeded
+        explicit operator bool() const noexcept
+        {
+            return has_value();
+        }
+
+        /** \brief get the reason validation failed
+         *
+         * \return The error that caused validation to fail, or an empty
+         *         std::error_code if validation succeeded.
+         */
+        std::error_code error() const noexcept
+        {
+            return _error;
+        }
+
+        /** \brief get the created value
+         *
+         * \pre has_value() is true
+         */
+        value_type value() const noexcept
+        {
+            assert(has_value());
+            return value_type{internal::prevalidated, _value};
+        }
+
+        /// \brief get the created value
+        value_type operator*() const noexcept
+        {
+            return value();
+        }
+
+        /** \brief get the created value or a fallback
+         *
+         * \param fallback the value to return if validation failed
+         */
+        value_type value_or(value_type const & fallback) const noexcept
+        {
+            return has_value() ? value() : fallback;
+        }
+
+    private:
+        using underlying_type = typename CONSTRAINED::underlying_type;
+
+        std::error_code _error;
+        underlying_type _value{};
+    };
+
+    namespace internal
+    {
+        template <typename CONSTRAINED, typename T>
+        validation_result<CONSTRAINED> try_make(T value, std::true_type)
+        {
+            typename CONSTRAINED::validator const validator{};
+            auto const error = validator.check(value);
+            // compare against the value-initialized (success) result before
+            // converting to std::error_code, so the success path never
+            // touches the error category
+            if(error != decltype(error){})
+            {
+                return validation_result<CONSTRAINED>{std::error_code{error}};
+            }
+            return CONSTRAINED{prevalidated, std::move(value)};
+        }
+
+        template <typename CONSTRAINED, typename T>
+        validation_result<CONSTRAINED> try_make(T value, std::false_type)
+        {
+            // validators without check (e.g., clamping_validator) can't
+            // reject values
+            return CONSTRAINED{std::move(value)};
+        }
+    } // namespace internal
+
+    /** \brief construct a constrained_value without throwing
+     *
+     * If CONSTRAINED's validator provides a check function (e.g.,
+     * exception_validator or checked_validator), it's used to validate
+     * \a value and any error is reported through the result instead of an
+     * exception.  Validators without check are assumed to accept every
+     * value (possibly adjusting it), so they're applied as normal.
+     *
+     * \tparam CONSTRAINED the constrained_value to create
+     *
+     * \param value the initial value
+     *
+     * \return Either the created constrained_value or the reason \a value was
+     *         rejected.
+     */
+    template <typename CONSTRAINED>
+    validation_result<CONSTRAINED>
+    try_make(typename CONSTRAINED::underlying_type value)
+    {
+        using underlying_type = typename CONSTRAINED::underlying_type;
+        return internal::try_make<CONSTRAINED>(
+            std::move(value),
+            internal::has_check<typename CONSTRAINED::validator,
+                                underlying_type>{});
+    }
+} // namespace houseguest
+
+#endif
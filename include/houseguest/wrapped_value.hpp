@@ -0,0 +1,250 @@
+#ifndef HOUSEGUEST_WRAPPED_VALUE_HPP
+#define HOUSEGUEST_WRAPPED_VALUE_HPP 1
+
+#include <cstdint>
+#include <type_traits>
+
+#include <houseguest/bounded_value.hpp>
+#include <houseguest/constrained_value.hpp>
+
+/** \file
+ *
+ * \brief Values that wrap around within a range (e.g., ring buffer indices
+ *        and sequence numbers)
+ */
+
+namespace houseguest
+{
+    namespace internal
+    {
+        /** \brief modular arithmetic over a validator's range
+         *
+         * Values are handled as offsets from min, modulo the number of values
+         * in the range.  If that number is a power of two, every operation is
+         * a mask.  Otherwise, adding two offsets needs at most one
+         * conditional subtract; only reducing an arbitrary value needs a
+         * modulo (by a constant, so compilers avoid a division instruction).
+         *
+         * \tparam VALIDATOR a type derived from bounded_validator
+         */
+        template <typename VALIDATOR>
+        struct wrap_arithmetic
+        {
+            using type = typename VALIDATOR::type;
+            using offset_type = std::make_unsigned_t<type>;
+
+            /// \brief the number of values in the range (0 if every value of
+            ///        offset_type is in the range)
+            static constexpr offset_type size =
+                static_cast<offset_type>(range_span<VALIDATOR>() + 1);
+
+            /// \brief true if size is a power of two
+            static constexpr bool power_of_two =
+                (size & static_cast<offset_type>(size - 1)) == 0;
+
+            /// \brief reduce a distance modulo size
+            static constexpr offset_type reduce(offset_type distance) noexcept
+            {
+                return power_of_two ? static_cast<offset_type>(
+                                          distance &
+                                          static_cast<offset_type>(size - 1))
+                                    : static_cast<offset_type>(distance % size);
+            }
+
+            /// \brief get -offset modulo size
+            static constexpr offset_type negate(offset_type offset) noexcept
+            {
+                return power_of_two
+                           ? reduce(static_cast<offset_type>(0 - offset))
+                           : ((offset == 0) ? offset
+                                            : static_cast<offset_type>(
+                                                  size - offset));
+            }
+
+            /// \brief add two offsets that are already less-than size
+            static constexpr offset_type add(offset_type lhs,
+                                             offset_type rhs) noexcept
+            {
+                // lhs + rhs is less-than 2 * size, so one subtract is enough.
+                // The sum can only overflow offset_type when size is more
+                // than half its range, in which case sum < lhs catches it.
+                auto const sum = static_cast<offset_type>(lhs + rhs);
+                return power_of_two
+                           ? reduce(sum)
+                           : (((sum >= size) || (sum < lhs))
+                                  ? static_cast<offset_type>(sum - size)
+                                  : sum);
+            }
+
+            /// \brief convert any value (or distance) to an offset
+            static constexpr offset_type offset_of(type value) noexcept
+            {
+                return (power_of_two || !cmp_less(value, VALIDATOR::min))
+                           ? reduce(range_offset<VALIDATOR>(value))
+                           : negate(reduce(static_cast<offset_type>(
+                                 static_cast<offset_type>(VALIDATOR::min) -
+                                 static_cast<offset_type>(value))));
+            }
+
+            /// \brief convert a (possibly negative) distance of any integral
+            ///        type to an offset
+            template <typename DELTA>
+            static constexpr offset_type delta_of(DELTA delta) noexcept
+            {
+                auto const magnitude =
+                    cmp_less(delta, 0)
+                        ? (std::uintmax_t{0} -
+                           static_cast<std::uintmax_t>(delta))
+                        : static_cast<std::uintmax_t>(delta);
+                auto const reduced =
+                    power_of_two
+                        ? static_cast<offset_type>(
+                              magnitude & static_cast<offset_type>(size - 1))
+                        : static_cast<offset_type>(
+                              magnitude % static_cast<std::uintmax_t>(size));
+                return cmp_less(delta, 0) ? negate(reduced) : reduced;
+            }
+
+            /// \brief convert an offset back to a value
+            static constexpr type value_of(offset_type offset) noexcept
+            {
+                return from_range_offset<VALIDATOR>(offset);
+            }
+        };
+    } // namespace internal
+
+    /** \brief a validator that wraps values around between MIN and MAX
+     *
+     * Values outside the range are reduced modulo the range's size, so
+     * MAX + 1 becomes MIN and MIN - 1 becomes MAX.
+     *
+     * \tparam T   the integral type to operate on
+     * \tparam MIN the minimum legal value
+     * \tparam MAX the maximum legal value
+     */
+    template <typename T, T MIN, T MAX>
+    struct wrapping_validator : bounded_validator<T, MIN, MAX>
+    {
+        /** \brief wrap \a value into the specified range
+         *
+         * \param value the value to wrap
+         *
+         * \return \a value modulo the size of the range, offset from MIN
+         */
+        constexpr T operator()(T value) const noexcept
+        {
+            using arithmetic = internal::wrap_arithmetic<wrapping_validator>;
+            return arithmetic::value_of(arithmetic::offset_of(value));
+        }
+    };
+
+    /** \brief a constrained_value that wraps values around between MIN and
+     *         MAX
+     *
+     * Adding to or subtracting from a wrapped_value wraps the result the same
+     * way, using a mask when the range's size is a power of two and a single
+     * conditional subtract otherwise.
+     *
+     * \tparam T   the integral type to operate on
+     * \tparam MIN the minimum legal value
+     * \tparam MAX the maximum legal value
+     */
+    template <typename T, T MIN, T MAX>
+    using wrapped_value = constrained_value<T, wrapping_validator<T, MIN, MAX>>;
+
+    /// \brief specialization for wrapping_validator
+    template <typename T, T MIN, T MAX>
+    struct is_range_validator<wrapping_validator<T, MIN, MAX>> : std::true_type
+    {
+    };
+
+    namespace internal
+    {
+        template <typename T, T MIN, T MAX>
+        constexpr wrapped_value<T, MIN, MAX>
+        wrapped_add(wrapped_value<T, MIN, MAX> const & value,
+                    std::make_unsigned_t<T> delta) noexcept
+        {
+            using arithmetic =
+                wrap_arithmetic<wrapping_validator<T, MIN, MAX>>;
+            return wrapped_value<T, MIN, MAX>{
+                prevalidated,
+                arithmetic::value_of(arithmetic::add(
+                    range_offset<wrapping_validator<T, MIN, MAX>>(value),
+                    delta))};
+        }
+    } // namespace internal
+
+    /// \cond false
+    template <typename T, T MIN, T MAX, typename DELTA,
+              typename = std::enable_if_t<std::is_integral<DELTA>::value>>
+    constexpr wrapped_value<T, MIN, MAX>
+    operator+(wrapped_value<T, MIN, MAX> const & lhs, DELTA delta) noexcept
+    {
+        using arithmetic =
+            internal::wrap_arithmetic<wrapping_validator<T, MIN, MAX>>;
+        return internal::wrapped_add(lhs, arithmetic::delta_of(delta));
+    }
+
+    template <typename T, T MIN, T MAX, typename DELTA,
+              typename = std::enable_if_t<std::is_integral<DELTA>::value>>
+    constexpr wrapped_value<T, MIN, MAX>
+    operator-(wrapped_value<T, MIN, MAX> const & lhs, DELTA delta) noexcept
+    {
+        using arithmetic =
+            internal::wrap_arithmetic<wrapping_validator<T, MIN, MAX>>;
+        return internal::wrapped_add(
+            lhs, arithmetic::negate(arithmetic::delta_of(delta)));
+    }
+
+    // Adding wrapped_values adds their values (not their offsets from MIN),
+    // so day_of_week{5} + day_of_week{5} is 10 wrapped into the range.
+    template <typename T, T MIN, T MAX>
+    constexpr wrapped_value<T, MIN, MAX>
+    operator+(wrapped_value<T, MIN, MAX> const & lhs,
+              wrapped_value<T, MIN, MAX> const & rhs) noexcept
+    {
+        return lhs + static_cast<T>(rhs);
+    }
+
+    template <typename T, T MIN, T MAX>
+    constexpr wrapped_value<T, MIN, MAX>
+    operator-(wrapped_value<T, MIN, MAX> const & lhs,
+              wrapped_value<T, MIN, MAX> const & rhs) noexcept
+    {
+        return lhs - static_cast<T>(rhs);
+    }
+    /// \endcond
+
+    /** \brief compare sequence numbers that wrap around
+     *
+     * This implements serial number arithmetic (RFC 1982): \a lhs is less
+     * than \a rhs if moving forward from \a lhs reaches \a rhs in fewer than
+     * half the range's size steps.  This stays correct across wraparound as
+     * long as compared values are never half the range apart.
+     *
+     * \retval true  \a rhs is ahead of \a lhs
+     * \retval false \a rhs is equal to or behind \a lhs, or exactly half the
+     *               range away
+     */
+    template <typename T, T MIN, T MAX>
+    constexpr bool serial_less(wrapped_value<T, MIN, MAX> const & lhs,
+                               wrapped_value<T, MIN, MAX> const & rhs) noexcept
+    {
+        using validator_type = wrapping_validator<T, MIN, MAX>;
+        using arithmetic = internal::wrap_arithmetic<validator_type>;
+        using offset_type = typename arithmetic::offset_type;
+
+        auto const distance = arithmetic::add(
+            internal::range_offset<validator_type>(rhs),
+            arithmetic::negate(internal::range_offset<validator_type>(lhs)));
+        // half of size, where a size of 0 means the full range
+        constexpr auto half = static_cast<offset_type>(
+            (arithmetic::size == 0)
+                ? (static_cast<offset_type>(~offset_type{0}) / 2) + 1
+                : arithmetic::size / 2);
+        return (distance != 0) && (distance < half);
+    }
+} // namespace houseguest
+
+#endif
@@ -0,0 +1,40 @@
+#include <houseguest/instrumented_validator.hpp>
+
+#include <houseguest/bounded_value.hpp>
+
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+#include "instrumented_validator_results.hpp"
+
+namespace
+{
+    using percent_validator = houseguest::clamping_validator<int, 0, 100>;
+
+    using percent = houseguest::constrained_value<
+        int, houseguest::instrumented_validator<percent_validator>>;
+
+    static_assert(std::is_same<percent_validator,
+                               houseguest::instrumented_validator<
+                                   percent_validator>>::value,
+                  "Instrumentation should compile out when disabled");
+    static_assert(std::is_same<houseguest::clamped_value<int, 0, 100>,
+                               percent>::value,
+                  "Instrumented values should be unchanged when disabled");
+} // namespace
+
+TEST(InstrumentedValidatorDisabled, no_counts) // NOLINT
+{
+    ASSERT_EQ(100, percent{250});
+    ASSERT_EQ(0, percent{-1});
+
+    auto const counts = houseguest::validation_counts<percent_validator>();
+    ASSERT_EQ(0, counts.total());
+    ASSERT_TRUE(houseguest::all_validation_counts().empty());
+}
+
+TEST(InstrumentedValidatorDisabled, same_results) // NOLINT
+{
+    expect_same_results();
+}
@@ -0,0 +1,66 @@
+#ifndef HOUSEGUEST_INSTRUMENTED_VALIDATOR_RESULTS_HPP
+#define HOUSEGUEST_INSTRUMENTED_VALIDATOR_RESULTS_HPP 1
+
+#include <houseguest/atomic_bounded_value.hpp>
+#include <houseguest/bounded_sort.hpp>
+#include <houseguest/bounded_value.hpp>
+#include <houseguest/instrumented_validator.hpp>
+
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+// Included by both instrumented_validator_test.cpp and
+// instrumented_validator_disabled_test.cpp, so turning instrumentation on
+// can't change any of these results.
+namespace
+{
+    void expect_same_results()
+    {
+        using percent_validator =
+            houseguest::clamping_validator<int, 0, 100>;
+        using percent = houseguest::constrained_value<
+            int, houseguest::instrumented_validator<percent_validator>>;
+        using digit_validator = houseguest::exception_validator<int, 0, 9>;
+
+        percent const a{70};
+        percent const b{50};
+        percent const sum = a + b;
+        static_assert(
+            std::is_same<percent, decltype(a + b)>::value,
+            "Saturating arithmetic should keep the instrumented type");
+        ASSERT_EQ(100, sum);
+        ASSERT_EQ(20, a - b);
+        ASSERT_EQ(0, b - a);
+        ASSERT_EQ(100, a * b);
+
+        using byte_validator =
+            houseguest::clamping_validator<unsigned char, 0, 255>;
+        houseguest::constrained_value<
+            unsigned char, houseguest::instrumented_validator<byte_validator>>
+            const narrowed{houseguest::bounded_value<int, 0, 1000>{300}};
+        ASSERT_EQ(255, narrowed);
+
+        houseguest::atomic_constrained_value<
+            int, houseguest::instrumented_validator<percent_validator>>
+            gauge{90};
+        ASSERT_EQ(90, gauge.fetch_add(20));
+        ASSERT_EQ(100, gauge.load());
+
+        houseguest::atomic_constrained_value<
+            int, houseguest::instrumented_validator<digit_validator>>
+            counter{8};
+        ASSERT_THROW(counter.fetch_add(2), std::system_error); // NOLINT
+        ASSERT_EQ(8, counter.load());
+
+        std::vector<percent> values{percent{30}, percent{10}, percent{20}};
+        houseguest::bounded_sort(values);
+        ASSERT_EQ(
+            (std::vector<percent>{percent{10}, percent{20}, percent{30}}),
+            values);
+    }
+} // namespace
+
+#endif
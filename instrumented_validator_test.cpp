@@ -0,0 +1,166 @@
+#define HOUSEGUEST_INSTRUMENT_VALIDATORS 1
+#include <houseguest/instrumented_validator.hpp>
+
+#include <houseguest/bounded_parse.hpp>
+#include <houseguest/bounded_value.hpp>
+#include <houseguest/validation_result.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "instrumented_validator_results.hpp"
+
+namespace
+{
+    using percent_validator = houseguest::clamping_validator<int, 0, 100>;
+
+    using percent = houseguest::constrained_value<
+        int, houseguest::instrumented_validator<percent_validator>>;
+
+    using digit_validator = houseguest::exception_validator<int, 0, 9>;
+
+    using digit = houseguest::constrained_value<
+        int, houseguest::instrumented_validator<digit_validator>>;
+
+    using thread_validator = houseguest::clamping_validator<long, -5, 5>;
+
+    using thread_value = houseguest::constrained_value<
+        long, houseguest::instrumented_validator<thread_validator>>;
+
+    static_assert(!std::is_same<percent_validator,
+                                houseguest::instrumented_validator<
+                                    percent_validator>>::value,
+                  "Instrumentation should be enabled");
+    static_assert(sizeof(percent) == sizeof(int),
+                  "Instrumentation shouldn't change the size of values");
+} // namespace
+
+TEST(InstrumentedValidator, counts) // NOLINT
+{
+    auto const before = houseguest::validation_counts<percent_validator>();
+
+    ASSERT_EQ(0, percent{-3});
+    ASSERT_EQ(50, percent{50});
+    ASSERT_EQ(100, percent{100});
+    ASSERT_EQ(100, percent{250});
+    ASSERT_EQ(100, percent{101});
+
+    auto const after = houseguest::validation_counts<percent_validator>();
+    ASSERT_EQ(2, after.in_range - before.in_range);
+    ASSERT_EQ(1, after.below_min - before.below_min);
+    ASSERT_EQ(2, after.above_max - before.above_max);
+    ASSERT_EQ(5, after.total() - before.total());
+}
+
+TEST(InstrumentedValidator, rejected_values) // NOLINT
+{
+    auto const before = houseguest::validation_counts<digit_validator>();
+
+    ASSERT_EQ(4, digit{4});
+    ASSERT_THROW(digit{10}, std::system_error); // NOLINT
+    ASSERT_THROW(digit{-1}, std::system_error); // NOLINT
+
+    auto const after = houseguest::validation_counts<digit_validator>();
+    ASSERT_EQ(1, after.in_range - before.in_range);
+    ASSERT_EQ(1, after.below_min - before.below_min);
+    ASSERT_EQ(1, after.above_max - before.above_max);
+}
+
+TEST(InstrumentedValidator, try_make) // NOLINT
+{
+    using checked_digit_validator = houseguest::checked_validator<int, 0, 9>;
+    using checked_digit = houseguest::constrained_value<
+        int, houseguest::instrumented_validator<checked_digit_validator>>;
+
+    auto const before =
+        houseguest::validation_counts<checked_digit_validator>();
+
+    ASSERT_TRUE(houseguest::try_make<checked_digit>(5));
+    ASSERT_FALSE(houseguest::try_make<checked_digit>(50));
+    ASSERT_FALSE(houseguest::try_make<checked_digit>(-1));
+
+    auto const after =
+        houseguest::validation_counts<checked_digit_validator>();
+    ASSERT_EQ(1, after.in_range - before.in_range);
+    ASSERT_EQ(1, after.below_min - before.below_min);
+    ASSERT_EQ(1, after.above_max - before.above_max);
+}
+
+TEST(InstrumentedValidator, parse) // NOLINT
+{
+    using parsed_validator = houseguest::exception_validator<int, 10, 99>;
+    using parsed_value = houseguest::constrained_value<
+        int, houseguest::instrumented_validator<parsed_validator>>;
+
+    auto const before = houseguest::validation_counts<parsed_validator>();
+
+    ASSERT_TRUE(houseguest::parse<parsed_value>("42", "42" + 2));
+    ASSERT_FALSE(houseguest::parse<parsed_value>("5", "5" + 1));
+    ASSERT_FALSE(houseguest::parse<parsed_value>("100", "100" + 3));
+    ASSERT_FALSE(houseguest::parse<parsed_value>("4x", "4x" + 2));
+
+    // text that isn't a number never reaches the validator
+    auto const after = houseguest::validation_counts<parsed_validator>();
+    ASSERT_EQ(1, after.in_range - before.in_range);
+    ASSERT_EQ(1, after.below_min - before.below_min);
+    ASSERT_EQ(1, after.above_max - before.above_max);
+}
+
+TEST(InstrumentedValidator, threads) // NOLINT
+{
+    constexpr auto thread_count = 4;
+    constexpr auto iterations = 1000;
+
+    std::vector<std::thread> threads;
+    for(auto i = 0; i < thread_count; ++i)
+    {
+        threads.emplace_back([] {
+            for(long j = 0; j < iterations; ++j)
+            {
+                thread_value const value{(j % 3) * 10 - 10};
+                (void)value;
+            }
+        });
+    }
+    for(auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    // every thread has exited, so its counts were folded into the totals
+    auto const counts = houseguest::validation_counts<thread_validator>();
+    ASSERT_EQ(thread_count * 334, counts.below_min);
+    ASSERT_EQ(thread_count * 333, counts.in_range);
+    ASSERT_EQ(thread_count * 333, counts.above_max);
+}
+
+TEST(InstrumentedValidator, all_validation_counts) // NOLINT
+{
+    percent const value{200};
+    (void)value;
+
+    auto const all = houseguest::all_validation_counts();
+    auto const it = std::find_if(
+        all.begin(), all.end(),
+        [](houseguest::named_validation_snapshot const & entry) {
+            return std::strcmp(entry.validator,
+                               typeid(percent_validator).name()) == 0;
+        });
+    ASSERT_NE(all.end(), it);
+    ASSERT_EQ(
+        houseguest::validation_counts<percent_validator>().above_max,
+        it->counts.above_max);
+    ASSERT_LE(1, it->counts.above_max);
+}
+
+TEST(InstrumentedValidator, same_results) // NOLINT
+{
+    expect_same_results();
+}
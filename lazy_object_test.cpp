@@ -0,0 +1,105 @@
+#include <houseguest/lazy_object.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(LazyObject, default_ctor) // NOLINT
+{
+    houseguest::lazy_object<std::vector<int>> lv;
+    ASSERT_FALSE(lv.initialized());
+    auto handle = lv.read();
+    ASSERT_TRUE(lv.initialized());
+    ASSERT_TRUE(handle->empty());
+}
+
+TEST(LazyObject, factory_not_called_until_used) // NOLINT
+{
+    int calls = 0;
+    houseguest::lazy_object<std::vector<int>> lv{[&calls]() {
+        ++calls;
+        return std::vector<int>{1, 2, 3};
+    }};
+    ASSERT_EQ(0, calls);
+    ASSERT_EQ(3, lv.get().size());
+    ASSERT_EQ(3, lv.read()->size());
+    ASSERT_EQ(1, calls);
+}
+
+TEST(LazyObject, write_handle) // NOLINT
+{
+    houseguest::lazy_object<std::vector<int>> lv;
+    {
+        auto handle = lv.write();
+        handle->push_back(10);
+    }
+    auto handle = lv.read();
+    ASSERT_EQ(1, handle->size());
+    ASSERT_EQ(10, handle->front());
+}
+
+TEST(LazyObject, factory_throws) // NOLINT
+{
+    int calls = 0;
+    houseguest::lazy_object<int> li{[&calls]() {
+        if(++calls == 1)
+        {
+            throw std::runtime_error{"not yet"};
+        }
+        return 5;
+    }};
+    ASSERT_THROW(li.get(), std::runtime_error); // NOLINT
+    ASSERT_FALSE(li.initialized());
+    ASSERT_EQ(5, li.get());
+    ASSERT_EQ(2, calls);
+}
+
+TEST(LazyObject, prewarm) // NOLINT
+{
+    std::atomic<std::thread::id> creator{};
+    houseguest::lazy_object<int> li{[&creator]() {
+        creator = std::this_thread::get_id();
+        return 7;
+    }};
+    li.prewarm().get();
+    ASSERT_TRUE(li.initialized());
+    ASSERT_NE(std::this_thread::get_id(), creator.load());
+    ASSERT_EQ(7, *li.read());
+}
+
+TEST(LazyObject, multi_thread_init) // NOLINT
+{
+    std::atomic<int> calls{0};
+    houseguest::lazy_object<int> li{[&calls]() {
+        ++calls;
+        return 42;
+    }};
+
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    std::vector<int> results(8);
+    for(auto & result : results)
+    {
+        threads.emplace_back([&li, &go, &result]() {
+            while(!go)
+            {
+                std::this_thread::yield();
+            }
+            result = li.get();
+        });
+    }
+    go = true;
+    for(auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(1, calls.load());
+    for(auto result : results)
+    {
+        ASSERT_EQ(42, result);
+    }
+}
@@ -0,0 +1,241 @@
+#include <houseguest/object_pool.hpp>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    // counts live instances, and detects objects handed out twice
+    struct tracked
+    {
+        tracked()
+        {
+            ++live;
+        }
+
+        tracked(tracked const &)
+        {
+            ++live;
+        }
+
+        ~tracked()
+        {
+            --live;
+        }
+
+        static std::atomic<int> live;
+
+        std::atomic<bool> in_use{false};
+    };
+
+    std::atomic<int> tracked::live{0};
+} // namespace
+
+TEST(ObjectPool, bad_construction) // NOLINT
+{
+    ASSERT_THROW(houseguest::object_pool<int>{0}, // NOLINT
+                 std::invalid_argument);
+}
+
+TEST(ObjectPool, reuse) // NOLINT
+{
+    houseguest::object_pool<std::vector<int>> pool;
+    int * data = nullptr;
+    std::vector<int> * first = nullptr;
+    {
+        auto handle = pool.acquire();
+        ASSERT_TRUE(handle);
+        handle->assign(100, 1);
+        data = handle->data();
+        first = handle.get();
+    }
+    auto handle = pool.acquire();
+    ASSERT_EQ(first, handle.get());
+    ASSERT_EQ(data, handle->data());
+    ASSERT_EQ(100, handle->size());
+    ASSERT_EQ(1, pool.size());
+
+    auto const stats = pool.statistics();
+    ASSERT_EQ(1, stats.hits);
+    ASSERT_EQ(1, stats.misses);
+    ASSERT_EQ(1, stats.created);
+    ASSERT_DOUBLE_EQ(0.5, stats.hit_rate());
+}
+
+TEST(ObjectPool, factory) // NOLINT
+{
+    houseguest::object_pool<int> pool{4, []() { return 42; }};
+    ASSERT_EQ(42, *pool.acquire());
+}
+
+TEST(ObjectPool, factory_throws) // NOLINT
+{
+    bool fail = true;
+    houseguest::object_pool<int, 1> pool{4, [&fail]() {
+                                             if(fail)
+                                             {
+                                                 throw std::runtime_error{
+                                                     "no"};
+                                             }
+                                             return 1;
+                                         }};
+    ASSERT_THROW(pool.acquire(), std::runtime_error); // NOLINT
+    ASSERT_EQ(0, pool.size());
+    fail = false;
+    ASSERT_TRUE(pool.acquire());
+}
+
+TEST(ObjectPool, reset_and_move) // NOLINT
+{
+    houseguest::object_pool<int, 1> pool;
+    auto handle = pool.acquire();
+    auto other = std::move(handle);
+    ASSERT_FALSE(handle); // NOLINT
+    ASSERT_TRUE(other);
+    ASSERT_FALSE(pool.try_acquire());
+    other.reset();
+    ASSERT_FALSE(other);
+    ASSERT_TRUE(pool.try_acquire());
+}
+
+TEST(ObjectPool, capacity) // NOLINT
+{
+    houseguest::object_pool<int, 2> pool;
+    auto first = pool.acquire();
+    auto second = pool.acquire();
+    ASSERT_EQ(2, pool.size());
+    ASSERT_FALSE(pool.try_acquire());
+    try
+    {
+        auto third = pool.acquire();
+        FAIL() << "acquire should throw";
+    }
+    catch(std::system_error const & e)
+    {
+        ASSERT_EQ(houseguest::bounded_value_error::above_max, e.code());
+    }
+
+    first.reset();
+    ASSERT_TRUE(pool.try_acquire());
+    ASSERT_EQ(2, pool.size());
+}
+
+TEST(ObjectPool, cache_overflow) // NOLINT
+{
+    houseguest::object_pool<int> pool{4};
+    {
+        std::vector<houseguest::object_pool<int>::handle_type> handles;
+        for(int i = 0; i < 10; ++i)
+        {
+            handles.push_back(pool.acquire());
+        }
+    }
+    ASSERT_EQ(10, pool.size());
+
+    // the overflow went to the depot, so nothing new is created
+    std::vector<houseguest::object_pool<int>::handle_type> handles;
+    for(int i = 0; i < 10; ++i)
+    {
+        handles.push_back(pool.acquire());
+    }
+    ASSERT_EQ(10, pool.size());
+}
+
+TEST(ObjectPool, thread_exit_returns_objects) // NOLINT
+{
+    houseguest::object_pool<int> pool{8};
+    std::thread{[&pool]() {
+        std::vector<houseguest::object_pool<int>::handle_type> handles;
+        for(int i = 0; i < 4; ++i)
+        {
+            handles.push_back(pool.acquire());
+        }
+    }}.join();
+    ASSERT_EQ(4, pool.size());
+
+    std::vector<houseguest::object_pool<int>::handle_type> handles;
+    for(int i = 0; i < 4; ++i)
+    {
+        handles.push_back(pool.acquire());
+    }
+    ASSERT_EQ(4, pool.size());
+
+    // one trip to the depot refills the cache with the rest
+    auto const stats = pool.statistics();
+    ASSERT_EQ(5, stats.misses);
+    ASSERT_EQ(3, stats.hits);
+}
+
+TEST(ObjectPool, destroyed_pool) // NOLINT
+{
+    std::promise<void> cached;
+    std::promise<void> destroyed;
+    std::thread worker;
+    {
+        houseguest::object_pool<tracked> pool;
+        worker = std::thread{[&pool, &cached, &destroyed]() {
+            {
+                auto handle = pool.acquire();
+            }
+            cached.set_value();
+            destroyed.get_future().wait();
+        }};
+        cached.get_future().wait();
+        ASSERT_EQ(1, tracked::live.load());
+    }
+    // the worker still caches its object until it exits
+    destroyed.set_value();
+    worker.join();
+    ASSERT_EQ(0, tracked::live.load());
+}
+
+TEST(ObjectPool, multi_thread) // NOLINT
+{
+    houseguest::object_pool<tracked, 128> pool{8};
+    std::atomic<bool> failed{false};
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 8; ++t)
+    {
+        threads.emplace_back([&pool, &failed]() {
+            std::vector<houseguest::object_pool<tracked, 128>::handle_type>
+                handles;
+            for(int i = 0; i < 10000; ++i)
+            {
+                auto handle = pool.acquire();
+                if(handle->in_use.exchange(true))
+                {
+                    failed = true;
+                }
+                handles.push_back(std::move(handle));
+                if(handles.size() == 8 || (i % 3) == 0)
+                {
+                    for(auto & held : handles)
+                    {
+                        held->in_use = false;
+                    }
+                    handles.clear();
+                }
+            }
+            for(auto & held : handles)
+            {
+                held->in_use = false;
+            }
+        });
+    }
+    for(auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_FALSE(failed.load());
+    auto const stats = pool.statistics();
+    ASSERT_EQ(80000, stats.acquisitions());
+    ASSERT_LE(pool.size(), 128);
+    ASSERT_GT(stats.hit_rate(), 0.5);
+}
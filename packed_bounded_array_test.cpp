@@ -0,0 +1,158 @@
+#include <houseguest/packed_bounded_array.hpp>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using percent_array = houseguest::packed_bounded_array<int, 0, 100>;
+
+    using signed_array = houseguest::packed_bounded_array<int, -1000, 1000>;
+} // namespace
+
+TEST(PackedBoundedArray, bits_per_value) // NOLINT
+{
+    ASSERT_EQ(7, percent_array::bits_per_value);
+    ASSERT_EQ(11, signed_array::bits_per_value);
+    ASSERT_EQ(0, (houseguest::packed_bounded_array<int, 5, 5>::bits_per_value));
+    ASSERT_EQ(64, (houseguest::packed_bounded_array<
+                   long long, std::numeric_limits<long long>::min(),
+                   std::numeric_limits<long long>::max()>::bits_per_value));
+}
+
+TEST(PackedBoundedArray, default_ctor) // NOLINT
+{
+    percent_array a;
+    ASSERT_TRUE(a.empty());
+    ASSERT_EQ(0, a.size());
+}
+
+TEST(PackedBoundedArray, count_ctor) // NOLINT
+{
+    signed_array a(100);
+    ASSERT_EQ(100, a.size());
+    ASSERT_EQ(-1000, a[0]);
+    ASSERT_EQ(-1000, a[99]);
+}
+
+TEST(PackedBoundedArray, storage) // NOLINT
+{
+    percent_array a(1000);
+    // 7000 bits fit in 110 words, plus padding
+    ASSERT_GE(113 * sizeof(std::uint64_t), a.storage_bytes());
+}
+
+TEST(PackedBoundedArray, set_get) // NOLINT
+{
+    signed_array a(200);
+    for(auto i = 0u; i < a.size(); ++i)
+    {
+        a[i] = static_cast<int>(i * 10) - 1000;
+    }
+    for(auto i = 0u; i < a.size(); ++i)
+    {
+        ASSERT_EQ(static_cast<int>(i * 10) - 1000, a[i]);
+    }
+}
+
+TEST(PackedBoundedArray, set_preserves_neighbours) // NOLINT
+{
+    percent_array a(20, percent_array::value_type{100});
+    a[9] = 0;
+    ASSERT_EQ(100, a[8]);
+    ASSERT_EQ(0, a[9]);
+    ASSERT_EQ(100, a[10]);
+}
+
+TEST(PackedBoundedArray, bad_set) // NOLINT
+{
+    percent_array a(10);
+    try
+    {
+        a[3] = 101;
+        FAIL();
+    }
+    catch(std::system_error const & se)
+    {
+        ASSERT_EQ(static_cast<int>(houseguest::bounded_value_error::above_max),
+                  se.code().value());
+    }
+    ASSERT_EQ(0, a[3]);
+}
+
+TEST(PackedBoundedArray, push_back) // NOLINT
+{
+    percent_array a;
+    for(auto i = 0; i <= 100; ++i)
+    {
+        a.push_back(i);
+    }
+    ASSERT_EQ(101, a.size());
+    ASSERT_EQ(37, a[37]);
+    ASSERT_EQ(100, a.at(100));
+    ASSERT_THROW(a.at(101), std::out_of_range); // NOLINT
+}
+
+TEST(PackedBoundedArray, shrink_then_grow) // NOLINT
+{
+    percent_array a(50, percent_array::value_type{99});
+    a.resize(5);
+    a.resize(50);
+    ASSERT_EQ(99, a[4]);
+    ASSERT_EQ(0, a[5]);
+    ASSERT_EQ(0, a[49]);
+}
+
+TEST(PackedBoundedArray, pack_unpack) // NOLINT
+{
+    std::vector<int> const values{-1000, -1, 0, 1, 1000, 512, -512};
+    signed_array a(values.size() + 2);
+    a.pack(std::begin(values), std::end(values), 1);
+
+    std::vector<int> out;
+    a.unpack(1, values.size(), std::back_inserter(out));
+    ASSERT_EQ(values, out);
+    ASSERT_EQ(-1000, a[0]);
+}
+
+TEST(PackedBoundedArray, bad_pack) // NOLINT
+{
+    std::vector<int> const values{0, -1001, 5};
+    signed_array a(values.size());
+    ASSERT_THROW(a.pack(std::begin(values), std::end(values), 0), // NOLINT
+                 std::system_error);
+    ASSERT_EQ(-1000, a[0]);
+}
+
+TEST(PackedBoundedArray, iterate) // NOLINT
+{
+    percent_array a(10);
+    auto value = 0;
+    for(auto ref : a)
+    {
+        ref = value;
+        value += 10;
+    }
+    auto const & ca = a;
+    auto sum = 0;
+    for(auto v : ca)
+    {
+        sum += v;
+    }
+    ASSERT_EQ(450, sum);
+    ASSERT_EQ(10, std::end(ca) - std::begin(ca));
+}
+
+TEST(PackedBoundedArray, full_width) // NOLINT
+{
+    using limits = std::numeric_limits<long long>;
+    houseguest::packed_bounded_array<long long, limits::min(), limits::max()> a(
+        3);
+    a[0] = limits::max();
+    a[1] = -1;
+    a[2] = limits::min();
+    ASSERT_EQ(limits::max(), a[0]);
+    ASSERT_EQ(-1, a[1]);
+    ASSERT_EQ(limits::min(), a[2]);
+}
@@ -0,0 +1,75 @@
+#include <houseguest/validation_result.hpp>
+
+#include <gtest/gtest.h>
+
+#include <houseguest/bounded_value.hpp>
+
+namespace
+{
+    using two_digit_int = houseguest::bounded_value<int, 10, 99>;
+
+    using checked_two_digit_int = houseguest::checked_value<int, 10, 99>;
+
+    using clamped_two_digit_int = houseguest::clamped_value<int, 10, 99>;
+} // namespace
+
+TEST(ValidationResult, good) // NOLINT
+{
+    auto const result = houseguest::try_make<two_digit_int>(42);
+    ASSERT_TRUE(result);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_FALSE(result.error());
+    ASSERT_EQ(42, result.value());
+    ASSERT_EQ(42, *result);
+}
+
+TEST(ValidationResult, below_min) // NOLINT
+{
+    auto const result = houseguest::try_make<two_digit_int>(9);
+    ASSERT_FALSE(result);
+    ASSERT_EQ(houseguest::bounded_value_error::below_min, result.error());
+    ASSERT_EQ(two_digit_int{50}, result.value_or(two_digit_int{50}));
+}
+
+TEST(ValidationResult, above_max) // NOLINT
+{
+    auto const result = houseguest::try_make<two_digit_int>(100);
+    ASSERT_FALSE(result);
+    ASSERT_EQ(houseguest::bounded_value_error::above_max, result.error());
+}
+
+TEST(ValidationResult, error_category) // NOLINT
+{
+    auto const result = houseguest::try_make<two_digit_int>(100);
+    std::error_code const expected =
+        houseguest::bounded_value_error::above_max;
+    ASSERT_EQ(expected.category(), result.error().category());
+    ASSERT_STREQ("houseguest::bounded_value", result.error().category().name());
+}
+
+TEST(ValidationResult, checked_good) // NOLINT
+{
+    auto const result = houseguest::try_make<checked_two_digit_int>(99);
+    ASSERT_TRUE(result);
+    ASSERT_EQ(99, result.value());
+}
+
+TEST(ValidationResult, checked_bad) // NOLINT
+{
+    auto const result = houseguest::try_make<checked_two_digit_int>(5);
+    ASSERT_FALSE(result);
+    ASSERT_EQ(houseguest::bounded_value_error::below_min, result.error());
+}
+
+TEST(ValidationResult, checked_ctor) // NOLINT
+{
+    checked_two_digit_int value{15};
+    ASSERT_EQ(15, value);
+}
+
+TEST(ValidationResult, clamped) // NOLINT
+{
+    auto const result = houseguest::try_make<clamped_two_digit_int>(500);
+    ASSERT_TRUE(result);
+    ASSERT_EQ(99, result.value());
+}
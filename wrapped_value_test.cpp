@@ -0,0 +1,81 @@
+#include <houseguest/wrapped_value.hpp>
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    // power-of-two size
+    using ring_index = houseguest::wrapped_value<unsigned, 0, 15>;
+
+    // not a power of two
+    using day_of_week = houseguest::wrapped_value<int, 1, 7>;
+
+    // every value of the underlying type
+    using sequence = houseguest::wrapped_value<std::uint8_t, 0, 255>;
+
+    // more than half of the underlying type
+    using big_ring = houseguest::wrapped_value<std::uint8_t, 10, 209>;
+
+    static_assert(
+        houseguest::internal::wrap_arithmetic<ring_index::validator>::
+            power_of_two,
+        "16 values should use a mask");
+    static_assert(
+        !houseguest::internal::wrap_arithmetic<day_of_week::validator>::
+            power_of_two,
+        "7 values can't use a mask");
+} // namespace
+
+TEST(WrappedValue, construct) // NOLINT
+{
+    ASSERT_EQ(0, ring_index{16});
+    ASSERT_EQ(3, ring_index{35});
+    ASSERT_EQ(1, day_of_week{8});
+    ASSERT_EQ(7, day_of_week{0});
+    ASSERT_EQ(7, day_of_week{-7});
+    ASSERT_EQ(1, day_of_week{-13});
+    ASSERT_EQ(4, day_of_week{4});
+}
+
+TEST(WrappedValue, add) // NOLINT
+{
+    ASSERT_EQ(1, ring_index{15} + 2);
+    ASSERT_EQ(2, day_of_week{7} + 2);
+    ASSERT_EQ(7, day_of_week{7} + 14);
+    ASSERT_EQ(6, day_of_week{7} + -1);
+    ASSERT_EQ(3, day_of_week{5} + day_of_week{5});
+    ASSERT_EQ(4, sequence{250} + 10);
+}
+
+TEST(WrappedValue, subtract) // NOLINT
+{
+    ASSERT_EQ(15, ring_index{0} - 1);
+    ASSERT_EQ(7, day_of_week{1} - 1);
+    ASSERT_EQ(1, day_of_week{1} - 700);
+    ASSERT_EQ(5, day_of_week{2} - day_of_week{4});
+    ASSERT_EQ(250, sequence{4} - 10);
+}
+
+TEST(WrappedValue, large_range) // NOLINT
+{
+    // sums can overflow the underlying type
+    ASSERT_EQ(20, big_ring{209} + big_ring{11});
+    ASSERT_EQ(209, big_ring{200} + big_ring{209});
+    ASSERT_EQ(209, big_ring{10} - 1);
+    ASSERT_EQ(199, big_ring{209} + 190);
+}
+
+TEST(WrappedValue, serial_less) // NOLINT
+{
+    ASSERT_TRUE(houseguest::serial_less(sequence{1}, sequence{2}));
+    ASSERT_FALSE(houseguest::serial_less(sequence{2}, sequence{1}));
+    ASSERT_FALSE(houseguest::serial_less(sequence{2}, sequence{2}));
+    ASSERT_TRUE(houseguest::serial_less(sequence{250}, sequence{3}));
+    ASSERT_FALSE(houseguest::serial_less(sequence{3}, sequence{250}));
+    ASSERT_FALSE(houseguest::serial_less(sequence{0}, sequence{128}));
+
+    ASSERT_TRUE(houseguest::serial_less(day_of_week{6}, day_of_week{1}));
+    ASSERT_FALSE(houseguest::serial_less(day_of_week{1}, day_of_week{6}));
+}